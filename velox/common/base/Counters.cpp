@@ -265,6 +265,34 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricSsdCacheRecoveredEntries, facebook::velox::StatType::SUM);
 
+  // Total uncompressed bytes of the cache entries written compressed.
+  DEFINE_METRIC(
+      kMetricSsdCacheCompressionInputBytes, facebook::velox::StatType::SUM);
+
+  // Total compressed bytes of the cache entries written compressed. The ratio
+  // of input to output bytes is the SSD cache compression ratio.
+  DEFINE_METRIC(
+      kMetricSsdCacheCompressionOutputBytes, facebook::velox::StatType::SUM);
+
+  // Total time spent compressing cache entries written to SSD in milliseconds.
+  DEFINE_METRIC(
+      kMetricSsdCacheCompressionTimeMs, facebook::velox::StatType::SUM);
+
+  // Total time spent decompressing cache entries read from SSD in
+  // milliseconds.
+  DEFINE_METRIC(
+      kMetricSsdCacheDecompressionTimeMs, facebook::velox::StatType::SUM);
+
+  // Total number of cache entries not written to SSD because the admission
+  // controller did not admit them.
+  DEFINE_METRIC(
+      kMetricSsdCacheAdmissionRejectedEntries, facebook::velox::StatType::SUM);
+
+  // Total bytes of cache entries not written to SSD because the admission
+  // controller did not admit them.
+  DEFINE_METRIC(
+      kMetricSsdCacheAdmissionRejectedBytes, facebook::velox::StatType::SUM);
+
   /// ================== Memory Arbitration Counters =================
 
   // The number of arbitration requests.
@@ -579,6 +607,18 @@ void registerVeloxMetrics() {
   // The number of data size exchange requests.
   DEFINE_METRIC(kMetricExchangeDataSizeCount, facebook::velox::StatType::COUNT);
 
+  // The distribution of the bytes in an exchange queue when a consumer asks
+  // for data in range of [0, 128MB] with 128 buckets. It is configured to
+  // report the capacity at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricExchangeQueuedBytes, 1L << 20, 0, 128L << 20, 50, 90, 99, 100);
+
+  // The distribution of the time an exchange consumer waits for data in range
+  // of [0, 10s] with 100 buckets. It is configured to report the latency at
+  // P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricExchangeQueueWaitTimeMs, 1'00, 0, 10'000, 50, 90, 99, 100);
+
   /// ================== Storage Counters =================
 
   // The time distribution of storage IO throttled duration in range of [0, 30s]
@@ -328,6 +328,24 @@ constexpr folly::StringPiece kMetricSsdCacheRegionsEvicted{
 constexpr folly::StringPiece kMetricSsdCacheRecoveredEntries{
     "velox.ssd_cache_recovered_entries"};
 
+constexpr folly::StringPiece kMetricSsdCacheCompressionInputBytes{
+    "velox.ssd_cache_compression_input_bytes"};
+
+constexpr folly::StringPiece kMetricSsdCacheCompressionOutputBytes{
+    "velox.ssd_cache_compression_output_bytes"};
+
+constexpr folly::StringPiece kMetricSsdCacheCompressionTimeMs{
+    "velox.ssd_cache_compression_time_ms"};
+
+constexpr folly::StringPiece kMetricSsdCacheDecompressionTimeMs{
+    "velox.ssd_cache_decompression_time_ms"};
+
+constexpr folly::StringPiece kMetricSsdCacheAdmissionRejectedEntries{
+    "velox.ssd_cache_admission_rejected_entries"};
+
+constexpr folly::StringPiece kMetricSsdCacheAdmissionRejectedBytes{
+    "velox.ssd_cache_admission_rejected_bytes"};
+
 constexpr folly::StringPiece kMetricExchangeDataTimeMs{
     "velox.exchange_data_time_ms"};
 
@@ -346,6 +364,12 @@ constexpr folly::StringPiece kMetricExchangeDataSizeTimeMs{
 constexpr folly::StringPiece kMetricExchangeDataSizeCount{
     "velox.exchange_data_size_count"};
 
+constexpr folly::StringPiece kMetricExchangeQueuedBytes{
+    "velox.exchange_queued_bytes"};
+
+constexpr folly::StringPiece kMetricExchangeQueueWaitTimeMs{
+    "velox.exchange_queue_wait_time_ms"};
+
 constexpr folly::StringPiece kMetricStorageThrottledDurationMs{
     "velox.storage_throttled_duration_ms"};
 
@@ -231,6 +231,24 @@ void PeriodicStatsReporter::reportCacheStats() {
         deltaSsdStats.readWithoutChecksumChecks);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheRecoveredEntries, deltaSsdStats.entriesRecovered);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheCompressionInputBytes,
+        deltaSsdStats.compressionInputBytes);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheCompressionOutputBytes,
+        deltaSsdStats.compressionOutputBytes);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheCompressionTimeMs,
+        deltaSsdStats.compressionNanos / 1'000'000);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheDecompressionTimeMs,
+        deltaSsdStats.decompressionNanos / 1'000'000);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheAdmissionRejectedEntries,
+        deltaSsdStats.entriesAdmissionRejected);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheAdmissionRejectedBytes,
+        deltaSsdStats.bytesAdmissionRejected);
   }
 
   // TTL controler snapshot stats.
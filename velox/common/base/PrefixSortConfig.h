@@ -27,10 +27,12 @@ struct PrefixSortConfig {
   PrefixSortConfig(
       uint32_t _maxNormalizedKeyBytes,
       uint32_t _minNumRows,
-      uint32_t _maxStringPrefixLength)
+      uint32_t _maxStringPrefixLength,
+      bool _radixSortEnabled = false)
       : maxNormalizedKeyBytes(_maxNormalizedKeyBytes),
         minNumRows(_minNumRows),
-        maxStringPrefixLength(_maxStringPrefixLength) {}
+        maxStringPrefixLength(_maxStringPrefixLength),
+        radixSortEnabled(_radixSortEnabled) {}
 
   /// Maximum bytes that can be used to store normalized keys in prefix-sort
   /// buffer per entry. Same with QueryConfig kPrefixSortNormalizedKeyMaxBytes.
@@ -43,5 +45,10 @@ struct PrefixSortConfig {
   /// Maximum number of bytes to be stored in prefix-sort buffer for a string
   /// column.
   uint32_t maxStringPrefixLength{16};
+
+  /// If true, sorts the normalized keys with a most significant byte first
+  /// radix sort instead of quick sort. Same with QueryConfig
+  /// kPrefixSortRadixSortEnabled.
+  bool radixSortEnabled{false};
 };
 } // namespace facebook::velox::common
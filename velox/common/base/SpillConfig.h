@@ -63,7 +63,9 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      uint32_t _numReadAheadBuffers = 0,
+      bool _ioUringEnabled = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -148,5 +150,14 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// The number of 'readBufferSize' buffers to read ahead from each spill file
+  /// on 'executor' when reading spilled data. 0 disables the read-ahead on
+  /// 'executor'.
+  uint32_t numReadAheadBuffers{0};
+
+  /// If true, spill files are written through io_uring if Velox is built with
+  /// io_uring support and the spill directory is on the local file system.
+  bool ioUringEnabled{false};
 };
 } // namespace facebook::velox::common
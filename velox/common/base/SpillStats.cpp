@@ -92,6 +92,9 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillReads += other.spillReads;
   spillReadTimeNanos += other.spillReadTimeNanos;
   spillDeserializationTimeNanos += other.spillDeserializationTimeNanos;
+  spillReadAheadHits += other.spillReadAheadHits;
+  spillReadAheadMisses += other.spillReadAheadMisses;
+  spillReadAheadWaitNanos += other.spillReadAheadWaitNanos;
   return *this;
 }
 
@@ -121,6 +124,11 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillReadTimeNanos = spillReadTimeNanos - other.spillReadTimeNanos;
   result.spillDeserializationTimeNanos =
       spillDeserializationTimeNanos - other.spillDeserializationTimeNanos;
+  result.spillReadAheadHits = spillReadAheadHits - other.spillReadAheadHits;
+  result.spillReadAheadMisses =
+      spillReadAheadMisses - other.spillReadAheadMisses;
+  result.spillReadAheadWaitNanos =
+      spillReadAheadWaitNanos - other.spillReadAheadWaitNanos;
   return result;
 }
 
@@ -154,6 +162,9 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillReads);
   UPDATE_COUNTER(spillReadTimeNanos);
   UPDATE_COUNTER(spillDeserializationTimeNanos);
+  UPDATE_COUNTER(spillReadAheadHits);
+  UPDATE_COUNTER(spillReadAheadMisses);
+  UPDATE_COUNTER(spillReadAheadWaitNanos);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -194,7 +205,10 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos) ==
+             spillDeserializationTimeNanos,
+             spillReadAheadHits,
+             spillReadAheadMisses,
+             spillReadAheadWaitNanos) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -213,7 +227,10 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos);
+             spillDeserializationTimeNanos,
+             other.spillReadAheadHits,
+             other.spillReadAheadMisses,
+             other.spillReadAheadWaitNanos);
 }
 
 void SpillStats::reset() {
@@ -235,6 +252,9 @@ void SpillStats::reset() {
   spillReads = 0;
   spillReadTimeNanos = 0;
   spillDeserializationTimeNanos = 0;
+  spillReadAheadHits = 0;
+  spillReadAheadMisses = 0;
+  spillReadAheadWaitNanos = 0;
 }
 
 std::string SpillStats::toString() const {
@@ -244,7 +264,8 @@ std::string SpillStats::toString() const {
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
       "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
-      "spillReadDeserializationTimeNanos[{}]",
+      "spillReadDeserializationTimeNanos[{}] spillReadAheadHits[{}] "
+      "spillReadAheadMisses[{}] spillReadAheadWaitNanos[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -262,7 +283,10 @@ std::string SpillStats::toString() const {
       succinctBytes(spillReadBytes),
       spillReads,
       succinctNanos(spillReadTimeNanos),
-      succinctNanos(spillDeserializationTimeNanos));
+      succinctNanos(spillDeserializationTimeNanos),
+      spillReadAheadHits,
+      spillReadAheadMisses,
+      succinctNanos(spillReadAheadWaitNanos));
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -328,6 +352,16 @@ void updateGlobalSpillReadStats(
   statsLocked->spillReadTimeNanos += spillReadTimeNs;
 }
 
+void updateGlobalSpillReadAheadStats(
+    uint64_t readAheadHits,
+    uint64_t readAheadMisses,
+    uint64_t readAheadWaitNs) {
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spillReadAheadHits += readAheadHits;
+  statsLocked->spillReadAheadMisses += readAheadMisses;
+  statsLocked->spillReadAheadWaitNanos += readAheadWaitNs;
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   RECORD_METRIC_VALUE(kMetricSpilledInputBytes, spilledInputBytes);
   auto statsLocked = localSpillStats().wlock();
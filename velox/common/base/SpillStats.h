@@ -68,6 +68,14 @@ struct SpillStats {
   uint64_t spillReadTimeNanos{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeNanos{0};
+  /// The number of spill file reads served by a read-ahead which had
+  /// completed when the data was needed.
+  uint64_t spillReadAheadHits{0};
+  /// The number of spill file reads which had to wait for an in-flight
+  /// read-ahead.
+  uint64_t spillReadAheadMisses{0};
+  /// The time spent on waiting for in-flight read-aheads of spilled files.
+  uint64_t spillReadAheadWaitNanos{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -154,6 +162,14 @@ void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeNs);
 
+/// Updates the read-ahead stats of spill file reads including the number of
+/// read-ahead hits and misses, and the time spent on waiting for in-flight
+/// read-aheads.
+void updateGlobalSpillReadAheadStats(
+    uint64_t readAheadHits,
+    uint64_t readAheadMisses,
+    uint64_t readAheadWaitNs);
+
 /// Increments the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
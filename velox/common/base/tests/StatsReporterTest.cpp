@@ -502,6 +502,16 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheCompressionInputBytes.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheCompressionOutputBytes.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheCompressionTimeMs.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheDecompressionTimeMs.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedEntries.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedBytes.str()), 0);
     ASSERT_EQ(counterMap.size(), 22);
   }
 
@@ -530,6 +540,12 @@ TEST_F(PeriodicStatsReporterTest, basic) {
   newSsdStats->readCheckpointErrors = 10;
   newSsdStats->readWithoutChecksumChecks = 10;
   newSsdStats->entriesRecovered = 10;
+  newSsdStats->compressionInputBytes = 10;
+  newSsdStats->compressionOutputBytes = 10;
+  newSsdStats->compressionNanos = 10'000'000;
+  newSsdStats->decompressionNanos = 10'000'000;
+  newSsdStats->entriesAdmissionRejected = 10;
+  newSsdStats->bytesAdmissionRejected = 10;
   cache.updateStats(
       {.numHit = 10,
        .hitBytes = 10,
@@ -585,7 +601,17 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 1);
-    ASSERT_EQ(counterMap.size(), 54);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheCompressionInputBytes.str()), 1);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheCompressionOutputBytes.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheCompressionTimeMs.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheDecompressionTimeMs.str()), 1);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedEntries.str()), 1);
+    ASSERT_EQ(
+        counterMap.count(kMetricSsdCacheAdmissionRejectedBytes.str()), 1);
+    ASSERT_EQ(counterMap.size(), 60);
   }
 }
 
@@ -252,6 +252,12 @@ class AsyncDataCacheEntry {
     return ssdSaveable_;
   }
 
+  /// Stops offering the entry to SSD writes, e.g. after the SSD cache did not
+  /// admit it.
+  void clearSsdSaveable() {
+    ssdSaveable_ = false;
+  }
+
   void setTrackingId(TrackingId id) {
     trackingId_ = id;
   }
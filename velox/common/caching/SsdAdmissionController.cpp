@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionController.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+uint64_t hashKey(const RawFileCacheKey& key) {
+  return bits::hashMix(key.fileNum, key.offset);
+}
+} // namespace
+
+TinyLfuSsdAdmissionController::TinyLfuSsdAdmissionController(
+    const Options& options)
+    : options_(options),
+      rowMask_(
+          bits::nextPowerOfTwo(
+              std::max<int64_t>(options.windowSize / kNumHashes, 64)) -
+          1),
+      // 8 bits per access in the window keep the false positive rate of the
+      // doorkeeper around 5% if all accesses are to distinct regions.
+      doorkeeperMask_(
+          bits::nextPowerOfTwo(std::max<int64_t>(options.windowSize * 8, 64)) -
+          1) {
+  VELOX_CHECK_GT(options_.minAccesses, 0);
+  VELOX_CHECK_GT(options_.windowSize, 0);
+  counters_.resize(kNumHashes * (rowMask_ + 1) / 2, 0);
+  doorkeeper_.resize(bits::nwords(doorkeeperMask_ + 1), 0);
+}
+
+uint64_t TinyLfuSsdAdmissionController::counterIndex(
+    uint64_t hash,
+    int32_t row) const {
+  // Double hashing: the high half of the hash is the stride between rows.
+  const uint64_t stride = (hash >> 32) | 1;
+  return row * (rowMask_ + 1) + ((hash + row * stride) & rowMask_);
+}
+
+std::array<uint64_t, 2> TinyLfuSsdAdmissionController::doorkeeperBits(
+    uint64_t hash) const {
+  // Two bits from the low half and from the high half of the hash.
+  return {hash & doorkeeperMask_, (hash >> 32) & doorkeeperMask_};
+}
+
+bool TinyLfuSsdAdmissionController::inDoorkeeperLocked(uint64_t hash) const {
+  for (const auto bit : doorkeeperBits(hash)) {
+    if (!bits::isBitSet(doorkeeper_.data(), bit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int32_t TinyLfuSsdAdmissionController::minCountLocked(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kNumHashes; ++row) {
+    count = std::min(count, counterLocked(counterIndex(hash, row)));
+  }
+  return count;
+}
+
+void TinyLfuSsdAdmissionController::recordAccess(
+    const RawFileCacheKey& key,
+    int32_t readPct) {
+  if (readPct < options_.minReadPct) {
+    return;
+  }
+  const auto hash = hashKey(key);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!inDoorkeeperLocked(hash)) {
+    for (const auto bit : doorkeeperBits(hash)) {
+      bits::setBit(doorkeeper_.data(), bit);
+    }
+  } else {
+    // Conservative update: only the counters at the minimum are incremented,
+    // which reduces the overestimate from collisions.
+    const auto count = minCountLocked(hash);
+    if (count < kMaxCount) {
+      for (auto row = 0; row < kNumHashes; ++row) {
+        const auto index = counterIndex(hash, row);
+        if (counterLocked(index) == count) {
+          incrementCounterLocked(index);
+        }
+      }
+    }
+  }
+  if (++numAccesses_ >= options_.windowSize) {
+    resetLocked();
+  }
+}
+
+void TinyLfuSsdAdmissionController::resetLocked() {
+  // Halves both counters of each byte.
+  for (auto& counters : counters_) {
+    counters = (counters >> 1) & 0x77;
+  }
+  std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+  numAccesses_ /= 2;
+  ++numResets_;
+}
+
+int32_t TinyLfuSsdAdmissionController::frequency(
+    const RawFileCacheKey& key) const {
+  const auto hash = hashKey(key);
+  std::lock_guard<std::mutex> l(mutex_);
+  return minCountLocked(hash) + (inDoorkeeperLocked(hash) ? 1 : 0);
+}
+
+bool TinyLfuSsdAdmissionController::shouldAdmit(
+    const RawFileCacheKey& key,
+    int32_t /*size*/) {
+  return frequency(key) >= options_.minAccesses;
+}
+
+std::string TinyLfuSsdAdmissionController::toString() const {
+  return fmt::format(
+      "TinyLFU admission: min accesses {}, window {}, min read pct {}",
+      options_.minAccesses,
+      options_.windowSize,
+      options_.minReadPct);
+}
+
+} // namespace facebook::velox::cache
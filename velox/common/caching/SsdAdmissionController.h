@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Decides which cache entries SsdCache writes to SSD. Readers record each
+/// access to a file region that goes through the cache, whether it hits memory,
+/// SSD or storage. SsdCache asks for each entry of a write batch whether the
+/// entry should be admitted. Entries that are not admitted stay in memory but
+/// are not offered again. The region may be admitted when it is loaded into a
+/// new entry after eviction.
+class SsdAdmissionController {
+ public:
+  virtual ~SsdAdmissionController() = default;
+
+  /// Records an access to the file region at 'key'. 'readPct' is the
+  /// percentage of the referenced bytes of the region's stream that the scan
+  /// actually reads, as tracked by ScanTracker. 100 if not known.
+  virtual void recordAccess(const RawFileCacheKey& key, int32_t readPct) = 0;
+
+  /// Returns true if the entry for 'key' of 'size' bytes should be written to
+  /// SSD.
+  virtual bool shouldAdmit(const RawFileCacheKey& key, int32_t size) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// Admits the file regions accessed at least 'minAccesses' times in a sliding
+/// window of recent accesses. The access frequencies are estimated with a
+/// TinyLFU sketch: a count-min sketch of small saturating counters fronted by
+/// a bloom filter 'doorkeeper'. The first access to a region only sets its
+/// doorkeeper bits, so that the many regions touched once by large scans work
+/// as a ghost list that does not pollute the counters. After 'windowSize'
+/// accesses all counters are halved and the doorkeeper is cleared, so that
+/// old popularity decays.
+class TinyLfuSsdAdmissionController : public SsdAdmissionController {
+ public:
+  struct Options {
+    /// Minimum number of accesses to a region within the window for admission.
+    int32_t minAccesses{2};
+
+    /// Number of recorded accesses after which the frequencies are halved.
+    /// This should be a multiple of the number of entries the SSD cache holds.
+    /// The sketch and doorkeeper take about 1.5 * 'windowSize' bytes.
+    int64_t windowSize{1 << 20};
+
+    /// Accesses to regions of streams whose ScanTracker read percentage is
+    /// below this are not counted. Such streams are referenced by scans but
+    /// mostly filtered out, so their regions are poor candidates for SSD.
+    int32_t minReadPct{0};
+  };
+
+  explicit TinyLfuSsdAdmissionController(const Options& options);
+
+  void recordAccess(const RawFileCacheKey& key, int32_t readPct) override;
+
+  bool shouldAdmit(const RawFileCacheKey& key, int32_t size) override;
+
+  std::string toString() const override;
+
+  /// Returns the estimated number of accesses to 'key' in the window.
+  int32_t frequency(const RawFileCacheKey& key) const;
+
+  /// Returns the number of accesses counted since the last halving.
+  int64_t numAccesses() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numAccesses_;
+  }
+
+  /// Returns the number of times the frequencies were halved.
+  int64_t numResets() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numResets_;
+  }
+
+ private:
+  static constexpr int32_t kNumHashes = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Returns the index of the counter for 'key' in sketch row 'row'. 'hash' is
+  // the hash of 'key'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  // Returns the counter at 'index'. Two 4-bit counters are packed per byte.
+  int32_t counterLocked(uint64_t index) const {
+    return (counters_[index / 2] >> ((index % 2) * 4)) & kMaxCount;
+  }
+
+  // Adds 1 to the counter at 'index', which must be below kMaxCount.
+  void incrementCounterLocked(uint64_t index) {
+    counters_[index / 2] += 1 << ((index % 2) * 4);
+  }
+
+  // Returns the indices of the doorkeeper bits for 'hash'.
+  std::array<uint64_t, 2> doorkeeperBits(uint64_t hash) const;
+
+  // Returns true if all doorkeeper bits for 'hash' are set.
+  bool inDoorkeeperLocked(uint64_t hash) const;
+
+  // Returns the smallest sketch counter for 'hash'.
+  int32_t minCountLocked(uint64_t hash) const;
+
+  // Halves all counters and clears the doorkeeper.
+  void resetLocked();
+
+  const Options options_;
+
+  // Mask for the counter index within a sketch row.
+  const uint64_t rowMask_;
+
+  // Mask for the bit index within 'doorkeeper_'.
+  const uint64_t doorkeeperMask_;
+
+  mutable std::mutex mutex_;
+
+  // kNumHashes rows of 'rowMask_' + 1 4-bit counters, two per byte.
+  std::vector<uint8_t> counters_;
+
+  std::vector<uint64_t> doorkeeper_;
+
+  int64_t numAccesses_{0};
+  int64_t numResets_{0};
+};
+
+} // namespace facebook::velox::cache
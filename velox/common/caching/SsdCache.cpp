@@ -32,6 +32,7 @@ SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
+      admissionController_(config.admissionController),
       executor_(config.executor) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
@@ -67,7 +68,9 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.ioUringEnabled,
+        config.compressionKind);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -99,6 +102,20 @@ void SsdCache::write(std::vector<CachePin> pins) {
   uint64_t bytes = 0;
   std::vector<std::vector<CachePin>> shards(numShards_);
   for (auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    if (admissionController_ != nullptr &&
+        !admissionController_->shouldAdmit(
+            RawFileCacheKey{entry->key().fileNum.id(), entry->key().offset},
+            entry->size())) {
+      // The entry is no longer offered to SSD writes, so that it is neither
+      // pinned nor counted against the write batch limit again. If it is
+      // evicted and loaded again, the new entry is offered.
+      ++entriesAdmissionRejected_;
+      bytesAdmissionRejected_ += entry->size();
+      entry->clearSsdSaveable();
+      pin.clear();
+      continue;
+    }
     bytes += pin.checkedEntry()->size();
     const auto& target = file(pin.checkedEntry()->key().fileNum.id());
     shards[target.shardId()].push_back(std::move(pin));
@@ -181,6 +198,8 @@ SsdCacheStats SsdCache::stats() const {
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.entriesAdmissionRejected = entriesAdmissionRejected_;
+  stats.bytesAdmissionRejected = bytesAdmissionRejected_;
   return stats;
 }
 
@@ -192,6 +211,9 @@ std::string SsdCache::toString() const {
       << succinctBytes(data.bytesRead) << " Size " << succinctBytes(capacity)
       << " Occupied " << succinctBytes(data.bytesCached);
   out << " " << (data.entriesCached >> 10) << "K entries.";
+  if (data.compressionOutputBytes > 0) {
+    out << " Compression ratio " << data.compressionRatio() << ".";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/SsdAdmissionController.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -41,7 +42,12 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        bool _ioUringEnabled = false,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE,
+        std::shared_ptr<SsdAdmissionController> _admissionController =
+            nullptr)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -49,6 +55,9 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
+          ioUringEnabled(_ioUringEnabled),
+          compressionKind(_compressionKind),
+          admissionController(std::move(_admissionController)),
           executor(_executor){};
 
     std::string filePrefix;
@@ -68,18 +77,33 @@ class SsdCache {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
+    /// If true, cache file reads and writes go through io_uring if Velox is
+    /// built with io_uring support. Otherwise they use blocking IO.
+    bool ioUringEnabled;
+
+    /// Compression of the cache entries written to SSD. Entries that do not
+    /// compress well are stored uncompressed.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
+    /// Decides which entries are written to SSD. If not set, all entries
+    /// offered by AsyncDataCache are written.
+    std::shared_ptr<SsdAdmissionController> admissionController;
+
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, io_uring {}, compression {}, admission {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          (ioUringEnabled ? "ENABLED" : "DISABLED"),
+          common::compressionKindToString(compressionKind),
+          (admissionController ? admissionController->toString() : "NONE"));
     }
   };
 
@@ -147,6 +171,11 @@ class SsdCache {
     return *groupStats_;
   }
 
+  /// Returns the admission controller or nullptr if all entries are admitted.
+  SsdAdmissionController* admissionController() const {
+    return admissionController_.get();
+  }
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -178,6 +207,7 @@ class SsdCache {
   const int32_t numShards_;
   // Stats for selecting entries to save from AsyncDataCache.
   const std::unique_ptr<FileGroupStats> groupStats_;
+  const std::shared_ptr<SsdAdmissionController> admissionController_;
   folly::Executor* const executor_;
   mutable std::mutex mutex_;
 
@@ -185,6 +215,10 @@ class SsdCache {
 
   // Count of shards with unfinished writes.
   std::atomic_int32_t writesInProgress_{0};
+
+  // Entries and bytes rejected by 'admissionController_'.
+  std::atomic_uint64_t entriesAdmissionRejected_{0};
+  std::atomic_uint64_t bytesAdmissionRejected_{0};
   bool shutdown_{false};
 
   friend class test::SsdCacheTestHelper;
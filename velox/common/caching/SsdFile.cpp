@@ -24,6 +24,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -60,6 +61,26 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
   }
 }
 
+// Throws if SSD cache entries cannot be compressed with 'kind'.
+void checkCompressionKind(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return;
+    case common::CompressionKind_ZLIB:
+    case common::CompressionKind_SNAPPY:
+    case common::CompressionKind_ZSTD:
+    case common::CompressionKind_LZ4:
+    case common::CompressionKind_GZIP:
+      break;
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported SSD cache compression kind: {}",
+          common::compressionKindToString(kind));
+  }
+  // Throws if the codec is not built in.
+  common::compressionKindToCodec(kind);
+}
+
 // Returns the number of entries in a cache 'entry'.
 uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   if (entry.tinyData() != nullptr) {
@@ -67,6 +88,23 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Copies the first entry.size() bytes of 'data' into 'entry'.
+void copyToEntry(const char* data, AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), data, entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto bytesToCopy = std::min<int64_t>(bytesLeft, run.numBytes());
+    ::memcpy(run.data<char>(), data, bytesToCopy);
+    data += bytesToCopy;
+    bytesLeft -= bytesToCopy;
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -111,14 +149,17 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      compressionKind_(config.compressionKind),
       shardId_(config.shardId),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
   process::TraceContext trace("SsdFile::SsdFile");
+  checkCompressionKind(compressionKind_);
   filesystems::FileOptions fileOptions;
   fileOptions.shouldThrowOnFileAlreadyExists = false;
   fileOptions.bufferIo = !FLAGS_ssd_odirect;
+  fileOptions.useIoUring = config.ioUringEnabled;
   writeFile_ = fs_->openFileForWrite(fileName_, fileOptions);
   readFile_ = fs_->openFileForRead(fileName_, fileOptions);
 
@@ -196,6 +237,7 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
     auto* entry = pins[i].checkedEntry();
@@ -210,26 +252,56 @@ CoalesceIoStats SsdFile::load(
     regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
+    hasCompressed |= ssdPins[i].run().isCompressed();
   }
 
-  // Do coalesced IO for the pins. For short payloads, the break-even between
-  // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  if (!hasCompressed) {
+    // Do coalesced IO for the pins. For short payloads, the break-even between
+    // discrete pread calls and a single preadv that discards gaps is ~25K per
+    // gap. For longer payloads this is ~50-100K.
+    stats = readPins(
+        pins,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          read(offset, buffers);
+        });
+  } else {
+    // Compressed entries are read into a staging buffer and decompressed
+    // into the cache entry, so there is no coalescing. The uncompressed
+    // entries of the batch are read one by one as well.
+    // Codecs are not thread safe, so each load makes its own.
+    auto codec = common::compressionKindToCodec(compressionKind_);
+    std::vector<iovec> iovecs;
+    std::vector<folly::Range<char*>> buffers;
+    for (auto i = 0; i < pins.size(); ++i) {
+      const auto& run = ssdPins[i].run();
+      auto* entry = pins[i].checkedEntry();
+      if (run.isCompressed()) {
+        readCompressed(*codec, run, *entry);
+        stats.payloadBytes += run.compressedSize();
+      } else {
+        iovecs.clear();
+        addEntryToIovecs(*entry, iovecs);
+        buffers.clear();
+        for (const auto& iov : iovecs) {
+          buffers.emplace_back(static_cast<char*>(iov.iov_base), iov.iov_len);
+        }
+        read(run.offset(), buffers);
+        stats.payloadBytes += entry->size();
+      }
+      ++stats.numIos;
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -247,8 +319,77 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::readCompressed(
+    folly::io::Codec& codec,
+    const SsdRun& run,
+    AsyncDataCacheEntry& entry) {
+  process::TraceContext trace("SsdFile::readCompressed");
+  std::string compressed(run.compressedSize(), '\0');
+  readFile_->pread(run.offset(), run.compressedSize(), compressed.data());
+  std::string uncompressed;
+  {
+    uint64_t decompressionNanos{0};
+    NanosecondTimer timer(&decompressionNanos);
+    try {
+      uncompressed = codec.uncompress(compressed, run.size());
+    } catch (const std::exception& e) {
+      ++stats_.readSsdCorruptions;
+      VELOX_FAIL(
+          "IOERR: Failed to decompress SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+          fileName_,
+          run.offset(),
+          run.compressedSize(),
+          e.what());
+    }
+    stats_.decompressionNanos += decompressionNanos;
+  }
+  VELOX_CHECK_EQ(uncompressed.size(), run.size());
+  copyToEntry(uncompressed.data(), entry);
+}
+
+std::vector<std::unique_ptr<folly::IOBuf>> SsdFile::compressEntries(
+    const std::vector<CachePin>& pins) {
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed;
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    return compressed;
+  }
+  process::TraceContext trace("SsdFile::compressEntries");
+  compressed.resize(pins.size());
+  // Codecs are not thread safe, so each write makes its own.
+  auto codec = common::compressionKindToCodec(compressionKind_);
+  uint64_t compressionNanos{0};
+  {
+    NanosecondTimer timer(&compressionNanos);
+    std::vector<iovec> iovecs;
+    for (auto i = 0; i < pins.size(); ++i) {
+      auto* entry = pins[i].checkedEntry();
+      iovecs.clear();
+      addEntryToIovecs(*entry, iovecs);
+      auto input =
+          folly::IOBuf::wrapBuffer(iovecs[0].iov_base, iovecs[0].iov_len);
+      for (auto j = 1; j < iovecs.size(); ++j) {
+        input->prependChain(
+            folly::IOBuf::wrapBuffer(iovecs[j].iov_base, iovecs[j].iov_len));
+      }
+      auto output = codec->compress(input.get());
+      const auto outputSize = output->computeChainDataLength();
+      if (outputSize == 0 ||
+          outputSize > entry->size() -
+                  entry->size() / kMinCompressionSavingsFraction) {
+        continue;
+      }
+      output->coalesce();
+      stats_.compressionInputBytes += entry->size();
+      stats_.compressionOutputBytes += outputSize;
+      compressed[i] = std::move(output);
+    }
+  }
+  stats_.compressionNanos += compressionNanos;
+  return compressed;
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& storedSizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -263,13 +404,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < storedSizes.size(); ++next) {
+      if (storedSizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= storedSizes[next];
+      toWrite += storedSizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -353,9 +493,20 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The compressed data of each pin, nullptr if the pin is written as is.
+  const auto compressed = compressEntries(pins);
+  const auto isCompressed = [&](int32_t index) {
+    return !compressed.empty() && compressed[index] != nullptr;
+  };
+  std::vector<uint32_t> storedSizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    storedSizes[i] = isCompressed(i) ? compressed[i]->length()
+                                     : pins[i].checkedEntry()->size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(storedSizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -369,8 +520,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = storedSizes[i];
+      const auto numIovecs =
+          isCompressed(i) ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -387,7 +539,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (isCompressed(i)) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -416,14 +573,16 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run(
+            offset, size, checksum, isCompressed(i) ? storedSizes[i] : 0);
+        entries_[std::move(key)] = run;
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
-        offset += size;
+        offset += storedSizes[i];
         ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
+        stats_.bytesWritten += storedSizes[i];
+        bytesAfterCheckpoint_ += storedSizes[i];
       }
     }
     writeIndex += numWrittenEntries;
@@ -466,9 +625,20 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
   auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc =
-      readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
-  VELOX_CHECK_EQ(rc.size(), entry.size());
+  if (ssdRun.isCompressed()) {
+    std::string compressed(ssdRun.compressedSize(), '\0');
+    readFile_->pread(
+        ssdRun.offset(), ssdRun.compressedSize(), compressed.data());
+    const auto uncompressed =
+        common::compressionKindToCodec(compressionKind_)
+            ->uncompress(compressed, ssdRun.size());
+    VELOX_CHECK_EQ(uncompressed.size(), entry.size());
+    ::memcpy(testData.get(), uncompressed.data(), entry.size());
+  } else {
+    const auto rc =
+        readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
+    VELOX_CHECK_EQ(rc.size(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -525,6 +695,10 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
   stats.readWithoutChecksumChecks += stats_.readWithoutChecksumChecks;
+  stats.compressionInputBytes += stats_.compressionInputBytes;
+  stats.compressionOutputBytes += stats_.compressionOutputBytes;
+  stats.compressionNanos += stats_.compressionNanos;
+  stats.decompressionNanos += stats_.decompressionNanos;
 }
 
 void SsdFile::clear() {
@@ -572,7 +746,7 @@ bool SsdFile::removeFileEntries(
     }
 
     ++entriesAgedOut;
-    erasedRegionSizes_[region] += ssdRun.size();
+    erasedRegionSizes_[region] += ssdRun.storedSize();
 
     it = entries_.erase(it);
   }
@@ -755,12 +929,14 @@ void SsdFile::checkpoint(bool force) {
       truncateFile(checkpointWriteFile_.get());
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t compressionKind if the version has compressed sizes,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples, where the SsdRun has the file bits,
+      // the checksum if enabled and the compressed size if enabled,
       // kEndMarker.
       allocateCheckpointBuffer();
       SCOPE_EXIT {
@@ -768,6 +944,10 @@ void SsdFile::checkpoint(bool force) {
       };
       const auto version = checkpointVersion();
       appendToCheckpointBuffer(checkpointVersion());
+      if (isCompressionEnabledOnCheckpointVersion(version)) {
+        const int32_t compressionKind = compressionKind_;
+        appendToCheckpointBuffer(compressionKind);
+      }
       appendToCheckpointBuffer(maxRegions_);
       appendToCheckpointBuffer(numRegions_);
 
@@ -796,6 +976,10 @@ void SsdFile::checkpoint(bool force) {
           const auto checksum = pair.second.checksum();
           appendToCheckpointBuffer(checksum);
         }
+        if (compressionKind_ != common::CompressionKind_NONE) {
+          const auto compressedSize = pair.second.compressedSize();
+          appendToCheckpointBuffer(compressedSize);
+        }
       }
 
       // NOTE: we need to ensure cache file data sync update completes before
@@ -983,6 +1167,21 @@ void SsdFile::readCheckpoint() {
         checkpointPath);
     return;
   }
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(versionMagic);
+  if (checkpointHasCompression) {
+    const auto compressionKind = readNumber<int32_t>(stream.get());
+    if (compressionKind != compressionKind_) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint was made with compression {} but the cache uses {}, checkpoint file {}",
+          shardId_,
+          common::compressionKindToString(
+              static_cast<common::CompressionKind>(compressionKind)),
+          common::compressionKindToString(compressionKind_),
+          checkpointPath);
+      return;
+    }
+  }
 
   const auto maxRegions = readNumber<int32_t>(stream.get());
   VELOX_CHECK_EQ(
@@ -1030,7 +1229,11 @@ void SsdFile::readCheckpoint() {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(stream.get());
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t compressedSize = 0;
+    if (checkpointHasCompression) {
+      compressedSize = readNumber<uint32_t>(stream.get());
+    }
+    const auto run = SsdRun(fileBits, checksum, compressedSize);
     const auto region = regionIndex(run.offset());
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(region) != evictedMap.end()) {
@@ -1041,9 +1244,9 @@ void SsdFile::readCheckpoint() {
     VELOX_CHECK(it != idMap.end());
     FileCacheKey key{it->second, offset};
     entries_[std::move(key)] = run;
-    regionCacheSizes[region] += run.size();
+    regionCacheSizes[region] += run.storedSize();
     regionSizes_[region] = std::max<uint32_t>(
-        regionSizes_[region], regionOffset(run.offset()) + run.size());
+        regionSizes_[region], regionOffset(run.offset()) + run.storedSize());
   }
 
   // NOTE: we might erase entries from a region for TTL eviction, so we need to
@@ -1075,7 +1278,7 @@ void SsdFile::readCheckpoint() {
     cachedBytes += regionSize;
   }
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, checkpoint file {}",
+      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, compression {}, checkpoint file {}",
       shardId_,
       entries_.size(),
       succinctBytes(cachedBytes),
@@ -1083,6 +1286,7 @@ void SsdFile::readCheckpoint() {
       writableRegions_.size(),
       checksumEnabled_ ? "enabled" : "disabled",
       checksumReadVerificationEnabled_ ? "enabled" : "disabled",
+      common::compressionKindToString(compressionKind_),
       checkpointFilePath());
 }
 
@@ -21,6 +21,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -37,21 +38,32 @@ class SsdCacheTestHelper;
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// If the entry is stored compressed, the size is the uncompressed size and
+/// 'compressedSize' is the number of bytes the entry takes in the file.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t compressedSize = 0)
+      : fileBits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        compressedSize_(compressedSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    VELOX_CHECK_LT(compressedSize, size);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t compressedSize = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        compressedSize_(compressedSize) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -59,11 +71,13 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressedSize_ = other.compressedSize_;
   }
 
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressedSize_ = other.compressedSize_;
   }
 
   uint64_t offset() const {
@@ -74,11 +88,25 @@ class SsdRun {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns the checksum computed with crc32 over the uncompressed data.
   uint32_t checksum() const {
     return checksum_;
   }
 
+  bool isCompressed() const {
+    return compressedSize_ != 0;
+  }
+
+  /// Returns the compressed size or 0 if the entry is not compressed.
+  uint32_t compressedSize() const {
+    return compressedSize_;
+  }
+
+  /// Returns the number of bytes the entry takes in the file.
+  uint32_t storedSize() const {
+    return isCompressed() ? compressedSize_ : size();
+  }
+
   /// Returns raw bits for offset and size for serialization.
   uint64_t fileBits() const {
     return fileBits_;
@@ -88,6 +116,7 @@ class SsdRun {
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  uint32_t compressedSize_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -174,6 +203,12 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    compressionInputBytes = tsanAtomicValue(other.compressionInputBytes);
+    compressionOutputBytes = tsanAtomicValue(other.compressionOutputBytes);
+    compressionNanos = tsanAtomicValue(other.compressionNanos);
+    decompressionNanos = tsanAtomicValue(other.decompressionNanos);
+    entriesAdmissionRejected = tsanAtomicValue(other.entriesAdmissionRejected);
+    bytesAdmissionRejected = tsanAtomicValue(other.bytesAdmissionRejected);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -205,6 +240,16 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.compressionInputBytes =
+        compressionInputBytes - other.compressionInputBytes;
+    result.compressionOutputBytes =
+        compressionOutputBytes - other.compressionOutputBytes;
+    result.compressionNanos = compressionNanos - other.compressionNanos;
+    result.decompressionNanos = decompressionNanos - other.decompressionNanos;
+    result.entriesAdmissionRejected =
+        entriesAdmissionRejected - other.entriesAdmissionRejected;
+    result.bytesAdmissionRejected =
+        bytesAdmissionRejected - other.bytesAdmissionRejected;
     return result;
   }
 
@@ -212,6 +257,14 @@ struct SsdCacheStats {
     *this = SsdCacheStats();
   }
 
+  /// Returns the ratio of uncompressed to stored bytes of the entries written
+  /// compressed, or 0 if no entry is compressed.
+  double compressionRatio() const {
+    return compressionOutputBytes == 0
+        ? 0
+        : static_cast<double>(compressionInputBytes) / compressionOutputBytes;
+  }
+
   /// Snapshot stats
   tsan_atomic<uint64_t> entriesCached{0};
   tsan_atomic<uint64_t> regionsCached{0};
@@ -241,6 +294,20 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// Uncompressed size of the entries written compressed.
+  tsan_atomic<uint64_t> compressionInputBytes{0};
+  /// Compressed size of the entries written compressed.
+  tsan_atomic<uint64_t> compressionOutputBytes{0};
+  /// Time spent compressing entries, including those that did not compress
+  /// well enough to be stored compressed.
+  tsan_atomic<uint64_t> compressionNanos{0};
+  /// Time spent decompressing entries on load.
+  tsan_atomic<uint64_t> decompressionNanos{0};
+  /// Number of entries offered for writing that the admission controller did
+  /// not admit.
+  tsan_atomic<uint64_t> entriesAdmissionRejected{0};
+  /// Size of the entries not admitted by the admission controller.
+  tsan_atomic<uint64_t> bytesAdmissionRejected{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -260,7 +327,10 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        bool _ioUringEnabled = false,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -269,7 +339,9 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          ioUringEnabled(_ioUringEnabled),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -295,6 +367,13 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// If true, cache file reads and writes go through io_uring if available.
+    bool ioUringEnabled;
+
+    /// Compression applied to each entry written. An entry that does not
+    /// compress well is stored uncompressed.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -407,9 +486,12 @@ class SsdFile {
   }
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
+  // if checksum write is enabled or not, and if entries have compressed sizes.
   std::string checkpointVersion() const {
-    return checksumEnabled_ ? "CPT2" : "CPT1";
+    return fmt::format(
+        "CP{}{}",
+        compressionKind_ != common::CompressionKind_NONE ? 'C' : 'T',
+        checksumEnabled_ ? '2' : '1');
   }
 
   // Increments the pin count of the region of 'offset'. Caller must hold
@@ -419,13 +501,25 @@ class SsdFile {
   }
 
   // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // contiguous entries of 'storedSizes' starting with the entry at index
+  // 'begin'.  Returns nullopt if there is no space. The space does not
+  // necessarily cover all the entries, so multiple calls starting at the first
+  // unwritten entry may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& storedSizes,
       int32_t begin);
 
+  // Returns the compressed data of the entries of 'pins' if 'compressionKind_'
+  // is set. An element is nullptr if the entry is stored uncompressed.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressEntries(
+      const std::vector<CachePin>& pins);
+
+  // Reads the compressed entry at 'run' and decompresses it into 'entry'.
+  void readCompressed(
+      folly::io::Codec& codec,
+      const SsdRun& run,
+      AsyncDataCacheEntry& entry);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -526,9 +620,19 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPC2";
   }
 
+  // Returns true if the entries of the given version have compressed sizes.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPC1" || checkpointVersion == "CPC2";
+  }
+
+  // An entry is stored compressed only if this saves at least 1/8 of its
+  // size. Otherwise the decompression on each load is not worth it.
+  static constexpr int32_t kMinCompressionSavingsFraction = 8;
+
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
   static constexpr uint32_t kCheckpointBufferSize = 1 << 20; // 1MB
@@ -548,6 +652,9 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // Compression of newly written entries.
+  const common::CompressionKind compressionKind_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
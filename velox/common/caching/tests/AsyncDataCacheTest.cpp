@@ -127,7 +127,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
       int64_t ssdBytes = 0,
       uint64_t checkpointIntervalBytes = 0,
       bool eraseCheckpoint = false,
-      AsyncDataCache::Options cacheOptions = {}) {
+      AsyncDataCache::Options cacheOptions = {},
+      std::shared_ptr<SsdAdmissionController> admissionController = nullptr) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -151,7 +152,10 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
           checkpointIntervalBytes > 0 ? checkpointIntervalBytes : ssdBytes / 20,
           false,
           GetParam().checksumEnabled,
-          GetParam().checksumVerificationEnabled);
+          GetParam().checksumVerificationEnabled,
+          /*_ioUringEnabled=*/false,
+          common::CompressionKind_NONE,
+          std::move(admissionController));
       ssdCache = std::make_unique<SsdCache>(config);
       if (ssdCache != nullptr) {
         ssdCacheHelper_ =
@@ -1544,6 +1548,53 @@ TEST_P(AsyncDataCacheTest, appendSsdSaveable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, ssdAdmissionRejected) {
+  constexpr uint64_t kRamBytes = 64UL << 20; // 64 MB
+  constexpr uint64_t kSsdBytes = 128UL << 20; // 128 MB
+
+  // Admits no entry.
+  class RejectAllAdmissionController : public SsdAdmissionController {
+   public:
+    void recordAccess(const RawFileCacheKey& /*key*/, int32_t /*readPct*/)
+        override {}
+
+    bool shouldAdmit(const RawFileCacheKey& /*key*/, int32_t /*size*/)
+        override {
+      return false;
+    }
+
+    std::string toString() const override {
+      return "RejectAllAdmissionController";
+    }
+  };
+
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      /*checkpointIntervalBytes=*/1UL << 30,
+      /*eraseCheckpoint=*/true,
+      {/*maxWriteRatio=*/0.0, /*ssdSavableRatio=*/10000.0, 1UL << 30},
+      std::make_shared<RejectAllAdmissionController>());
+  loadLoop(0, kRamBytes / 2);
+  waitForPendingLoads();
+
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd(/*saveAll=*/true);
+  cache_->ssdCache()->waitForWriteToFinish();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, 0);
+  const auto numRejected = stats.ssdStats->entriesAdmissionRejected;
+  ASSERT_GT(numRejected, 0);
+
+  // Rejected entries are not offered again.
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd(/*saveAll=*/true);
+  cache_->ssdCache()->waitForWriteToFinish();
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.ssdStats->entriesWritten, 0);
+  ASSERT_EQ(stats.ssdStats->entriesAdmissionRejected, numRejected);
+}
+
 TEST_P(AsyncDataCacheTest, checkpoint) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
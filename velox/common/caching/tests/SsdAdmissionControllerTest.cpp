@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionController.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(SsdAdmissionControllerTest, minAccesses) {
+  TinyLfuSsdAdmissionController::Options options;
+  options.minAccesses = 3;
+  options.windowSize = 1 << 16;
+  TinyLfuSsdAdmissionController controller(options);
+  const RawFileCacheKey key{1, 8 << 20};
+  EXPECT_EQ(controller.frequency(key), 0);
+  EXPECT_FALSE(controller.shouldAdmit(key, 1000));
+  controller.recordAccess(key, 100);
+  EXPECT_EQ(controller.frequency(key), 1);
+  EXPECT_FALSE(controller.shouldAdmit(key, 1000));
+  controller.recordAccess(key, 100);
+  EXPECT_FALSE(controller.shouldAdmit(key, 1000));
+  controller.recordAccess(key, 100);
+  EXPECT_EQ(controller.frequency(key), 3);
+  EXPECT_TRUE(controller.shouldAdmit(key, 1000));
+  // A different offset in the same file is a different region.
+  EXPECT_FALSE(controller.shouldAdmit(RawFileCacheKey{1, 0}, 1000));
+  EXPECT_EQ(controller.numAccesses(), 3);
+}
+
+TEST(SsdAdmissionControllerTest, minReadPct) {
+  TinyLfuSsdAdmissionController::Options options;
+  options.minReadPct = 50;
+  TinyLfuSsdAdmissionController controller(options);
+  const RawFileCacheKey key{2, 0};
+  // Accesses to mostly filtered out streams are not counted.
+  for (auto i = 0; i < 10; ++i) {
+    controller.recordAccess(key, 20);
+  }
+  EXPECT_EQ(controller.frequency(key), 0);
+  EXPECT_FALSE(controller.shouldAdmit(key, 1000));
+  controller.recordAccess(key, 50);
+  controller.recordAccess(key, 100);
+  EXPECT_TRUE(controller.shouldAdmit(key, 1000));
+}
+
+TEST(SsdAdmissionControllerTest, scanResistance) {
+  // A few hot regions are accessed repeatedly while a large scan touches many
+  // regions once. The hot regions are admitted and almost none of the scanned
+  // ones are.
+  TinyLfuSsdAdmissionController::Options options;
+  options.windowSize = 1 << 18;
+  TinyLfuSsdAdmissionController controller(options);
+  constexpr int32_t kNumHot = 100;
+  constexpr int32_t kNumScanned = 100'000;
+  for (auto i = 0; i < kNumScanned; ++i) {
+    if (i % 1000 == 0) {
+      for (auto hot = 0; hot < kNumHot; ++hot) {
+        controller.recordAccess(RawFileCacheKey{1, (uint64_t)hot}, 100);
+      }
+    }
+    controller.recordAccess(RawFileCacheKey{2, (uint64_t)i}, 100);
+  }
+  for (auto hot = 0; hot < kNumHot; ++hot) {
+    EXPECT_TRUE(
+        controller.shouldAdmit(RawFileCacheKey{1, (uint64_t)hot}, 1000));
+  }
+  int32_t numScannedAdmitted = 0;
+  for (auto i = 0; i < kNumScanned; ++i) {
+    numScannedAdmitted +=
+        controller.shouldAdmit(RawFileCacheKey{2, (uint64_t)i}, 1000);
+  }
+  // False positives from the doorkeeper and sketch collisions only.
+  EXPECT_LT(numScannedAdmitted, kNumScanned / 20);
+}
+
+TEST(SsdAdmissionControllerTest, aging) {
+  TinyLfuSsdAdmissionController::Options options;
+  options.minAccesses = 2;
+  options.windowSize = 1 << 10;
+  TinyLfuSsdAdmissionController controller(options);
+  const RawFileCacheKey key{3, 0};
+  for (auto i = 0; i < 4; ++i) {
+    controller.recordAccess(key, 100);
+  }
+  EXPECT_EQ(controller.frequency(key), 4);
+  EXPECT_TRUE(controller.shouldAdmit(key, 1000));
+
+  // Other accesses fill the window. The frequency of 'key' halves and the
+  // doorkeeper is cleared at each reset, so that it is no longer admitted.
+  for (auto i = 0; i < 2 * options.windowSize; ++i) {
+    controller.recordAccess(RawFileCacheKey{4, (uint64_t)i}, 100);
+  }
+  EXPECT_GE(controller.numResets(), 2);
+  EXPECT_FALSE(controller.shouldAdmit(key, 1000));
+}
+
+TEST(SsdAdmissionControllerTest, saturation) {
+  TinyLfuSsdAdmissionController::Options options;
+  options.windowSize = 1 << 16;
+  TinyLfuSsdAdmissionController controller(options);
+  const RawFileCacheKey key{5, 0};
+  // The 4-bit counters stop at 15. The doorkeeper adds the first access.
+  for (auto i = 0; i < 40; ++i) {
+    controller.recordAccess(key, 100);
+  }
+  EXPECT_EQ(controller.frequency(key), 16);
+  // Counters packed in the same bytes are not affected.
+  for (uint64_t offset = 1; offset < 100; ++offset) {
+    EXPECT_EQ(controller.frequency(RawFileCacheKey{5, offset}), 0);
+  }
+}
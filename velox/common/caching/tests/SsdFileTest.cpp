@@ -25,6 +25,7 @@
 #include <fcntl.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/Random.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <re2/re2.h>
@@ -71,7 +72,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      bool enableFaultInjection = false) {
+      bool enableFaultInjection = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -85,7 +87,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -93,7 +96,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -102,7 +106,9 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        false,
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -495,6 +501,132 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  const auto fileNameAlt = StringIdLease(fileIds(), "fileInStorageAlt");
+  FLAGS_ssd_verify_write = true;
+  initializeCache(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      false,
+      common::CompressionKind_ZSTD);
+
+  const auto copyAllocation = [](const memory::Allocation& allocation) {
+    std::string copy;
+    for (auto i = 0; i < allocation.numRuns(); ++i) {
+      const auto run = allocation.runAt(i);
+      copy.append(run.data<char>(), run.numBytes());
+    }
+    return copy;
+  };
+
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    // Each batch has one entry with random contents that does not compress,
+    // so that loads mix compressed and uncompressed entries.
+    pins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileNameAlt.id(), (uint64_t)startOffset},
+        64 << 10,
+        nullptr));
+    auto& random = pins.back().entry()->data();
+    for (auto i = 0; i < random.numRuns(); ++i) {
+      auto run = random.runAt(i);
+      auto* words = run.data<uint64_t>();
+      for (auto j = 0; j < run.numBytes() / sizeof(uint64_t); ++j) {
+        words[j] = folly::Random::rand64();
+      }
+    }
+    const auto randomCopy = copyAllocation(random);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      // The random entry is checked separately.
+      if (pin.entry()->key().fileNum.id() == fileName_.id()) {
+        allEntries.emplace_back(
+            pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      }
+    }
+    const auto randomPin = ssdFile_->find(
+        RawFileCacheKey{fileNameAlt.id(), (uint64_t)startOffset});
+    ASSERT_FALSE(randomPin.empty());
+    ASSERT_FALSE(randomPin.run().isCompressed());
+    const auto compressedPin = ssdFile_->find(
+        RawFileCacheKey{fileName_.id(), (uint64_t)startOffset});
+    ASSERT_FALSE(compressedPin.empty());
+    ASSERT_TRUE(compressedPin.run().isCompressed());
+    ASSERT_LT(
+        compressedPin.run().compressedSize(), compressedPin.run().size());
+
+    // Load into the same entries, overwriting their contents, and check that
+    // both the compressed and uncompressed entries are read back.
+    std::vector<SsdPin> ssdPins;
+    for (auto& pin : pins) {
+      ssdPins.push_back(ssdFile_->find(RawFileCacheKey{
+          pin.entry()->key().fileNum.id(), pin.entry()->key().offset}));
+      ASSERT_FALSE(ssdPins.back().empty());
+    }
+    ssdFile_->load(ssdPins, pins);
+    for (auto i = 0; i < pins.size() - 1; ++i) {
+      checkContents(pins[i].entry()->data(), pins[i].entry()->size());
+    }
+    ASSERT_EQ(copyAllocation(random), randomCopy);
+  }
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_GT(stats.compressionOutputBytes, 0);
+  ASSERT_LT(stats.compressionOutputBytes, stats.compressionInputBytes);
+  ASSERT_GT(stats.compressionRatio(), 1);
+  ASSERT_GT(stats.compressionNanos, 0);
+  ASSERT_GT(stats.decompressionNanos, 0);
+  ASSERT_EQ(stats.readSsdCorruptions, 0);
+  // The written bytes are the compressed bytes.
+  ASSERT_LT(stats.bytesWritten, stats.bytesRead);
+
+  // Recovers the compressed entries from checkpoint.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+
+  // A checkpoint with compressed entries is not recovered with a different
+  // compression.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_LZ4);
+  ASSERT_EQ(checkEntries(allEntries), 0);
+}
+
+TEST_F(SsdFileTest, unsupportedCompression) {
+  VELOX_ASSERT_USER_THROW(
+      initializeCache(
+          SsdFile::kRegionSize,
+          0,
+          false,
+          false,
+          false,
+          false,
+          common::CompressionKind_LZO),
+      "Unsupported SSD cache compression kind: lzo");
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -132,8 +133,9 @@ uint64_t InMemoryWriteFile::size() const {
 LocalReadFile::LocalReadFile(
     std::string_view path,
     folly::Executor* executor,
-    bool bufferIo)
-    : executor_(executor), path_(path) {
+    bool bufferIo,
+    IoUring* ioUring)
+    : executor_(executor), ioUring_(ioUring), path_(path) {
   int32_t flags = O_RDONLY;
 #ifdef linux
   if (!bufferIo) {
@@ -196,6 +198,9 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (ioUring_ != nullptr) {
+    return preadvIoUring(offset, buffers).get();
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -252,6 +257,9 @@ uint64_t LocalReadFile::preadv(
 folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (ioUring_ != nullptr) {
+    return preadvIoUring(offset, buffers);
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers);
   }
@@ -266,6 +274,34 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
   return std::move(future);
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvIoUring(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  // Skipped ranges are not read. Each run of ranges between them becomes a
+  // separate request of the batch.
+  std::vector<IoUring::Request> requests;
+  uint64_t numSkipped = 0;
+  bool newRequest = true;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      numSkipped += range.size();
+      offset += range.size();
+      newRequest = true;
+      continue;
+    }
+    if (newRequest || requests.back().iovecs.size() >= IOV_MAX) {
+      requests.push_back({fd_, offset, {}});
+      newRequest = false;
+    }
+    requests.back().iovecs.push_back({range.data(), range.size()});
+    offset += range.size();
+  }
+  // Like preadv(), the skipped bytes count as read.
+  return ioUring_->readv(std::move(requests))
+      .deferValue(
+          [numSkipped](uint64_t numRead) { return numRead + numSkipped; });
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -287,8 +323,9 @@ LocalWriteFile::LocalWriteFile(
     std::string_view path,
     bool shouldCreateParentDirectories,
     bool shouldThrowOnFileAlreadyExists,
-    bool bufferIo)
-    : path_(path) {
+    bool bufferIo,
+    IoUring* ioUring)
+    : ioUring_(ioUring), path_(path) {
   const auto dir = fs::path(path_).parent_path();
   if (shouldCreateParentDirectories && !fs::exists(dir)) {
     VELOX_CHECK(
@@ -348,6 +385,11 @@ LocalWriteFile::~LocalWriteFile() {
 
 void LocalWriteFile::append(std::string_view data) {
   checkNotClosed(closed_);
+  if (ioUring_ != nullptr) {
+    writeIoUring(
+        {{const_cast<char*>(data.data()), data.size()}}, size_, data.size());
+    return;
+  }
   const uint64_t bytesWritten = ::write(fd_, data.data(), data.size());
   VELOX_CHECK_EQ(
       bytesWritten,
@@ -361,6 +403,16 @@ void LocalWriteFile::append(std::string_view data) {
 
 void LocalWriteFile::append(std::unique_ptr<folly::IOBuf> data) {
   checkNotClosed(closed_);
+  if (ioUring_ != nullptr) {
+    std::vector<iovec> iovecs;
+    for (auto range : *data) {
+      if (!range.empty()) {
+        iovecs.push_back({const_cast<uint8_t*>(range.data()), range.size()});
+      }
+    }
+    writeIoUring(std::move(iovecs), size_, data->computeChainDataLength());
+    return;
+  }
   uint64_t totalBytesWritten{0};
   for (auto rangeIter = data->begin(); rangeIter != data->end(); ++rangeIter) {
     const auto bytesToWrite = rangeIter->size();
@@ -391,6 +443,10 @@ void LocalWriteFile::write(
     int64_t length) {
   checkNotClosed(closed_);
   VELOX_CHECK_GE(offset, 0, "Offset cannot be negative.");
+  if (ioUring_ != nullptr) {
+    writeIoUring(iovecs, offset, length);
+    return;
+  }
   const auto bytesWritten = ::pwritev(
       fd_, iovecs.data(), static_cast<ssize_t>(iovecs.size()), offset);
   VELOX_CHECK_EQ(
@@ -402,6 +458,33 @@ void LocalWriteFile::write(
   size_ = std::max<uint64_t>(size_, offset + bytesWritten);
 }
 
+void LocalWriteFile::writeIoUring(
+    std::vector<iovec> iovecs,
+    int64_t offset,
+    int64_t length) {
+  // Writes go to explicit offsets. The file position is not advanced, so
+  // appends also use 'size_' as the offset.
+  std::vector<IoUring::Request> requests;
+  for (auto i = 0; i < iovecs.size(); i += IOV_MAX) {
+    const auto end = std::min<size_t>(i + IOV_MAX, iovecs.size());
+    requests.push_back(
+        {fd_,
+         static_cast<uint64_t>(offset),
+         {iovecs.begin() + i, iovecs.begin() + end}});
+    for (auto j = i; j < end; ++j) {
+      offset += iovecs[j].iov_len;
+    }
+  }
+  const auto bytesWritten = ioUring_->writev(std::move(requests)).get();
+  VELOX_CHECK_EQ(
+      bytesWritten,
+      length,
+      "Failure in LocalWriteFile::writeIoUring, {} vs {}",
+      bytesWritten,
+      length);
+  size_ = std::max<uint64_t>(size_, offset);
+}
+
 void LocalWriteFile::truncate(int64_t newSize) {
   checkNotClosed(closed_);
   VELOX_CHECK_GE(newSize, 0, "New size cannot be negative.");
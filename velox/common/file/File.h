@@ -43,6 +43,8 @@
 
 namespace facebook::velox {
 
+class IoUring;
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -267,10 +269,13 @@ class InMemoryWriteFile final : public WriteFile {
 /// files match against any filepath starting with '/'.
 class LocalReadFile final : public ReadFile {
  public:
+  /// If 'ioUring' is set, vectored reads are submitted through it instead of
+  /// blocking preadv calls and preadvAsync() completes without an executor.
   LocalReadFile(
       std::string_view path,
       folly::Executor* executor = nullptr,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      IoUring* ioUring = nullptr);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
@@ -292,7 +297,7 @@ class LocalReadFile final : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers) const override;
 
   bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
+    return executor_ != nullptr || ioUring_ != nullptr;
   }
 
   uint64_t memoryUsage() const final;
@@ -315,7 +320,14 @@ class LocalReadFile final : public ReadFile {
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Submits 'buffers' to 'ioUring_' as one batch of reads, one per run of
+  // ranges between skipped ranges.
+  folly::SemiFuture<uint64_t> preadvIoUring(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
   folly::Executor* const executor_;
+  IoUring* const ioUring_{nullptr};
   std::string path_;
   int32_t fd_;
   long size_;
@@ -335,12 +347,15 @@ class LocalWriteFile final : public WriteFile {
   };
 
   // An error is thrown is a file already exists at |path|,
-  // unless flag shouldThrowOnFileAlreadyExists is false
+  // unless flag shouldThrowOnFileAlreadyExists is false. If 'ioUring' is set,
+  // appends and writes are submitted through it, with all the ranges of an
+  // IOBuf chain in one batch.
   explicit LocalWriteFile(
       std::string_view path,
       bool shouldCreateParentDirectories = false,
       bool shouldThrowOnFileAlreadyExists = true,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      IoUring* ioUring = nullptr);
 
   ~LocalWriteFile();
 
@@ -371,6 +386,10 @@ class LocalWriteFile final : public WriteFile {
   }
 
  private:
+  // Writes 'iovecs' of 'length' bytes at 'offset' through 'ioUring_'.
+  void writeIoUring(std::vector<iovec> iovecs, int64_t offset, int64_t length);
+
+  IoUring* const ioUring_;
   // File descriptor.
   int32_t fd_{-1};
   std::string path_;
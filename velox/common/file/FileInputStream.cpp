@@ -16,37 +16,52 @@
 
 #include "velox/common/file/FileInputStream.h"
 
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::common {
 
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
-      readAheadEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()) {
+      readAheadExecutor_(readAheadExecutor),
+      readAheadEnabled_(
+          (bufferSize_ < fileSize_) && (numReadAheadBuffers > 0) &&
+          (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(fileSize_, 0, "Empty FileInputStream");
 
-  buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
+  uint64_t numBuffers{1};
   if (readAheadEnabled_) {
+    // No more buffers than needed to hold the rest of the file after the
+    // first read.
+    numBuffers += std::min<uint64_t>(
+        numReadAheadBuffers, bits::divRoundUp(fileSize_, bufferSize_) - 1);
+  }
+  buffers_.reserve(numBuffers);
+  for (uint64_t i = 0; i < numBuffers; ++i) {
     buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
   }
   readNextRange();
 }
 
 FileInputStream::~FileInputStream() {
-  if (!readAheadWait_.valid()) {
-    return;
-  }
-  try {
-    readAheadWait_.wait();
-  } catch (const std::exception& ex) {
-    // ignore any prefetch error when query has failed.
-    LOG(WARNING) << "FileInputStream read-ahead failed on destruction "
-                 << ex.what();
+  for (auto& readAheadWait : readAheadWaits_) {
+    try {
+      readAheadWait.wait();
+    } catch (const std::exception& ex) {
+      // ignore any prefetch error when query has failed.
+      LOG(WARNING) << "FileInputStream read-ahead failed on destruction "
+                   << ex.what();
+    }
   }
 }
 
@@ -59,12 +74,23 @@ void FileInputStream::readNextRange() {
   uint64_t readTimeNs{0};
   {
     NanosecondTimer timer{&readTimeNs};
-    if (readAheadWait_.valid()) {
-      readBytes = std::move(readAheadWait_)
-                      .via(&folly::QueuedImmediateExecutor::instance())
-                      .wait()
-                      .value();
-      VELOX_CHECK(!readAheadWait_.valid());
+    if (!readAheadWaits_.empty()) {
+      auto readAheadWait = std::move(readAheadWaits_.front());
+      readAheadWaits_.pop_front();
+      if (readAheadWait.isReady()) {
+        ++stats_.numReadAheadHits;
+      } else {
+        ++stats_.numReadAheadMisses;
+      }
+      uint64_t waitTimeNs{0};
+      {
+        NanosecondTimer waitTimer{&waitTimeNs};
+        readBytes = std::move(readAheadWait)
+                        .via(&folly::QueuedImmediateExecutor::instance())
+                        .wait()
+                        .value();
+      }
+      stats_.readAheadWaitNs += waitTimeNs;
       VELOX_CHECK_LT(
           0, readBytes, "Read past end of FileInputStream {}", fileSize_);
       advanceBuffer();
@@ -208,18 +234,38 @@ uint64_t FileInputStream::readSize() const {
 }
 
 void FileInputStream::maybeIssueReadahead() {
-  VELOX_CHECK(!readAheadWait_.valid());
   if (!readAheadEnabled_) {
     return;
   }
-  const auto size = readSize();
-  if (size == 0) {
-    return;
+  readAheadOffset_ = std::max(readAheadOffset_, fileOffset_);
+  while (readAheadWaits_.size() + 1 < buffers_.size() &&
+         readAheadOffset_ < fileSize_) {
+    const auto size = std::min(fileSize_ - readAheadOffset_, bufferSize_);
+    auto* buffer =
+        buffers_[(bufferIndex_ + 1 + readAheadWaits_.size()) % buffers_.size()]
+            ->asMutable<char>();
+    readAheadWaits_.push_back(readAsync(readAheadOffset_, size, buffer));
+    VELOX_CHECK(readAheadWaits_.back().valid());
+    readAheadOffset_ += size;
+  }
+}
+
+folly::SemiFuture<uint64_t>
+FileInputStream::readAsync(uint64_t offset, uint64_t size, char* buffer) {
+  if (file_->hasPreadvAsync()) {
+    std::vector<folly::Range<char*>> ranges;
+    ranges.emplace_back(buffer, size);
+    return file_->preadvAsync(offset, ranges);
   }
-  std::vector<folly::Range<char*>> ranges;
-  ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
-  VELOX_CHECK(readAheadWait_.valid());
+  VELOX_CHECK_NOT_NULL(readAheadExecutor_);
+  // The destructor waits for all the in-flight reads so 'this' outlives them.
+  return folly::via(
+             readAheadExecutor_,
+             [this, offset, size, buffer]() {
+               file_->pread(offset, size, buffer);
+               return size;
+             })
+      .semi();
 }
 
 void FileInputStream::updateStats(uint64_t readBytes, uint64_t readTimeNs) {
@@ -243,15 +289,31 @@ FileInputStream::Stats FileInputStream::stats() const {
 
 bool FileInputStream::Stats::operator==(
     const FileInputStream::Stats& other) const {
-  return std::tie(numReads, readBytes, readTimeNs) ==
-      std::tie(other.numReads, other.readBytes, other.readTimeNs);
+  return std::tie(
+             numReads,
+             readBytes,
+             readTimeNs,
+             numReadAheadHits,
+             numReadAheadMisses,
+             readAheadWaitNs) ==
+      std::tie(
+             other.numReads,
+             other.readBytes,
+             other.readTimeNs,
+             other.numReadAheadHits,
+             other.numReadAheadMisses,
+             other.readAheadWaitNs);
 }
 
 std::string FileInputStream::Stats::toString() const {
   return fmt::format(
-      "numReads: {}, readBytes: {}, readTimeNs: {}",
+      "numReads: {}, readBytes: {}, readTimeNs: {}, numReadAheadHits: {}, "
+      "numReadAheadMisses: {}, readAheadWaitNs: {}",
       numReads,
       succinctBytes(readBytes),
-      succinctMicros(readTimeNs));
+      succinctMicros(readTimeNs),
+      numReadAheadHits,
+      numReadAheadMisses,
+      succinctNanos(readAheadWaitNs));
 }
 } // namespace facebook::velox::common
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+
+#include <folly/Executor.h>
 
 #include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
@@ -27,10 +30,18 @@ namespace facebook::velox::common {
 /// Readonly byte input stream backed by file.
 class FileInputStream : public ByteInputStream {
  public:
+  /// Reads 'file' in 'bufferSize' chunks with buffers allocated from 'pool'.
+  /// If the file supports async read or 'readAheadExecutor' is set, up to
+  /// 'numReadAheadBuffers' chunks after the current one are read ahead. Each
+  /// read-ahead chunk takes another 'bufferSize' buffer from 'pool'. Reads
+  /// ahead are issued on 'readAheadExecutor' if the file doesn't support async
+  /// read.
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 1);
 
   ~FileInputStream() override;
 
@@ -64,6 +75,13 @@ class FileInputStream : public ByteInputStream {
     uint32_t numReads{0};
     uint64_t readBytes{0};
     uint64_t readTimeNs{0};
+    /// The number of reads served by a read-ahead which had completed when
+    /// the data was needed.
+    uint32_t numReadAheadHits{0};
+    /// The number of reads which had to wait for an in-flight read-ahead.
+    uint32_t numReadAheadMisses{0};
+    /// The time spent waiting for in-flight read-aheads.
+    uint64_t readAheadWaitNs{0};
 
     bool operator==(const Stats& other) const;
 
@@ -77,12 +95,17 @@ class FileInputStream : public ByteInputStream {
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
-  // Issues readahead if underlying file system supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues read-aheads until all the spare buffers are in flight or the end
+  // of the file is reached. This is a no-op if read-ahead is not enabled.
   void maybeIssueReadahead();
 
+  // Reads 'size' bytes at 'offset' into 'buffer' asynchronously, using the
+  // async read of 'file_' if supported, otherwise on 'readAheadExecutor_'.
+  folly::SemiFuture<uint64_t> readAsync(
+      uint64_t offset,
+      uint64_t size,
+      char* buffer);
+
   inline uint64_t readSize() const;
 
   inline uint32_t bufferIndex() const {
@@ -102,26 +125,26 @@ class FileInputStream : public ByteInputStream {
     return buffers_[bufferIndex()].get();
   }
 
-  inline Buffer* nextBuffer() const {
-    return buffers_[nextBufferIndex()].get();
-  }
-
   void updateStats(uint64_t readBytes, uint64_t readTimeNs);
 
   const std::unique_ptr<ReadFile> file_;
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const readAheadExecutor_;
   const bool readAheadEnabled_;
 
   // Offset of the next byte to read from file.
   uint64_t fileOffset_ = 0;
+  // Offset of the next byte to read ahead from file.
+  uint64_t readAheadOffset_ = 0;
 
+  // The buffers used as a ring. The buffer at 'bufferIndex_' is the current
+  // one and the buffers after it are in order filled by 'readAheadWaits_'.
   std::vector<BufferPtr> buffers_;
   uint32_t bufferIndex_{0};
-  // Sets to read-ahead future if valid.
-  folly::SemiFuture<uint64_t> readAheadWait_{
-      folly::SemiFuture<uint64_t>::makeEmpty()};
+  // The futures of the in-flight read-aheads in file order.
+  std::deque<folly::SemiFuture<uint64_t>> readAheadWaits_;
 
   Stats stats_;
 };
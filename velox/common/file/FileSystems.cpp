@@ -19,6 +19,7 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUring.h"
 
 #include <cstdio>
 #include <filesystem>
@@ -117,7 +118,10 @@ class LocalFileSystem : public FileSystem {
       std::string_view path,
       const FileOptions& options) override {
     return std::make_unique<LocalReadFile>(
-        extractPath(path), executor_.get(), options.bufferIo);
+        extractPath(path),
+        executor_.get(),
+        options.bufferIo,
+        options.useIoUring ? IoUring::getInstance() : nullptr);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -127,7 +131,8 @@ class LocalFileSystem : public FileSystem {
         extractPath(path),
         options.shouldCreateParentDirectories,
         options.shouldThrowOnFileAlreadyExists,
-        options.bufferIo);
+        options.bufferIo,
+        options.useIoUring ? IoUring::getInstance() : nullptr);
   }
 
   void remove(std::string_view path) override {
@@ -62,6 +62,12 @@ struct FileOptions {
   /// filesystem on Unix-like operating system, this corresponds to the direct
   /// IO mode if set.
   bool bufferIo{true};
+
+  /// Whether to issue reads and writes through io_uring. Only the local file
+  /// system respects this option, and only if Velox is built with
+  /// VELOX_ENABLE_IO_URING and the kernel supports io_uring. Otherwise the
+  /// file falls back to blocking IO.
+  bool useIoUring{false};
 };
 
 /// Defines directory options
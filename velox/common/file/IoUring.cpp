@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include "velox/common/base/Exceptions.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+
+namespace {
+// Returns the total size of 'iovecs'.
+uint64_t totalSize(const std::vector<iovec>& iovecs) {
+  uint64_t size = 0;
+  for (const auto& iov : iovecs) {
+    size += iov.iov_len;
+  }
+  return size;
+}
+
+// Does the part of 'request' after the first 'done' bytes with blocking IO.
+// Used for short writes and for requests the kernel asks to retry. Returns 0
+// or an errno.
+int32_t completeBlocking(
+    const IoUring::Request& request,
+    bool isWrite,
+    uint64_t& done) {
+  std::vector<iovec> iovecs = request.iovecs;
+  auto skip = done;
+  size_t first = 0;
+  while (first < iovecs.size() && skip >= iovecs[first].iov_len) {
+    skip -= iovecs[first++].iov_len;
+  }
+  while (first < iovecs.size()) {
+    iovecs[first].iov_base = static_cast<char*>(iovecs[first].iov_base) + skip;
+    iovecs[first].iov_len -= skip;
+    const auto result = isWrite
+        ? ::pwritev(
+              request.fd,
+              iovecs.data() + first,
+              iovecs.size() - first,
+              request.offset + done)
+        : ::preadv(
+              request.fd,
+              iovecs.data() + first,
+              iovecs.size() - first,
+              request.offset + done);
+    if (result < 0) {
+      if (errno == EINTR) {
+        skip = 0;
+        continue;
+      }
+      return errno;
+    }
+    if (result == 0) {
+      // End of file for reads. A write that makes no progress is an error.
+      return isWrite ? EIO : 0;
+    }
+    done += result;
+    skip = result;
+    while (first < iovecs.size() && skip >= iovecs[first].iov_len) {
+      skip -= iovecs[first++].iov_len;
+    }
+  }
+  return 0;
+}
+
+// User data of submission queue entries that were turned into no-ops after a
+// failed submit. Their completions are ignored.
+char discardedOpTag;
+} // namespace
+
+struct IoUring::Batch {
+  // Context of one submission queue entry.
+  struct Op {
+    Batch* batch;
+    const Request* request;
+  };
+
+  // 'numPending' starts with one count for each request and one for the
+  // submitting thread, which drops its count once the ring owns the batch.
+  Batch(std::vector<Request> _requests, bool _isWrite)
+      : requests(std::move(_requests)),
+        isWrite(_isWrite),
+        numPending(requests.size() + 1) {
+    ops.reserve(requests.size());
+    for (const auto& request : requests) {
+      ops.push_back(Op{this, &request});
+    }
+  }
+
+  // Records the completion of 'op' with 'result' from the completion queue.
+  // Returns true if this was the last pending request of the batch.
+  bool complete(const Op& op, int32_t result) {
+    if (result == -EAGAIN || result == -EINTR) {
+      uint64_t done = 0;
+      recordError(completeBlocking(*op.request, isWrite, done));
+      numBytes += done;
+    } else if (result < 0) {
+      recordError(-result);
+    } else {
+      uint64_t done = result;
+      if (isWrite && done < totalSize(op.request->iovecs)) {
+        recordError(completeBlocking(*op.request, isWrite, done));
+      }
+      numBytes += done;
+    }
+    return release(1);
+  }
+
+  // Drops 'count' pending requests. Returns true if no requests remain, in
+  // which case the caller finishes and frees the batch.
+  bool release(int32_t count) {
+    return numPending.fetch_sub(count, std::memory_order_acq_rel) == count;
+  }
+
+  void recordError(int32_t errorCode) {
+    int32_t expected = 0;
+    error.compare_exchange_strong(expected, errorCode);
+  }
+
+  // Fulfills 'promise'. Called after the last request is complete.
+  void finish() {
+    promise.setTry(folly::makeTryWith([&]() {
+      VELOX_CHECK_EQ(
+          error.load(),
+          0,
+          "io_uring {} failed: {}",
+          isWrite ? "write" : "read",
+          folly::errnoStr(error.load()));
+      return numBytes;
+    }));
+  }
+
+  const std::vector<Request> requests;
+  const bool isWrite;
+  std::vector<Op> ops;
+  folly::Promise<uint64_t> promise;
+  // Requests whose completion has not been seen plus the count held by the
+  // submitting thread. Decremented by both the submitting and the completion
+  // thread.
+  std::atomic<int32_t> numPending;
+  uint64_t numBytes{0};
+  // The first errno reported for any request of the batch.
+  std::atomic<int32_t> error{0};
+};
+
+bool IoUring::isSupported() {
+  return true;
+}
+
+IoUring::IoUring(uint32_t queueDepth) : ring_(new struct ::io_uring) {
+  const auto ret = io_uring_queue_init(queueDepth, ring_, 0);
+  if (ret < 0) {
+    delete ring_;
+    ring_ = nullptr;
+    VELOX_FAIL("io_uring_queue_init failed: {}", folly::errnoStr(-ret));
+  }
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    std::lock_guard<std::mutex> l(submitMutex_);
+    // A no-op with no data stops the completion thread after all earlier
+    // completions are reaped.
+    auto* sqe = io_uring_get_sqe(ring_);
+    if (sqe == nullptr) {
+      submitQueued();
+      sqe = io_uring_get_sqe(ring_);
+    }
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    const auto ret = submitQueued();
+    VELOX_CHECK_EQ(
+        ret, 0, "io_uring_submit failed: {}", folly::errnoStr(-ret));
+  }
+  completionThread_.join();
+  io_uring_queue_exit(ring_);
+  delete ring_;
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(
+    std::vector<Request> requests,
+    bool isWrite) {
+  if (requests.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  for (const auto& request : requests) {
+    VELOX_CHECK(!request.iovecs.empty());
+    VELOX_CHECK_LE(request.iovecs.size(), IOV_MAX);
+  }
+  // Owned by this function until the ring takes its entries. After that, the
+  // last of this function and the completion thread to release it frees it.
+  auto batch = std::make_unique<Batch>(std::move(requests), isWrite);
+  auto future = batch->promise.getSemiFuture();
+
+  std::unique_lock<std::mutex> l(submitMutex_);
+  int32_t numQueued = 0;
+  int32_t ret = 0;
+  for (auto& op : batch->ops) {
+    auto* sqe = io_uring_get_sqe(ring_);
+    if (sqe == nullptr) {
+      // The submission queue is full. Submitting makes its entries reusable.
+      ret = submitQueued();
+      sqe = ret == 0 ? io_uring_get_sqe(ring_) : nullptr;
+      if (sqe == nullptr) {
+        ret = ret < 0 ? ret : -EBUSY;
+        break;
+      }
+    }
+    const auto& request = *op.request;
+    const auto bufferIndex = request.iovecs.size() == 1
+        ? registeredBufferIndex(request.iovecs[0])
+        : -1;
+    if (bufferIndex >= 0) {
+      const auto& iov = request.iovecs[0];
+      if (isWrite) {
+        io_uring_prep_write_fixed(
+            sqe,
+            request.fd,
+            iov.iov_base,
+            iov.iov_len,
+            request.offset,
+            bufferIndex);
+      } else {
+        io_uring_prep_read_fixed(
+            sqe,
+            request.fd,
+            iov.iov_base,
+            iov.iov_len,
+            request.offset,
+            bufferIndex);
+      }
+      ++numFixedBufferRequests_;
+    } else if (isWrite) {
+      io_uring_prep_writev(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    }
+    io_uring_sqe_set_data(sqe, &op);
+    ++numQueued;
+  }
+  if (ret == 0) {
+    ret = submitQueued();
+  }
+  if (ret < 0) {
+    // The entries the kernel did not take stay in the submission queue and
+    // could run on a later submit. Make them no-ops. The entries the kernel
+    // took complete normally and keep the batch alive until then.
+    numQueued -= discardQueued(*batch);
+    batch->recordError(-ret);
+  }
+  l.unlock();
+
+  auto* submitted = batch.release();
+  const int32_t numNotQueued = submitted->ops.size() - numQueued;
+  if (submitted->release(numNotQueued + 1)) {
+    // Nothing is in flight, so the future fails here on a submit error.
+    submitted->finish();
+    delete submitted;
+  }
+  return future;
+}
+
+int32_t IoUring::submitQueued() {
+  while (io_uring_sq_ready(ring_) > 0) {
+    const auto ret = io_uring_submit(ring_);
+    ++numSubmits_;
+    if (ret == -EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      return ret < 0 ? ret : -EAGAIN;
+    }
+  }
+  return 0;
+}
+
+int32_t IoUring::discardQueued(const Batch& batch) {
+  const auto* firstOp = batch.ops.data();
+  const auto* endOp = firstOp + batch.ops.size();
+  const auto mask = *ring_->sq.kring_mask;
+  int32_t numDiscarded = 0;
+  for (auto i = *ring_->sq.khead; i != *ring_->sq.ktail; ++i) {
+    auto* sqe = &ring_->sq.sqes[i & mask];
+    const auto* op = reinterpret_cast<const Batch::Op*>(sqe->user_data);
+    if (op >= firstOp && op < endOp) {
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, &discardedOpTag);
+      ++numDiscarded;
+    }
+  }
+  return numDiscarded;
+}
+
+folly::SemiFuture<uint64_t> IoUring::readv(std::vector<Request> requests) {
+  return submit(std::move(requests), false);
+}
+
+folly::SemiFuture<uint64_t> IoUring::writev(std::vector<Request> requests) {
+  return submit(std::move(requests), true);
+}
+
+void IoUring::registerBuffers(const std::vector<folly::Range<char*>>& buffers) {
+  std::lock_guard<std::mutex> l(submitMutex_);
+  VELOX_CHECK(
+      registeredBuffers_.empty(), "io_uring buffers are already registered");
+  std::vector<iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (const auto& buffer : buffers) {
+    iovecs.push_back({buffer.data(), buffer.size()});
+  }
+  const auto ret =
+      io_uring_register_buffers(ring_, iovecs.data(), iovecs.size());
+  VELOX_CHECK_EQ(
+      ret, 0, "io_uring_register_buffers failed: {}", folly::errnoStr(-ret));
+  registeredBuffers_ = buffers;
+}
+
+int32_t IoUring::registeredBufferIndex(const iovec& iov) const {
+  const auto* begin = static_cast<const char*>(iov.iov_base);
+  for (auto i = 0; i < registeredBuffers_.size(); ++i) {
+    const auto& buffer = registeredBuffers_[i];
+    if (begin >= buffer.begin() && begin + iov.iov_len <= buffer.end()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    struct io_uring_cqe* cqe;
+    const auto ret = io_uring_wait_cqe(ring_, &cqe);
+    if (ret < 0) {
+      if (ret != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-ret);
+      }
+      continue;
+    }
+    auto* data = io_uring_cqe_get_data(cqe);
+    const auto result = cqe->res;
+    io_uring_cqe_seen(ring_, cqe);
+    if (data == nullptr) {
+      return;
+    }
+    if (data == &discardedOpTag) {
+      continue;
+    }
+    auto* op = static_cast<Batch::Op*>(data);
+    auto* batch = op->batch;
+    if (batch->complete(*op, result)) {
+      batch->finish();
+      delete batch;
+    }
+  }
+}
+
+#else
+
+bool IoUring::isSupported() {
+  return false;
+}
+
+IoUring::IoUring(uint32_t /*queueDepth*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+IoUring::~IoUring() = default;
+
+folly::SemiFuture<uint64_t> IoUring::submit(
+    std::vector<Request> /*requests*/,
+    bool /*isWrite*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+folly::SemiFuture<uint64_t> IoUring::readv(std::vector<Request> requests) {
+  return submit(std::move(requests), false);
+}
+
+folly::SemiFuture<uint64_t> IoUring::writev(std::vector<Request> requests) {
+  return submit(std::move(requests), true);
+}
+
+void IoUring::registerBuffers(
+    const std::vector<folly::Range<char*>>& /*buffers*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+int32_t IoUring::registeredBufferIndex(const iovec& /*iov*/) const {
+  return -1;
+}
+
+void IoUring::reapCompletions() {}
+
+#endif // VELOX_ENABLE_IO_URING
+
+IoUring* IoUring::getInstance() {
+  // Intentionally leaked so that files closed during static destruction can
+  // still complete their IO.
+  static IoUring* instance = []() -> IoUring* {
+    if (!isSupported()) {
+      return nullptr;
+    }
+    try {
+      return new IoUring();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available, using blocking IO: "
+                   << e.what();
+      return nullptr;
+    }
+  }();
+  return instance;
+}
+
+} // namespace facebook::velox
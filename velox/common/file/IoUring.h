@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct io_uring;
+
+namespace facebook::velox {
+
+/// An io_uring submission and completion queue pair shared by local files that
+/// opt into io_uring. A batch of reads or writes is queued and submitted with
+/// a single system call. A dedicated thread reaps completions and fulfills
+/// the future of a batch when all of its requests are done, so that callers
+/// neither block a thread per request nor hop through an executor.
+///
+/// This is only functional if Velox is built with VELOX_ENABLE_IO_URING.
+/// Otherwise getInstance() returns nullptr and files use blocking IO.
+class IoUring {
+ public:
+  static constexpr uint32_t kDefaultQueueDepth = 256;
+
+  /// One vectored read or write of 'iovecs' at 'offset' of 'fd'.
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+  };
+
+  /// Returns the process wide instance or nullptr if io_uring is not compiled
+  /// in or the kernel does not allow setting up a ring. The instance is
+  /// created on first use.
+  static IoUring* getInstance();
+
+  /// True if Velox is built with io_uring support.
+  static bool isSupported();
+
+  /// Sets up a ring with 'queueDepth' submission queue entries and starts the
+  /// completion thread. Throws if io_uring is not available.
+  explicit IoUring(uint32_t queueDepth = kDefaultQueueDepth);
+
+  ~IoUring();
+
+  /// Submits the reads in 'requests' as one batch. The returned future is
+  /// fulfilled with the total number of bytes read. A read may be short only
+  /// at end of file. The buffers must stay live until the future completes.
+  folly::SemiFuture<uint64_t> readv(std::vector<Request> requests);
+
+  /// Submits the writes in 'requests' as one batch. The returned future is
+  /// fulfilled with the total number of bytes written, which is always the
+  /// total size of 'requests' unless the future holds an error. Short writes
+  /// are completed with blocking IO on the completion thread.
+  folly::SemiFuture<uint64_t> writev(std::vector<Request> requests);
+
+  /// Registers 'buffers' with the kernel so that requests with a single iovec
+  /// inside one of them are issued as fixed buffer reads and writes, which
+  /// saves mapping the user pages on each request. The memory must be backed
+  /// and stay live for the lifetime of 'this'. Can be called once.
+  void registerBuffers(const std::vector<folly::Range<char*>>& buffers);
+
+  /// Returns the number of system calls made to submit batches.
+  uint64_t numSubmits() const {
+    return numSubmits_;
+  }
+
+  /// Returns the number of requests submitted as fixed buffer operations.
+  uint64_t numFixedBufferRequests() const {
+    return numFixedBufferRequests_;
+  }
+
+ private:
+  struct Batch;
+
+  folly::SemiFuture<uint64_t> submit(
+      std::vector<Request> requests,
+      bool isWrite);
+
+  // Submits the submission queue entries until the kernel has taken all of
+  // them. Returns 0 or a negative errno. Called with 'submitMutex_' held.
+  int32_t submitQueued();
+
+  // Turns the entries of 'batch' that are still in the submission queue into
+  // no-ops after a failed submit. Returns the number of such entries. Called
+  // with 'submitMutex_' held.
+  int32_t discardQueued(const Batch& batch);
+
+  // Returns the index of the registered buffer that contains 'iov' or -1.
+  int32_t registeredBufferIndex(const iovec& iov) const;
+
+  // Body of 'completionThread_'.
+  void reapCompletions();
+
+  struct ::io_uring* ring_{nullptr};
+
+  // Serializes access to the submission queue.
+  std::mutex submitMutex_;
+
+  // Registered buffers. The position is the index of the buffer in fixed
+  // buffer operations.
+  std::vector<folly::Range<char*>> registeredBuffers_;
+
+  std::thread completionThread_;
+
+  std::atomic<uint64_t> numSubmits_{0};
+  std::atomic<uint64_t> numFixedBufferRequests_{0};
+};
+
+} // namespace facebook::velox
@@ -21,6 +21,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
@@ -51,7 +52,9 @@ class FileInputStreamTest : public testing::Test {
 
   std::unique_ptr<common::FileInputStream> createStream(
       uint64_t streamSize,
-      uint32_t bufferSize = 1024) {
+      uint32_t bufferSize = 1024,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 1) {
     const auto filePath =
         fmt::format("{}/{}", tempDirPath_->getPath(), fileId_++);
     auto writeFile = fs_->openFileForWrite(filePath);
@@ -63,7 +66,11 @@ class FileInputStreamTest : public testing::Test {
         std::string_view(reinterpret_cast<char*>(buffer), streamSize));
     writeFile->close();
     return std::make_unique<common::FileInputStream>(
-        fs_->openFileForRead(filePath), bufferSize, pool_.get());
+        fs_->openFileForRead(filePath),
+        bufferSize,
+        pool_.get(),
+        readAheadExecutor,
+        numReadAheadBuffers);
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -112,3 +119,81 @@ TEST_F(FileInputStreamTest, stats) {
     ASSERT_GT(byteStream->stats().readTimeNs, 0);
   }
 }
+
+TEST_F(FileInputStreamTest, readAhead) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  struct {
+    size_t streamSize;
+    size_t bufferSize;
+    uint32_t numReadAheadBuffers;
+    // The expected number of buffers allocated by the stream.
+    uint32_t expectedNumBuffers;
+
+    std::string debugString() const {
+      return fmt::format(
+          "streamSize {}, bufferSize {}, numReadAheadBuffers {}, "
+          "expectedNumBuffers {}",
+          streamSize,
+          bufferSize,
+          numReadAheadBuffers,
+          expectedNumBuffers);
+    }
+  } testSettings[] = {
+      {4096, 1024, 0, 1},
+      {4096, 1024, 1, 2},
+      {4096, 1024, 2, 3},
+      {4096, 1024, 3, 4},
+      {4096, 1024, 8, 4},
+      {4096, 4096, 2, 1},
+      {64 << 10, 1024, 4, 5}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    ASSERT_EQ(pool_->usedBytes(), 0);
+    auto byteStream = createStream(
+        testData.streamSize,
+        testData.bufferSize,
+        executor.get(),
+        testData.numReadAheadBuffers);
+    // The read-ahead buffers are charged to the memory pool.
+    ASSERT_GE(
+        pool_->usedBytes(), testData.expectedNumBuffers * testData.bufferSize);
+    ASSERT_LT(
+        pool_->usedBytes(),
+        (testData.expectedNumBuffers + 1) * testData.bufferSize);
+
+    uint8_t buffer[testData.streamSize / 8];
+    for (int offset = 0; offset < testData.streamSize;) {
+      byteStream->readBytes(buffer, testData.streamSize / 8);
+      for (int i = 0; i < testData.streamSize / 8; ++i, ++offset) {
+        ASSERT_EQ(buffer[i], offset % 256);
+      }
+    }
+    ASSERT_TRUE(byteStream->atEnd());
+    const auto stats = byteStream->stats();
+    const auto numReads = testData.streamSize / testData.bufferSize;
+    ASSERT_EQ(stats.numReads, numReads);
+    ASSERT_EQ(stats.readBytes, testData.streamSize);
+    if (testData.expectedNumBuffers == 1) {
+      ASSERT_EQ(stats.numReadAheadHits, 0);
+      ASSERT_EQ(stats.numReadAheadMisses, 0);
+      ASSERT_EQ(stats.readAheadWaitNs, 0);
+    } else {
+      // All reads but the first one are served by read-ahead.
+      ASSERT_EQ(
+          stats.numReadAheadHits + stats.numReadAheadMisses, numReads - 1);
+    }
+    byteStream.reset();
+  }
+}
+
+TEST_F(FileInputStreamTest, readAheadDestroyWithPendingReads) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  for (int i = 0; i < 10; ++i) {
+    auto byteStream = createStream(64 << 10, 1024, executor.get(), 16);
+    uint8_t buffer[100];
+    byteStream->readBytes(buffer, sizeof(buffer));
+    ASSERT_EQ(buffer[99], 99);
+  }
+  ASSERT_EQ(pool_->usedBytes(), 0);
+}
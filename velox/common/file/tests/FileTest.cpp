@@ -15,11 +15,13 @@
  */
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -233,6 +235,105 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, ioUring) {
+  if (useFaultyFs_ || IoUring::getInstance() == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto* ioUring = IoUring::getInstance();
+  struct {
+    bool useIOBuf;
+    bool withOffset;
+
+    std::string debugString() const {
+      return fmt::format("useIOBuf {}, withOffset {}", useIOBuf, withOffset);
+    }
+  } testSettings[] = {{false, false}, {true, false}, {false, true}};
+  for (auto testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    auto tempFile = exec::test::TempFilePath::create();
+    const auto& filename = tempFile->getPath();
+    auto fs = filesystems::getFileSystem(filename, {});
+    fs->remove(filename);
+    filesystems::FileOptions options;
+    options.useIoUring = true;
+    {
+      const auto numSubmits = ioUring->numSubmits();
+      auto writeFile = fs->openFileForWrite(filename, options);
+      if (testData.withOffset) {
+        writeDataWithOffset(writeFile.get());
+      } else {
+        writeData(writeFile.get(), testData.useIOBuf);
+      }
+      writeFile->close();
+      ASSERT_EQ(writeFile->size(), 15 + kOneMB);
+      ASSERT_GT(ioUring->numSubmits(), numSubmits);
+    }
+    const auto numSubmits = ioUring->numSubmits();
+    auto readFile = fs->openFileForRead(filename, options);
+    ASSERT_TRUE(readFile->hasPreadvAsync());
+    readData(readFile.get(), true, true);
+    ASSERT_GT(ioUring->numSubmits(), numSubmits);
+  }
+}
+
+TEST_P(LocalFileTest, ioUringRegisteredBuffers) {
+  if (useFaultyFs_ || !IoUring::isSupported()) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  std::unique_ptr<IoUring> ioUring;
+  try {
+    ioUring = std::make_unique<IoUring>(8);
+  } catch (const VeloxException& e) {
+    GTEST_SKIP() << e.what();
+  }
+  std::string registered(kOneMB, 0);
+  ioUring->registerBuffers({{registered.data(), registered.size()}});
+  VELOX_ASSERT_THROW(
+      ioUring->registerBuffers({{registered.data(), registered.size()}}),
+      "io_uring buffers are already registered");
+
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    LocalWriteFile writeFile(filename, false, true, true, ioUring.get());
+    writeData(&writeFile);
+    writeFile.close();
+  }
+  int32_t fd = ::open(filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  // More requests than queue entries. The first is inside the registered
+  // buffer, the rest are not.
+  std::vector<std::string> buffers(20, std::string(5, 0));
+  std::vector<IoUring::Request> requests;
+  requests.push_back({fd, 10, {{registered.data() + 100, kOneMB / 2}}});
+  for (auto i = 0; i < buffers.size(); ++i) {
+    requests.push_back(
+        {fd,
+         static_cast<uint64_t>(i % 2 == 0 ? 0 : 10 + kOneMB),
+         {{buffers[i].data(), buffers[i].size()}}});
+  }
+  ASSERT_EQ(
+      ioUring->readv(std::move(requests)).get(),
+      kOneMB / 2 + 5 * buffers.size());
+  ASSERT_EQ(ioUring->numFixedBufferRequests(), 1);
+  ASSERT_GE(ioUring->numSubmits(), 3);
+  ASSERT_EQ(
+      std::string_view(registered.data() + 100, kOneMB / 2),
+      std::string(kOneMB / 2, 'c'));
+  for (auto i = 0; i < buffers.size(); ++i) {
+    ASSERT_EQ(buffers[i], i % 2 == 0 ? "aaaaa" : "ddddd");
+  }
+  // Reads past the end of file are short.
+  std::string tail(10, 0);
+  ASSERT_EQ(
+      ioUring->readv({{fd, 10 + kOneMB, {{tail.data(), tail.size()}}}}).get(),
+      5);
+  ::close(fd);
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
@@ -108,6 +108,13 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, the allocator keeps separate size classes for each NUMA node
+  /// and allocates from the node preferred by the calling thread. Drivers
+  /// prefer the node of their Task, see QueryCtx.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAwareAllocation{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
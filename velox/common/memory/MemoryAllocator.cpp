@@ -368,6 +368,10 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numaRemoteAllocatedBytes =
+      numaRemoteAllocatedBytes - other.numaRemoteAllocatedBytes;
+  result.numaRemoteFreedBytes =
+      numaRemoteFreedBytes - other.numaRemoteFreedBytes;
   return result;
 }
 
@@ -382,11 +386,18 @@ std::string Stats::toString() const {
     totalAllocations += sizes[i].numAllocations;
   }
   out << fmt::format(
-      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB\n",
+      "Alloc: {}MB {} Gigaclocks Allocations={}, advised={} MB",
       totalBytes >> 20,
       totalClocks >> 30,
       totalAllocations,
       numAdvise >> 8);
+  if (numaRemoteAllocatedBytes != 0 || numaRemoteFreedBytes != 0) {
+    out << fmt::format(
+        ", NUMA remote allocated={} MB freed={} MB",
+        numaRemoteAllocatedBytes >> 20,
+        numaRemoteFreedBytes >> 20);
+  }
+  out << "\n";
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -134,6 +134,11 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative bytes allocated and freed by threads running on a different
+  /// NUMA node than the memory, if the allocator is NUMA aware.
+  int64_t numaRemoteAllocatedBytes{0};
+  int64_t numaRemoteFreedBytes{0};
 };
 
 class MemoryAllocator;
@@ -22,8 +22,19 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/Numa.h"
 
 namespace facebook::velox::memory {
+namespace {
+int32_t numNumaNodes(const MmapAllocator::Options& options) {
+  if (!options.numaAware) {
+    return 1;
+  }
+  return options.numNumaNodes > 0 ? options.numNumaNodes
+                                  : process::numNumaNodes();
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : MemoryAllocator(options.largestSizeClass),
       kind_(MemoryAllocator::Kind::kMmap),
@@ -35,9 +46,15 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(numNumaNodes(options)) {
+  // Each node has the full capacity in each size class, so that any mix of
+  // allocations fits on any node. This only costs address space.
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -91,6 +108,8 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
 
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
+  const auto node =
+      allocationNumaNode(AllocationTraits::pageBytes(sizeMix.totalPages));
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
@@ -98,8 +117,8 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(node, sizeMix.sizeIndices[i])
+                        .allocate(sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -183,6 +202,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
     return numFreed;
   }
 
+  const int32_t currentNode =
+      numNumaNodes_ > 1 ? process::currentNumaNode() : -1;
   for (auto i = 0; i < sizeClasses_.size(); ++i) {
     auto& sizeClass = sizeClasses_[i];
     int32_t pages = 0;
@@ -195,10 +216,13 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
+    if (pages > 0 && currentNode >= 0 && sizeClass->numaNode() != currentNode) {
+      numaRemoteFreedBytes_ += AllocationTraits::pageBytes(pages);
+    }
     numFreed += pages;
   }
   allocation.clear();
@@ -337,6 +361,12 @@ bool MmapAllocator::allocateContiguousImpl(
           MAP_PRIVATE | MAP_ANONYMOUS,
           -1,
           0);
+      if (numNumaNodes_ > 1 && data != MAP_FAILED) {
+        process::bindToNumaNode(
+            data,
+            AllocationTraits::pageBytes(maxPages),
+            allocationNumaNode(AllocationTraits::pageBytes(numPages)));
+      }
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -509,9 +539,13 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
+      numaNode_(numaNode),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
@@ -538,6 +572,12 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode_ >= 0 &&
+      !process::bindToNumaNode(address_, byteSize_, numaNode_)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind sizeClass " << unitSize_
+                           << " to NUMA node " << numaNode_ << ": "
+                           << folly::errnoStr(errno);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -955,6 +995,17 @@ bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
 
+int32_t MmapAllocator::allocationNumaNode(uint64_t bytes) {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  const auto node = process::preferredNumaNode() % numNumaNodes_;
+  if (node != process::currentNumaNode()) {
+    numaRemoteAllocatedBytes_ += bytes;
+  }
+  return node;
+}
+
 std::string MmapAllocator::toString() const {
   std::stringstream out;
   out << "Memory Allocator[" << kindString(kind_) << " total capacity "
@@ -965,7 +1016,11 @@ std::string MmapAllocator::toString() const {
               : succinctBytes(
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numNumaNodes_ > 1) {
+    out << " NUMA nodes " << numNumaNodes_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -80,6 +80,16 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the size classes are replicated for each NUMA node with their
+    /// address ranges bound to the node. Allocations are made from the size
+    /// classes of the preferred node of the calling thread, see
+    /// process::preferredNumaNode(). The capacity is shared by all nodes.
+    bool numaAware = false;
+
+    /// Number of NUMA nodes to keep size classes for if 'numaAware' is true. 0
+    /// means the number of nodes of the machine.
+    int32_t numNumaNodes = 0;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -156,9 +166,17 @@ class MmapAllocator : public MemoryAllocator {
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
+    stats.numaRemoteAllocatedBytes = numaRemoteAllocatedBytes_;
+    stats.numaRemoteFreedBytes = numaRemoteFreedBytes_;
     return stats;
   }
 
+  /// Returns the number of NUMA nodes with their own size classes. 1 if not
+  /// NUMA aware.
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
   std::string toString() const override;
 
  private:
@@ -168,7 +186,12 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not negative, the address range prefers memory from
+    // NUMA node 'numaNode'.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = -1);
 
     ~SizeClass();
 
@@ -176,6 +199,10 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    int32_t numaNode() const {
+      return numaNode_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -273,6 +300,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size of one size class page in machine pages.
     const MachinePageCount unitSize_;
 
+    // NUMA node the address range is bound to, -1 if none.
+    const int32_t numaNode_;
+
     // Size in bytes of the address range.
     const size_t byteSize_;
 
@@ -372,6 +402,16 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to allocate from for the calling thread. Counts
+  // 'bytes' as remote if the thread does not run on that node.
+  int32_t allocationNumaNode(uint64_t bytes);
+
+  // Returns the size class with index 'index' in 'sizeClassSizes_' for NUMA
+  // node 'node'.
+  SizeClass& sizeClass(int32_t node, int32_t index) {
+    return *sizeClasses_[node * sizeClassSizes_.size() + index];
+  }
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -408,12 +448,21 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // Number of NUMA nodes with their own size classes.
+  const int32_t numNumaNodes_;
+
+  // The size classes of each NUMA node. The classes of node n are at
+  // [n * sizeClassSizes_.size(), (n + 1) * sizeClassSizes_.size()).
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  // Bytes allocated or freed by threads running on a different NUMA node than
+  // the memory.
+  std::atomic<uint64_t> numaRemoteAllocatedBytes_ = 0;
+  std::atomic<uint64_t> numaRemoteFreedBytes_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
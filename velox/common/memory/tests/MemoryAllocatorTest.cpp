@@ -21,6 +21,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
 #include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/process/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/flag_definitions/flags.h"
 
@@ -481,6 +482,92 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, numaAwareMmapAllocator) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numaAware = true;
+  options.numNumaNodes = 2;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(allocator->numNumaNodes(), 2);
+  ASSERT_THAT(allocator->toString(), testing::HasSubstr("NUMA nodes 2"));
+
+  constexpr MachinePageCount kNumPages = 100;
+  Allocation local;
+  Allocation remote;
+  {
+    process::ScopedPreferredNumaNode scopedNode(0);
+    ASSERT_TRUE(allocator->allocateNonContiguous(kNumPages, local));
+  }
+  {
+    process::ScopedPreferredNumaNode scopedNode(1);
+    ASSERT_TRUE(allocator->allocateNonContiguous(kNumPages, remote));
+  }
+  ASSERT_EQ(allocator->numAllocated(), 2 * kNumPages);
+  ASSERT_TRUE(allocator->checkConsistency());
+  // The nodes have disjoint address ranges.
+  for (auto i = 0; i < local.numRuns(); ++i) {
+    for (auto j = 0; j < remote.numRuns(); ++j) {
+      const auto localRun = local.runAt(i);
+      const auto remoteRun = remote.runAt(j);
+      ASSERT_TRUE(
+          localRun.data() + localRun.numBytes() <= remoteRun.data() ||
+          remoteRun.data() + remoteRun.numBytes() <= localRun.data());
+    }
+  }
+
+  // The remote counts can only be checked exactly if the test runs on node 0.
+  const bool onNodeZero = process::numNumaNodes() == 1;
+  if (onNodeZero) {
+    const auto stats = allocator->stats();
+    ASSERT_EQ(
+        stats.numaRemoteAllocatedBytes, AllocationTraits::pageBytes(kNumPages));
+    ASSERT_EQ(stats.numaRemoteFreedBytes, 0);
+  }
+  allocator->freeNonContiguous(local);
+  allocator->freeNonContiguous(remote);
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  if (onNodeZero) {
+    const auto stats = allocator->stats();
+    ASSERT_EQ(
+        stats.numaRemoteFreedBytes, AllocationTraits::pageBytes(kNumPages));
+    ASSERT_THAT(stats.toString(), testing::HasSubstr("NUMA remote"));
+  }
+
+  // Contiguous allocations above the largest size class are mmapped
+  // separately and bound to the preferred node.
+  const MachinePageCount contiguousPages =
+      kNumPages * allocator->sizeClasses().back();
+  ContiguousAllocation contiguous;
+  {
+    process::ScopedPreferredNumaNode scopedNode(1);
+    ASSERT_TRUE(
+        allocator->allocateContiguous(contiguousPages, nullptr, contiguous));
+  }
+  if (onNodeZero) {
+    ASSERT_EQ(
+        allocator->stats().numaRemoteAllocatedBytes,
+        AllocationTraits::pageBytes(kNumPages + contiguousPages));
+  }
+  allocator->freeContiguous(contiguous);
+  ASSERT_EQ(allocator->numAllocated(), 0);
+
+  // Not NUMA aware allocators do not count remote traffic.
+  MmapAllocator::Options plainOptions;
+  plainOptions.capacity = kCapacityBytes;
+  auto plainAllocator = std::make_shared<MmapAllocator>(plainOptions);
+  ASSERT_EQ(plainAllocator->numNumaNodes(), 1);
+  {
+    process::ScopedPreferredNumaNode scopedNode(1);
+    ASSERT_TRUE(plainAllocator->allocateNonContiguous(kNumPages, local));
+  }
+  plainAllocator->freeNonContiguous(local);
+  ASSERT_EQ(plainAllocator->stats().numaRemoteAllocatedBytes, 0);
+  ASSERT_EQ(plainAllocator->stats().numaRemoteFreedBytes, 0);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+
+namespace facebook::velox::process {
+
+namespace {
+constexpr const char* kNodeDir = "/sys/devices/system/node";
+
+// Parses a sysfs list like "0-3,8,10-11" into the listed numbers.
+std::vector<int32_t> parseSysfsList(const std::string& text) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(text), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    try {
+      if (dash == folly::StringPiece::npos) {
+        result.push_back(folly::to<int32_t>(range));
+      } else {
+        const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+        const auto last = folly::to<int32_t>(range.subpiece(dash + 1));
+        for (auto i = first; i <= last; ++i) {
+          result.push_back(i);
+        }
+      }
+    } catch (const std::exception&) {
+      return {};
+    }
+  }
+  return result;
+}
+
+struct NumaTopology {
+  NumaTopology() {
+    std::string online;
+    std::vector<int32_t> nodes;
+    if (folly::readFile(fmt::format("{}/online", kNodeDir).c_str(), online)) {
+      nodes = parseSysfsList(online);
+    }
+    for (const auto node : nodes) {
+      std::string cpuList;
+      if (!folly::readFile(
+              fmt::format("{}/node{}/cpulist", kNodeDir, node).c_str(),
+              cpuList)) {
+        continue;
+      }
+      if (node >= nodeCpus.size()) {
+        nodeCpus.resize(node + 1);
+      }
+      nodeCpus[node] = parseSysfsList(cpuList);
+      for (const auto cpu : nodeCpus[node]) {
+        if (cpu >= cpuNodes.size()) {
+          cpuNodes.resize(cpu + 1, 0);
+        }
+        cpuNodes[cpu] = node;
+      }
+    }
+    if (nodeCpus.empty()) {
+      // Not NUMA or no sysfs. All CPUs are on node 0.
+      nodeCpus.resize(1);
+      const int32_t numCpus =
+          std::max<int32_t>(1, std::thread::hardware_concurrency());
+      for (auto cpu = 0; cpu < numCpus; ++cpu) {
+        nodeCpus[0].push_back(cpu);
+      }
+      cpuNodes.resize(numCpus, 0);
+    }
+  }
+
+  // CPUs of each node, indexed by node.
+  std::vector<std::vector<int32_t>> nodeCpus;
+
+  // The node of each CPU, indexed by CPU.
+  std::vector<int32_t> cpuNodes;
+};
+
+const NumaTopology& topology() {
+  static const NumaTopology kTopology;
+  return kTopology;
+}
+
+// The node set by the innermost ScopedPreferredNumaNode of the thread, -1 if
+// none.
+thread_local int32_t preferredNode{-1};
+} // namespace
+
+int32_t numNumaNodes() {
+  return topology().nodeCpus.size();
+}
+
+const std::vector<int32_t>& numaNodeCpus(int32_t node) {
+  static const std::vector<int32_t> kEmpty;
+  const auto& nodeCpus = topology().nodeCpus;
+  if (node < 0 || node >= nodeCpus.size()) {
+    return kEmpty;
+  }
+  return nodeCpus[node];
+}
+
+int32_t numaNodeOfCpu(int32_t cpu) {
+  const auto& cpuNodes = topology().cpuNodes;
+  if (cpu < 0 || cpu >= cpuNodes.size()) {
+    return 0;
+  }
+  return cpuNodes[cpu];
+}
+
+int32_t currentNumaNode() {
+#ifdef __linux__
+  return numaNodeOfCpu(sched_getcpu());
+#else
+  return 0;
+#endif
+}
+
+int32_t preferredNumaNode() {
+  return preferredNode >= 0 ? preferredNode : currentNumaNode();
+}
+
+ScopedPreferredNumaNode::ScopedPreferredNumaNode(int32_t node)
+    : savedNode_(preferredNode) {
+  if (node >= 0) {
+    preferredNode = node;
+  }
+}
+
+ScopedPreferredNumaNode::~ScopedPreferredNumaNode() {
+  preferredNode = savedNode_;
+}
+
+bool bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // MPOL_PREFERRED from <numaif.h>, which comes with libnuma.
+  constexpr int kMpolPreferred = 1;
+  constexpr int32_t kBitsPerWord = 8 * sizeof(unsigned long);
+  std::array<unsigned long, 16> nodeMask{};
+  if (node < 0 || node >= nodeMask.size() * kBitsPerWord) {
+    return false;
+  }
+  nodeMask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+  // The kernel takes one more than the number of bits in the mask.
+  return syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             kMpolPreferred,
+             nodeMask.data(),
+             nodeMask.size() * kBitsPerWord + 1,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool pinThreadToNumaNode(int32_t node) {
+#ifdef __linux__
+  const auto& cpus = numaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Returns the number of NUMA nodes of the machine. The topology is read from
+/// sysfs once. Returns 1 if the machine is not NUMA or the topology is not
+/// known.
+int32_t numNumaNodes();
+
+/// Returns the CPUs of NUMA node 'node'.
+const std::vector<int32_t>& numaNodeCpus(int32_t node);
+
+/// Returns the NUMA node of 'cpu'. Returns 0 for unknown CPUs.
+int32_t numaNodeOfCpu(int32_t cpu);
+
+/// Returns the NUMA node of the CPU the calling thread runs on. Returns 0 if
+/// this is not known.
+int32_t currentNumaNode();
+
+/// Returns the NUMA node the memory of the calling thread should come from.
+/// This is the node set by the innermost ScopedPreferredNumaNode, or the node
+/// the thread runs on if none is set.
+int32_t preferredNumaNode();
+
+/// Sets the preferred NUMA node of the calling thread for its lifetime. A
+/// negative 'node' leaves the preference unchanged.
+class ScopedPreferredNumaNode {
+ public:
+  explicit ScopedPreferredNumaNode(int32_t node);
+
+  ~ScopedPreferredNumaNode();
+
+ private:
+  const int32_t savedNode_;
+};
+
+/// Sets the memory policy of the pages in ['address', 'address' + 'bytes') to
+/// prefer NUMA node 'node'. Pages that are already backed by memory are not
+/// moved. 'address' must be page aligned. Returns false if the policy could not
+/// be set, e.g. on platforms without NUMA support.
+bool bindToNumaNode(void* address, size_t bytes, int32_t node);
+
+/// Restricts the calling thread to the CPUs of NUMA node 'node'. Returns false
+/// if the affinity could not be set. Typically called from the thread factory
+/// of a node local executor.
+bool pinThreadToNumaNode(int32_t node);
+
+} // namespace facebook::velox::process
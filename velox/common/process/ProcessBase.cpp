@@ -124,6 +124,35 @@ bool hasBmi2() {
 #endif
 }
 
+namespace {
+// Returns the size of the cache described by the sysconf 'name' or
+// 'defaultSize' if the size is not reported.
+uint64_t sysconfCacheSize(int name, uint64_t defaultSize) {
+  const auto size = sysconf(name);
+  return size > 0 ? size : defaultSize;
+}
+} // namespace
+
+uint64_t l2CacheSize() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  static const uint64_t size =
+      sysconfCacheSize(_SC_LEVEL2_CACHE_SIZE, 1UL << 20);
+  return size;
+#else
+  return 1UL << 20;
+#endif
+}
+
+uint64_t lastLevelCacheSize() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  static const uint64_t size =
+      sysconfCacheSize(_SC_LEVEL3_CACHE_SIZE, 32UL << 20);
+  return size;
+#else
+  return 32UL << 20;
+#endif
+}
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
@@ -50,4 +50,12 @@ bool hasAvx2();
 /// by flag.
 bool hasBmi2();
 
+/// Returns the size in bytes of the per-core L2 cache. Returns a typical size
+/// if the size is not known.
+uint64_t l2CacheSize();
+
+/// Returns the size in bytes of the largest shared CPU cache, typically the
+/// L3. Returns a typical size if the size is not known.
+uint64_t lastLevelCacheSize();
+
 } // namespace facebook::velox::process
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(NumaTest, topology) {
+  const auto numNodes = numNumaNodes();
+  ASSERT_GE(numNodes, 1);
+  int32_t numCpus = 0;
+  for (auto node = 0; node < numNodes; ++node) {
+    for (const auto cpu : numaNodeCpus(node)) {
+      EXPECT_EQ(numaNodeOfCpu(cpu), node);
+      ++numCpus;
+    }
+  }
+  EXPECT_GE(numCpus, 1);
+  EXPECT_TRUE(numaNodeCpus(-1).empty());
+  EXPECT_TRUE(numaNodeCpus(numNodes).empty());
+  EXPECT_EQ(numaNodeOfCpu(-1), 0);
+  EXPECT_GE(currentNumaNode(), 0);
+  EXPECT_LT(currentNumaNode(), numNodes);
+}
+
+TEST(NumaTest, scopedPreferredNode) {
+  const auto defaultNode = preferredNumaNode();
+  EXPECT_GE(defaultNode, 0);
+  {
+    ScopedPreferredNumaNode outer(5);
+    EXPECT_EQ(preferredNumaNode(), 5);
+    {
+      ScopedPreferredNumaNode inner(3);
+      EXPECT_EQ(preferredNumaNode(), 3);
+      ScopedPreferredNumaNode noPreference(-1);
+      EXPECT_EQ(preferredNumaNode(), 3);
+    }
+    EXPECT_EQ(preferredNumaNode(), 5);
+    // The preference is per thread.
+    std::thread([&]() {
+      EXPECT_LT(preferredNumaNode(), numNumaNodes());
+    }).join();
+  }
+  EXPECT_LT(preferredNumaNode(), numNumaNodes());
+}
+
+TEST(NumaTest, bindAndPin) {
+  const size_t bytes = 16 * sysconf(_SC_PAGESIZE);
+  void* address = ::mmap(
+      nullptr,
+      bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  ASSERT_NE(address, MAP_FAILED);
+  // Binding may be refused in containers, so only a bad node is checked.
+  bindToNumaNode(address, bytes, 0);
+  EXPECT_FALSE(bindToNumaNode(address, bytes, -1));
+  memset(address, 1, bytes);
+  ::munmap(address, bytes);
+
+  std::thread([]() {
+    if (pinThreadToNumaNode(0)) {
+      EXPECT_EQ(currentNumaNode(), 0);
+    }
+    EXPECT_FALSE(pinThreadToNumaNode(-1));
+  }).join();
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -100,6 +100,13 @@ bool HiveConfig::isParquetUseColumnNames(
       config_->get<bool>(kParquetUseColumnNames, false));
 }
 
+bool HiveConfig::isParquetPageIndexFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetPageIndexFilterEnabledSession,
+      config_->get<bool>(kParquetPageIndexFilterEnabled, true));
+}
+
 bool HiveConfig::isFileColumnNamesReadAsLowerCase(
     const config::ConfigBase* session) const {
   return session->get<bool>(
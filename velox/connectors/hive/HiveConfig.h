@@ -80,6 +80,13 @@ class HiveConfig {
   static constexpr const char* kParquetUseColumnNamesSession =
       "parquet_use_column_names";
 
+  /// If true, the Parquet reader skips the pages whose ColumnIndex shows that
+  /// they can not pass the filters.
+  static constexpr const char* kParquetPageIndexFilterEnabled =
+      "hive.parquet.page-index-filter-enabled";
+  static constexpr const char* kParquetPageIndexFilterEnabledSession =
+      "parquet_page_index_filter_enabled";
+
   /// Reads the source file column name as lower case.
   static constexpr const char* kFileColumnNamesReadAsLowerCase =
       "file-column-names-read-as-lower-case";
@@ -191,6 +198,8 @@ class HiveConfig {
 
   bool isParquetUseColumnNames(const config::ConfigBase* session) const;
 
+  bool isParquetPageIndexFilterEnabled(const config::ConfigBase* session) const;
+
   bool isFileColumnNamesReadAsLowerCase(
       const config::ConfigBase* session) const;
 
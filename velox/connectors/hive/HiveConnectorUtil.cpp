@@ -573,6 +573,8 @@ void configureReaderOptions(
 
   readerOptions.setUseColumnNamesForColumnMapping(
       useColumnNamesForColumnMapping);
+  readerOptions.setParquetPageIndexFilterEnabled(
+      hiveConfig->isParquetPageIndexFilterEnabled(sessionProperties));
   readerOptions.setFileSchema(fileSchema);
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
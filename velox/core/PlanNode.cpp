@@ -86,7 +86,8 @@ const std::vector<PlanNodePtr> kEmptySources;
 RowTypePtr getAggregationOutputType(
     const std::vector<FieldAccessTypedExprPtr>& groupingKeys,
     const std::vector<std::string>& aggregateNames,
-    const std::vector<AggregationNode::Aggregate>& aggregates) {
+    const std::vector<AggregationNode::Aggregate>& aggregates,
+    const std::optional<std::string>& groupIdName = std::nullopt) {
   VELOX_CHECK_EQ(
       aggregateNames.size(),
       aggregates.size(),
@@ -102,6 +103,11 @@ RowTypePtr getAggregationOutputType(
     types.push_back(field->type());
   }
 
+  if (groupIdName.has_value()) {
+    names.push_back(groupIdName.value());
+    types.push_back(BIGINT());
+  }
+
   for (int32_t i = 0; i < aggregateNames.size(); i++) {
     names.push_back(aggregateNames[i]);
     types.push_back(aggregates[i].call->type());
@@ -123,6 +129,31 @@ AggregationNode::AggregationNode(
     const std::optional<FieldAccessTypedExprPtr>& groupId,
     bool ignoreNullKeys,
     PlanNodePtr source)
+    : AggregationNode(
+          id,
+          step,
+          groupingKeys,
+          preGroupedKeys,
+          aggregateNames,
+          aggregates,
+          globalGroupingSets,
+          groupId,
+          ignoreNullKeys,
+          false,
+          source) {}
+
+AggregationNode::AggregationNode(
+    const PlanNodeId& id,
+    Step step,
+    const std::vector<FieldAccessTypedExprPtr>& groupingKeys,
+    const std::vector<FieldAccessTypedExprPtr>& preGroupedKeys,
+    const std::vector<std::string>& aggregateNames,
+    const std::vector<Aggregate>& aggregates,
+    const std::vector<vector_size_t>& globalGroupingSets,
+    const std::optional<FieldAccessTypedExprPtr>& groupId,
+    bool ignoreNullKeys,
+    bool clusteredInput,
+    PlanNodePtr source)
     : PlanNode(id),
       step_(step),
       groupingKeys_(groupingKeys),
@@ -130,6 +161,7 @@ AggregationNode::AggregationNode(
       aggregateNames_(aggregateNames),
       aggregates_(aggregates),
       ignoreNullKeys_(ignoreNullKeys),
+      clusteredInput_(clusteredInput),
       groupId_(groupId),
       globalGroupingSets_(globalGroupingSets),
       sources_{source},
@@ -176,6 +208,23 @@ AggregationNode::AggregationNode(
     VELOX_USER_CHECK(
         groupId_.has_value(), "Global grouping sets require GroupId key");
   }
+
+  if (clusteredInput_) {
+    VELOX_USER_CHECK(
+        isFinal() || isSingle(),
+        "Clustered input requires a final or single aggregation");
+    VELOX_USER_CHECK(
+        !groupingKeys_.empty(), "Clustered input requires grouping keys");
+    VELOX_USER_CHECK(
+        globalGroupingSets_.empty(),
+        "Clustered input does not support global grouping sets");
+    for (const auto& aggregate : aggregates_) {
+      VELOX_USER_CHECK(
+          !aggregate.distinct && aggregate.sortingKeys.empty(),
+          "Clustered input does not support distinct or sorted aggregates: {}",
+          aggregate.call->toString());
+    }
+  }
 }
 
 AggregationNode::AggregationNode(
@@ -199,6 +248,67 @@ AggregationNode::AggregationNode(
           ignoreNullKeys,
           source) {}
 
+AggregationNode::AggregationNode(
+    const PlanNodeId& id,
+    Step step,
+    const std::vector<FieldAccessTypedExprPtr>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::string& groupIdName,
+    const std::vector<std::string>& aggregateNames,
+    const std::vector<Aggregate>& aggregates,
+    PlanNodePtr source)
+    : PlanNode(id),
+      step_(step),
+      groupingKeys_(groupingKeys),
+      aggregateNames_(aggregateNames),
+      aggregates_(aggregates),
+      ignoreNullKeys_(false),
+      groupId_(std::make_shared<FieldAccessTypedExpr>(BIGINT(), groupIdName)),
+      groupingSets_(groupingSets),
+      sources_{source},
+      outputType_(getAggregationOutputType(
+          groupingKeys_,
+          aggregateNames_,
+          aggregates_,
+          groupIdName)) {
+  VELOX_USER_CHECK(
+      step_ == Step::kSingle,
+      "Grouping sets require a single aggregation step");
+  VELOX_USER_CHECK(!groupingSets_.empty(), "Grouping sets must not be empty");
+  VELOX_USER_CHECK(
+      !aggregates_.empty(), "Grouping sets require at least one aggregate");
+  for (const auto& aggregate : aggregates_) {
+    VELOX_USER_CHECK(
+        !aggregate.distinct && aggregate.sortingKeys.empty(),
+        "Grouping sets do not support distinct or sorted aggregates: {}",
+        aggregate.call->toString());
+  }
+
+  std::unordered_set<std::string> groupingKeyNames;
+  for (const auto& key : groupingKeys_) {
+    groupingKeyNames.insert(key->name());
+  }
+  VELOX_USER_CHECK_EQ(
+      groupingKeyNames.count(groupIdName),
+      0,
+      "GroupId {} must not be one of the grouping keys",
+      groupIdName);
+  for (const auto& groupingSet : groupingSets_) {
+    std::unordered_set<std::string> names;
+    for (const auto& name : groupingSet) {
+      VELOX_USER_CHECK_GT(
+          groupingKeyNames.count(name),
+          0,
+          "Grouping set key {} must be one of the grouping keys",
+          name);
+      VELOX_USER_CHECK(
+          names.insert(name).second,
+          "Duplicate key {} in a grouping set",
+          name);
+    }
+  }
+}
+
 namespace {
 void addFields(
     std::stringstream& stream,
@@ -248,8 +358,10 @@ bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
   }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
+  // A clustered aggregation bounds its memory by emitting groups early.
   return (isFinal() || isSingle()) && !groupingKeys().empty() &&
-      preGroupedKeys().empty() && queryConfig.aggregationSpillEnabled();
+      preGroupedKeys().empty() && groupingSets_.empty() && !clusteredInput_ &&
+      queryConfig.aggregationSpillEnabled();
 }
 
 void AggregationNode::addDetails(std::stringstream& stream) const {
@@ -259,6 +371,10 @@ void AggregationNode::addDetails(std::stringstream& stream) const {
     stream << "STREAMING ";
   }
 
+  if (clusteredInput_) {
+    stream << "CLUSTERED ";
+  }
+
   if (!groupingKeys_.empty()) {
     stream << "[";
     addFields(stream, groupingKeys_);
@@ -291,6 +407,15 @@ void AggregationNode::addDetails(std::stringstream& stream) const {
   if (groupId_.has_value()) {
     stream << " Group Id key: " << groupId_.value()->name();
   }
+
+  if (!groupingSets_.empty()) {
+    stream << " grouping sets: [";
+    for (auto i = 0; i < groupingSets_.size(); ++i) {
+      appendComma(i, stream);
+      stream << "[" << folly::join(", ", groupingSets_[i]) << "]";
+    }
+    stream << "]";
+  }
 }
 
 namespace {
@@ -348,7 +473,13 @@ folly::dynamic AggregationNode::serialize() const {
   if (groupId_.has_value()) {
     obj["groupId"] = ISerializable::serialize(groupId_.value());
   }
+  if (!groupingSets_.empty()) {
+    obj["groupingSets"] = ISerializable::serialize(groupingSets_);
+  }
   obj["ignoreNullKeys"] = ignoreNullKeys_;
+  if (clusteredInput_) {
+    obj["clusteredInput"] = true;
+  }
   return obj;
 }
 
@@ -448,6 +579,20 @@ PlanNodePtr AggregationNode::create(const folly::dynamic& obj, void* context) {
         obj["groupId"], context);
   }
 
+  if (obj.count("groupingSets")) {
+    VELOX_CHECK(groupId.has_value());
+    return std::make_shared<AggregationNode>(
+        deserializePlanNodeId(obj),
+        stepFromName(obj["step"].asString()),
+        groupingKeys,
+        ISerializable::deserialize<std::vector<std::vector<std::string>>>(
+            obj["groupingSets"]),
+        groupId.value()->name(),
+        aggregateNames,
+        aggregates,
+        deserializeSingleSource(obj, context));
+  }
+
   return std::make_shared<AggregationNode>(
       deserializePlanNodeId(obj),
       stepFromName(obj["step"].asString()),
@@ -458,6 +603,7 @@ PlanNodePtr AggregationNode::create(const folly::dynamic& obj, void* context) {
       globalGroupingSets,
       groupId,
       obj["ignoreNullKeys"].asBool(),
+      obj.count("clusteredInput") > 0 && obj["clusteredInput"].asBool(),
       deserializeSingleSource(obj, context));
 }
 
@@ -669,6 +669,52 @@ class AggregationNode : public PlanNode {
       bool ignoreNullKeys,
       PlanNodePtr source);
 
+  /// @param clusteredInput Declares that the input is clustered on the
+  /// grouping keys: all rows of a group arrive within a few consecutive input
+  /// batches, though not necessarily next to each other. A final or single
+  /// aggregation then emits and frees the groups that have not received input
+  /// for 'aggregation_clustered_input_eviction_batches' batches, which bounds
+  /// its memory. A group whose rows arrive further apart is produced more than
+  /// once.
+  AggregationNode(
+      const PlanNodeId& id,
+      Step step,
+      const std::vector<FieldAccessTypedExprPtr>& groupingKeys,
+      const std::vector<FieldAccessTypedExprPtr>& preGroupedKeys,
+      const std::vector<std::string>& aggregateNames,
+      const std::vector<Aggregate>& aggregates,
+      const std::vector<vector_size_t>& globalGroupingSets,
+      const std::optional<FieldAccessTypedExprPtr>& groupId,
+      bool ignoreNullKeys,
+      bool clusteredInput,
+      PlanNodePtr source);
+
+  /// Computes several grouping sets with the same result as a GroupId node
+  /// followed by an aggregation over the grouping keys and the group ID, but
+  /// without replicating the input once per grouping set. The input is
+  /// aggregated over all grouping keys once. Each coarser grouping set is then
+  /// derived by aggregating the intermediate results of the smallest finer
+  /// set that contains it, e.g. ROLLUP(a, b, c) aggregates (a, b) from
+  /// (a, b, c), (a) from (a, b) and () from (a). Requires that all aggregates
+  /// can merge intermediate results, i.e. none is distinct or sorted.
+  ///
+  /// The output has the grouping keys, then a BIGINT column named
+  /// 'groupIdName' with the zero based index of the grouping set, then the
+  /// aggregates. The grouping keys that are not in a grouping set are null in
+  /// its rows.
+  ///
+  /// @param groupingSets A list of grouping sets. Each grouping set is a list
+  /// of names of 'groupingKeys'.
+  AggregationNode(
+      const PlanNodeId& id,
+      Step step,
+      const std::vector<FieldAccessTypedExprPtr>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::string& groupIdName,
+      const std::vector<std::string>& aggregateNames,
+      const std::vector<Aggregate>& aggregates,
+      PlanNodePtr source);
+
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
   }
@@ -722,6 +768,19 @@ class AggregationNode : public PlanNode {
     return groupId_;
   }
 
+  /// True if the input is clustered on the grouping keys. See the
+  /// constructor.
+  bool clusteredInput() const {
+    return clusteredInput_;
+  }
+
+  /// Grouping sets computed by this aggregation itself. Empty unless created
+  /// with the constructor that takes grouping sets. In that case 'groupId'
+  /// is the output column with the grouping set index.
+  const std::vector<std::vector<std::string>>& groupingSets() const {
+    return groupingSets_;
+  }
+
   std::string_view name() const override {
     return "Aggregation";
   }
@@ -749,9 +808,11 @@ class AggregationNode : public PlanNode {
   const std::vector<std::string> aggregateNames_;
   const std::vector<Aggregate> aggregates_;
   const bool ignoreNullKeys_;
+  const bool clusteredInput_{false};
 
   std::optional<FieldAccessTypedExprPtr> groupId_;
   std::vector<vector_size_t> globalGroupingSets_;
+  std::vector<std::vector<std::string>> groupingSets_;
 
   const std::vector<PlanNodePtr> sources_;
   const RowTypePtr outputType_;
@@ -108,6 +108,13 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, the exchange client adapts the bytes it keeps queued or in
+  /// flight to the rate at which consumers drain the queue, up to
+  /// kMaxExchangeBufferSize, and sizes each request by the transfer rate of
+  /// its source. Otherwise the client fills kMaxExchangeBufferSize.
+  static constexpr const char* kExchangeAdaptiveFlowControl =
+      "exchange.adaptive_flow_control";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
@@ -134,6 +141,31 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Final or single aggregations that may spill switch from hashing to
+  /// sorting the input into spill runs once the number of groups reaches this
+  /// percentage of the number of input rows. The runs are aggregated while
+  /// merging them. 0 disables the switch.
+  static constexpr const char* kAggregationSortFallbackMinPct =
+      "aggregation_sort_fallback_min_pct";
+
+  /// The minimum number of input rows of an aggregation before considering
+  /// the switch to sorting. See kAggregationSortFallbackMinPct.
+  static constexpr const char* kAggregationSortFallbackMinRows =
+      "aggregation_sort_fallback_min_rows";
+
+  /// Aggregations over distinct inputs de-duplicate the inputs of all groups
+  /// in one hash table instead of a set per group if the first batch of input
+  /// has at least this percentage of distinct grouping keys. 0 disables the
+  /// shared table.
+  static constexpr const char* kDistinctAggregationSharedTableMinPct =
+      "distinct_aggregation_shared_table_min_pct";
+
+  /// An aggregation over input declared clustered on the grouping keys emits
+  /// and frees the groups that have not received input for this many input
+  /// batches. See AggregationNode::clusteredInput().
+  static constexpr const char* kAggregationClusteredInputEvictionBatches =
+      "aggregation_clustered_input_eviction_batches";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -149,6 +181,21 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// The minimum number of destinations for PartitionedOutput to serialize
+  /// in scatter mode. In this mode the rows of an input batch are sorted by
+  /// destination once and each column is serialized for all destinations in
+  /// one pass, instead of serializing all columns for one destination at a
+  /// time. 0 disables the scatter mode.
+  static constexpr const char* kPartitionedOutputScatterMinDestinations =
+      "partitioned_output_scatter_min_destinations";
+
+  /// If true, PartitionedOutput enqueues pages that carry the output vectors
+  /// as is instead of serialized data. Such pages can only be consumed in the
+  /// same process, e.g. by the tasks of a LocalRunner, whose exchange sources
+  /// and Exchange operators take the vectors without deserializing them.
+  static constexpr const char* kInProcessExchangeEnabled =
+      "in_process_exchange_enabled";
+
   /// The maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -266,6 +313,19 @@ class QueryConfig {
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// The number of buffers of spill_read_buffer_size bytes to read ahead from
+  /// each spill file while unspilling. The reads ahead are issued on the spill
+  /// executor if the underlying filesystem doesn't support async read. The
+  /// buffers are allocated from the memory pool of the unspilling operator. 0
+  /// disables the read-ahead on the spill executor.
+  static constexpr const char* kSpillReadAheadBuffers =
+      "spill_read_ahead_buffers";
+
+  /// If true, spill files on the local file system are written through
+  /// io_uring. This has effect only if Velox is built with io_uring support
+  /// and the kernel allows it. Otherwise spill files use blocking writes.
+  static constexpr const char* kSpillIoUringEnabled = "spill_io_uring_enabled";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -351,6 +411,42 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If true, a parallel hash join table build splits the table into
+  /// partitions that fit in the CPU cache and scatters the build rows into
+  /// these by hash bits before inserting, instead of using one partition per
+  /// build thread.
+  static constexpr const char* kHashJoinRadixPartitionedBuildEnabled =
+      "hash_join_radix_partitioned_build_enabled";
+
+  /// The maximum number of threads an OrderBy uses to sort its rows once all
+  /// input is in. The rows are split into ranges that are sorted in parallel
+  /// on the driver executor and then merged. 1 sorts on the driver thread.
+  static constexpr const char* kOrderBySortParallelism =
+      "order_by_sort_parallelism";
+
+  /// If true, aggregate window functions that are not order sensitive
+  /// evaluate wide sliding frames from a segment tree of partial aggregates
+  /// over the partition, instead of aggregating every frame from its rows.
+  /// Off by default since floating-point results may differ in the last bits
+  /// because the values are added in a different order.
+  static constexpr const char* kWindowSegmentTreeEnabled =
+      "window_segment_tree_enabled";
+
+  /// If true, TopN and TopNRowNumber without partitioning keys push the value
+  /// of the leading sorting key of their last top row into the upstream table
+  /// scan as a dynamic filter, once they hold the requested number of rows.
+  /// Off by default until the filter has been tried on production workloads.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// The maximum size in bytes of the bloom filters that a hash join build
+  /// creates over its join keys for pushdown into the probe side table scan.
+  /// Bloom filters are only created when the hash table uses kHash mode, i.e.
+  /// when the build keys cannot be pushed down as value ranges or value sets.
+  /// 0 disables the bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -398,6 +494,12 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// If true, prefix-sort sorts the normalized keys with a most significant
+  /// byte first radix sort, falling back to quick sort for small partitions,
+  /// instead of quick sort.
+  static constexpr const char* kPrefixSortRadixSortEnabled =
+      "prefixsort_radix_sort_enabled";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -554,6 +656,22 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t aggregationSortFallbackMinPct() const {
+    return get<int32_t>(kAggregationSortFallbackMinPct, 0);
+  }
+
+  int32_t aggregationSortFallbackMinRows() const {
+    return get<int32_t>(kAggregationSortFallbackMinRows, 100'000);
+  }
+
+  int32_t distinctAggregationSharedTableMinPct() const {
+    return get<int32_t>(kDistinctAggregationSharedTableMinPct, 0);
+  }
+
+  int32_t aggregationClusteredInputEvictionBatches() const {
+    return get<int32_t>(kAggregationClusteredInputEvictionBatches, 4);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -577,6 +695,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  uint32_t partitionedOutputScatterMinDestinations() const {
+    return get<uint32_t>(kPartitionedOutputScatterMinDestinations, 64);
+  }
+
+  bool inProcessExchangeEnabled() const {
+    return get<bool>(kInProcessExchangeEnabled, false);
+  }
+
   uint64_t maxOutputBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
@@ -603,6 +729,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool exchangeAdaptiveFlowControl() const {
+    return get<bool>(kExchangeAdaptiveFlowControl, false);
+  }
+
   uint64_t minExchangeOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 2UL << 20;
     return get<uint64_t>(kMinExchangeOutputBatchBytes, kDefault);
@@ -751,6 +881,14 @@ class QueryConfig {
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  uint32_t spillReadAheadBuffers() const {
+    return get<uint32_t>(kSpillReadAheadBuffers, 0);
+  }
+
+  bool spillIoUringEnabled() const {
+    return get<bool>(kSpillIoUringEnabled, false);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -856,6 +994,26 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  bool hashJoinRadixPartitionedBuildEnabled() const {
+    return get<bool>(kHashJoinRadixPartitionedBuildEnabled, false);
+  }
+
+  uint32_t orderBySortParallelism() const {
+    return get<uint32_t>(kOrderBySortParallelism, 1);
+  }
+
+  bool windowSegmentTreeEnabled() const {
+    return get<bool>(kWindowSegmentTreeEnabled, false);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, false);
+  }
+
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -900,6 +1058,10 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  bool prefixSortRadixSortEnabled() const {
+    return get<bool>(kPrefixSortRadixSortEnabled, false);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
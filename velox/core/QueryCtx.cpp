@@ -30,7 +30,8 @@ std::shared_ptr<QueryCtx> QueryCtx::create(
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     folly::Executor* spillExecutor,
-    const std::string& queryId) {
+    const std::string& queryId,
+    std::vector<folly::Executor*> numaExecutors) {
   std::shared_ptr<QueryCtx> queryCtx(new QueryCtx(
       executor,
       std::move(queryConfig),
@@ -38,7 +39,8 @@ std::shared_ptr<QueryCtx> QueryCtx::create(
       cache,
       std::move(pool),
       spillExecutor,
-      queryId));
+      queryId,
+      std::move(numaExecutors)));
   queryCtx->maybeSetReclaimer();
   return queryCtx;
 }
@@ -51,15 +53,20 @@ QueryCtx::QueryCtx(
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     folly::Executor* spillExecutor,
-    const std::string& queryId)
+    const std::string& queryId,
+    std::vector<folly::Executor*> numaExecutors)
     : queryId_(queryId),
       executor_(executor),
       spillExecutor_(spillExecutor),
+      numaExecutors_(std::move(numaExecutors)),
       cache_(cache),
       connectorSessionProperties_(connectorSessionProperties),
       pool_(std::move(pool)),
       queryConfig_{std::move(queryConfig)} {
   initPool(queryId);
+  for (const auto* numaExecutor : numaExecutors_) {
+    VELOX_CHECK_NOT_NULL(numaExecutor);
+  }
 }
 
 /*static*/ std::string QueryCtx::generatePoolName(const std::string& queryId) {
@@ -43,6 +43,11 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// mode, executor is not needed. Hence, we don't require executor to always
   /// be passed in here, but instead, ensure that executor exists when actually
   /// being used.
+  ///
+  /// If 'numaExecutors' is not empty, element n is an executor whose threads
+  /// run on NUMA node n, e.g. from a thread factory that calls
+  /// process::pinThreadToNumaNode(). Each Task of the query then gets a node
+  /// and runs its drivers on the executor of that node.
   static std::shared_ptr<QueryCtx> create(
       folly::Executor* executor = nullptr,
       QueryConfig&& queryConfig = QueryConfig{{}},
@@ -51,7 +56,8 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       folly::Executor* spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      std::vector<folly::Executor*> numaExecutors = {});
 
   static std::string generatePoolName(const std::string& queryId);
 
@@ -71,6 +77,29 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     return executor_ != nullptr;
   }
 
+  /// Returns the number of NUMA node local executors. 0 if drivers are not
+  /// placed by NUMA node.
+  int32_t numNumaExecutors() const {
+    return numaExecutors_.size();
+  }
+
+  /// Returns the executor for the drivers of a Task on NUMA node 'node'.
+  folly::Executor* numaExecutor(int32_t node) const {
+    VELOX_CHECK_GE(node, 0);
+    VELOX_CHECK_LT(node, numNumaExecutors());
+    return numaExecutors_[node];
+  }
+
+  /// Returns the NUMA node for a new Task of this query. The nodes are
+  /// assigned round robin. Returns -1 if there are no NUMA node local
+  /// executors.
+  int32_t nextNumaNode() {
+    if (numaExecutors_.empty()) {
+      return -1;
+    }
+    return nextNumaNode_++ % numaExecutors_.size();
+  }
+
   const QueryConfig& queryConfig() const {
     return queryConfig_;
   }
@@ -153,7 +182,8 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       folly::Executor* spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      std::vector<folly::Executor*> numaExecutors = {});
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
@@ -214,6 +244,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   const std::string queryId_;
   folly::Executor* const executor_{nullptr};
   folly::Executor* const spillExecutor_{nullptr};
+  const std::vector<folly::Executor*> numaExecutors_;
   cache::AsyncDataCache* const cache_;
 
   std::unordered_map<std::string, std::shared_ptr<config::ConfigBase>>
@@ -222,6 +253,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
   std::atomic<uint64_t> numTracedBytes_{0};
+  std::atomic<uint32_t> nextNumaNode_{0};
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
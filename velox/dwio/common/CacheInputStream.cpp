@@ -211,6 +211,9 @@ void CacheInputStream::loadSync(const Region& region) {
   // the individual parts are hit.
   ioStats_->incRawBytesRead(hitSize);
   prefetchStarted_ = false;
+  if (!accessRecorded_) {
+    recordAccess(region);
+  }
   do {
     folly::SemiFuture<bool> cacheLoadWait(false);
     cache::RawFileCacheKey key{fileNum_, region.offset};
@@ -258,6 +261,20 @@ void CacheInputStream::loadSync(const Region& region) {
   } while (pin_.empty());
 }
 
+void CacheInputStream::recordAccess(const velox::common::Region& region) {
+  auto* ssdCache = cache_->ssdCache();
+  if (ssdCache == nullptr || ssdCache->admissionController() == nullptr) {
+    return;
+  }
+  cache::TrackingData trackingData;
+  if (tracker_ != nullptr && !trackingId_.empty()) {
+    trackingData = tracker_->trackingData(trackingId_);
+  }
+  ssdCache->admissionController()->recordAccess(
+      cache::RawFileCacheKey{fileNum_, region.offset},
+      CachedBufferedInput::accessReadPct(trackingData));
+}
+
 void CacheInputStream::clearCachePin() {
   if (pin_.empty()) {
     return;
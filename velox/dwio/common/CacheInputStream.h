@@ -78,6 +78,7 @@ class CacheInputStream : public SeekableInputStream {
         groupId_,
         loadQuantum_);
     copy->position_ = position_;
+    copy->accessRecorded_ = accessRecorded_;
     return copy;
   }
 
@@ -98,6 +99,13 @@ class CacheInputStream : public SeekableInputStream {
     prefetchPct_ = pct;
   }
 
+  /// Notes that the accesses to 'region_' are recorded for SSD cache admission
+  /// by CachedBufferedInput::load(). Otherwise the loads of 'this' record
+  /// them.
+  void setAccessRecorded() {
+    accessRecorded_ = true;
+  }
+
   bool testingNoCacheRetention() const {
     return noCacheRetention_;
   }
@@ -113,6 +121,10 @@ class CacheInputStream : public SeekableInputStream {
   // Synchronously sets 'pin_' to cover 'region'.
   void loadSync(const velox::common::Region& region);
 
+  // Records an access to 'region' with the SSD cache admission controller, if
+  // any.
+  void recordAccess(const velox::common::Region& region);
+
   // Returns true if there is an SSD cache and 'entry' is present there and
   // successfully loaded.
   bool loadFromSsd(
@@ -178,6 +190,10 @@ class CacheInputStream : public SeekableInputStream {
   // True if prefetch the next 'loadQuantum_' has been started. Cleared when
   // moving to the next load quantum.
   bool prefetchStarted_{false};
+
+  // True if the accesses to 'region_' are recorded for SSD cache admission
+  // outside of the loads of 'this'.
+  bool accessRecorded_{false};
 };
 
 } // namespace facebook::velox::dwio::common
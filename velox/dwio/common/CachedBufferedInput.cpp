@@ -145,9 +145,11 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
   // 'requests_ is cleared on exit.
   auto requests = std::move(requests_);
   cache::SsdFile* ssdFile{nullptr};
+  cache::SsdAdmissionController* admissionController{nullptr};
   auto* ssdCache = cache_->ssdCache();
   if (ssdCache != nullptr) {
     ssdFile = &ssdCache->file(fileNum_);
+    admissionController = ssdCache->admissionController();
   }
 
   // Extra requests made for pre-loadable regions that are larger than
@@ -167,7 +169,17 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
                                                                          : 0;
     auto parts = makeRequestParts(
         request, trackingData, options_.loadQuantum(), extraRequests);
+    const auto readPct = accessReadPct(trackingData);
+    if (admissionController != nullptr) {
+      // The stream does not record the accesses again when it loads 'parts'.
+      request.stream->setAccessRecorded();
+    }
     for (auto part : parts) {
+      if (admissionController != nullptr) {
+        // Hits in memory count as accesses too, so that entries that are
+        // reused while in memory qualify for SSD when they are saved.
+        admissionController->recordAccess(part->key, readPct);
+      }
       if (cache_->exists(part->key)) {
         continue;
       }
@@ -49,7 +49,7 @@ struct CacheRequest {
   /// accessed large columns where hitting one piece should not load the
   /// adjacent pieces.
   bool coalesces{true};
-  const SeekableInputStream* stream;
+  CacheInputStream* stream;
 };
 
 class CachedBufferedInput : public BufferedInput {
@@ -168,6 +168,15 @@ class CachedBufferedInput : public BufferedInput {
     VELOX_NYI();
   }
 
+  /// Returns the read percentage that goes with an access to the SSD cache
+  /// admission controller for a stream with 'trackingData'. The percentage is
+  /// unknown, hence 100, before the stream has been read once.
+  static int32_t accessReadPct(const cache::TrackingData& trackingData) {
+    return trackingData.referencedBytes == trackingData.lastReferencedBytes
+        ? 100
+        : adjustedReadPct(trackingData);
+  }
+
  private:
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
   // is true, starts background loading.
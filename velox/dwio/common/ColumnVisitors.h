@@ -1562,6 +1562,10 @@ class StringColumnReadWithVisitorHelper {
         readHelper<velox::common::NegatedBytesValues, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
         break;
+      case velox::common::FilterKind::kBloomFilter:
+        readHelper<velox::common::BloomFilterValues, kIsDense>(
+            filter, extractValues, std::forward<F>(readWithVisitor));
+        break;
       default:
         readHelper<velox::common::Filter, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
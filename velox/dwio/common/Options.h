@@ -497,6 +497,12 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Enables or disables skipping Parquet pages by their ColumnIndex.
+  ReaderOptions& setParquetPageIndexFilterEnabled(bool flag) {
+    parquetPageIndexFilterEnabled_ = flag;
+    return *this;
+  }
+
   ReaderOptions& setIOExecutor(std::shared_ptr<folly::Executor> executor) {
     ioExecutor_ = std::move(executor);
     return *this;
@@ -567,6 +573,10 @@ class ReaderOptions : public io::ReaderOptions {
     return useColumnNamesForColumnMapping_;
   }
 
+  bool parquetPageIndexFilterEnabled() const {
+    return parquetPageIndexFilterEnabled_;
+  }
+
   const std::shared_ptr<random::RandomSkipTracker>& randomSkip() const {
     return randomSkip_;
   }
@@ -609,6 +619,7 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
+  bool parquetPageIndexFilterEnabled_{true};
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
@@ -639,6 +650,15 @@ struct WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
 
+  /// Optional executor to encode and compress the columns of a stripe or row
+  /// group in parallel. Up to 'encodingParallelismFactor' threads, including
+  /// the calling thread, write disjoint sets of columns. The file written is
+  /// the same with or without the executor. The executor should not be one
+  /// that runs the tasks calling the writer, or writers may deadlock waiting
+  /// for each other.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
+
   // WriterOption implementations can implement this function to specify how to
   // process format-specific session and connector configs.
   virtual void processConfigs(
@@ -429,7 +429,15 @@ std::string ScanSpec::toString() const {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (!filter_) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == FilterKind::kBloomFilter) {
+    // Other filters do not merge with a bloom filter, the bloom filter merges
+    // with any filter.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
@@ -548,6 +548,14 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of strides (row groups) skipped based on bloom filters. These are
+  // also counted in 'skippedStrides'.
+  int64_t bloomFilterSkippedStrides{0};
+
+  // Number of rows inside read row groups skipped based on page level
+  // statistics.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -567,6 +575,14 @@ struct RuntimeStatistics {
     if (skippedStrides > 0) {
       result.emplace("skippedStrides", RuntimeCounter(skippedStrides));
     }
+    if (bloomFilterSkippedStrides > 0) {
+      result.emplace(
+          "bloomFilterSkippedStrides",
+          RuntimeCounter(bloomFilterSkippedStrides));
+    }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
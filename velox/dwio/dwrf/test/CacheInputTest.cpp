@@ -41,6 +41,37 @@ using facebook::velox::common::Region;
 using memory::MemoryAllocator;
 using IoStatisticsPtr = std::shared_ptr<IoStatistics>;
 
+namespace {
+// Admits all entries and counts the accesses recorded for each offset.
+class CountingAdmissionController : public SsdAdmissionController {
+ public:
+  void recordAccess(const RawFileCacheKey& key, int32_t /*readPct*/)
+      override {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numAccesses_[key.offset];
+  }
+
+  bool shouldAdmit(const RawFileCacheKey& /*key*/, int32_t /*size*/)
+      override {
+    return true;
+  }
+
+  std::string toString() const override {
+    return "CountingAdmissionController";
+  }
+
+  int32_t numAccesses(uint64_t offset) {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto it = numAccesses_.find(offset);
+    return it == numAccesses_.end() ? 0 : it->second;
+  }
+
+ private:
+  std::mutex mutex_;
+  folly::F14FastMap<uint64_t, int32_t> numAccesses_;
+};
+} // namespace
+
 class CacheTest : public ::testing::Test {
  protected:
   static constexpr int32_t kMaxStreams = 50;
@@ -86,7 +117,8 @@ class CacheTest : public ::testing::Test {
   void initializeCache(
       uint64_t maxBytes,
       uint64_t ssdBytes = 0,
-      bool checksumEnabled = false) {
+      bool checksumEnabled = false,
+      std::shared_ptr<SsdAdmissionController> admissionController = nullptr) {
     shutdownCache();
 
     if (executor_ == nullptr) {
@@ -105,7 +137,10 @@ class CacheTest : public ::testing::Test {
           0,
           false,
           checksumEnabled,
-          checksumEnabled);
+          checksumEnabled,
+          false,
+          facebook::velox::common::CompressionKind_NONE,
+          std::move(admissionController));
       ssd = std::make_unique<SsdCache>(config);
       ssdCacheHelper_ = std::make_unique<test::SsdCacheTestHelper>(ssd.get());
       groupStats_ = &ssd->groupStats();
@@ -875,6 +910,50 @@ TEST_F(CacheTest, loadQuotumTooLarge) {
       "Load quantum exceeded SSD cache entry size limit");
 }
 
+TEST_F(CacheTest, ssdAdmissionAccesses) {
+  constexpr int64_t kLoadQuantum = io::ReaderOptions::kDefaultLoadQuantum;
+  auto admissionController = std::make_shared<CountingAdmissionController>();
+  initializeCache(64 << 20, 256 << 20, false, admissionController);
+
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("test_file", fileId, groupId);
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      nullptr,
+      groupId,
+      ioStats_,
+      executor_.get(),
+      io::ReaderOptions(pool_.get()));
+
+  const auto readAll = [](SeekableInputStream& stream, int64_t numBytes) {
+    const void* buffer;
+    int32_t size;
+    int64_t bytes = 0;
+    while (bytes < numBytes) {
+      ASSERT_TRUE(stream.Next(&buffer, &size));
+      bytes += size;
+    }
+  };
+
+  // A stream that is not loaded by CachedBufferedInput::load() records an
+  // access for each load quantum it loads on demand.
+  auto stream = input->read(0, 2 * kLoadQuantum, LogType::TEST);
+  readAll(*stream, 2 * kLoadQuantum);
+  ASSERT_EQ(admissionController->numAccesses(0), 1);
+  ASSERT_EQ(admissionController->numAccesses(kLoadQuantum), 1);
+
+  // The access to an enqueued stream is recorded once by load().
+  constexpr uint64_t kOffset = 4 * kLoadQuantum;
+  auto enqueued = input->enqueue(Region{kOffset, 1'000}, nullptr);
+  input->load(LogType::TEST);
+  readAll(*enqueued, 1'000);
+  ASSERT_EQ(admissionController->numAccesses(kOffset), 1);
+}
+
 TEST_F(CacheTest, ssdReadVerification) {
   constexpr int64_t kMemoryBytes = 32 << 20;
   constexpr int64_t kSsdBytes = 256 << 20;
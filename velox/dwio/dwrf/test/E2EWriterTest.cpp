@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1634,6 +1635,74 @@ TEST_F(E2EWriterTest, fuzzFlatmap) {
   }
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  auto type = ROW({
+      {"bool_val", BOOLEAN()},
+      {"short_val", SMALLINT()},
+      {"int_val", INTEGER()},
+      {"long_val", BIGINT()},
+      {"double_val", DOUBLE()},
+      {"string_val", VARCHAR()},
+      {"ts_val", TIMESTAMP()},
+      {"array", ARRAY(REAL())},
+      {"map", MAP(INTEGER(), VARCHAR())},
+      {"row", ROW({{"a", BIGINT()}, {"b", VARCHAR()}})},
+  });
+  const auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1'000,
+          .nullRatio = 0.1,
+          .stringLength = 20,
+          .stringVariableLength = true,
+      },
+      leafPool_.get(),
+      seed);
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 20; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  // Writes 'batches' in several compressed stripes and returns the file.
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::COMPRESSION, common::CompressionKind_ZSTD);
+    config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1 << 10);
+    config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1 << 17);
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = executor;
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto expected = writeFile(nullptr);
+  const auto actual =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  // The columns written in parallel produce the same file.
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_TRUE(expected == actual);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  dwrf::DwrfReader reader(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(actual), leafPool_.get()));
+  ASSERT_GT(reader.getNumberOfStripes(), 1);
+}
+
 TEST_F(E2EWriterTest, memoryConfigError) {
   const auto type = ROW(
       {{"int_val", INTEGER()},
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,11 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // Columns written in parallel can not share the selectivity vector.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.parallelWrite()
+      ? localSelected.emplace(slice->size())
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -1622,11 +1627,29 @@ class StructColumnWriter : public BaseColumnWriter {
     }
   }
 
+  // Writes the children of the root in parallel on the encoding executor of
+  // 'context_'. Flat map writers add streams to 'context_' while writing, so
+  // there is no parallelism with flat maps. The children are flushed
+  // serially, as the encodings are added to the stripe footer in order.
+  void initParallelWrite() {
+    VELOX_CHECK(isRoot());
+    if (!context_.parallelWrite() || getConfig(Config::FLATTEN_MAP)) {
+      return;
+    }
+    parallelForOnChildren_ = std::make_unique<dwio::common::ParallelFor>(
+        context_.encodingExecutor(),
+        0,
+        children_.size(),
+        context_.encodingParallelismFactor());
+  }
+
  private:
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  std::unique_ptr<dwio::common::ParallelFor> parallelForOnChildren_;
 };
 
 uint64_t StructColumnWriter::writeChildrenAndStats(
@@ -1634,7 +1657,20 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && parallelForOnChildren_ != nullptr) {
+    // Lazy children are loaded in the calling thread.
+    std::vector<VectorPtr> children(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      children[i] = BaseVector::loadedVectorShared(rowSlice->childAt(i));
+    }
+    std::vector<uint64_t> rawSizes(children_.size());
+    parallelForOnChildren_->execute([&](size_t i) {
+      rawSizes[i] = children_[i]->write(children[i], ranges);
+    });
+    for (auto childRawSize : rawSizes) {
+      rawSize += childRawSize;
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
@@ -2061,6 +2097,9 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
       for (int32_t i = 0; i < type.size(); ++i) {
         ret->children_.push_back(create(context, *type.childAt(i), sequence));
       }
+      if (ret->isRoot()) {
+        ret->initParallelWrite();
+      }
       return ret;
     }
     case TypeKind::MAP: {
@@ -181,6 +181,8 @@ Writer::Writer(
       context.getTotalMemoryUsage(),
       0,
       "Unexpected memory usage on dwrf writer construction");
+  context.setEncodingExecutor(
+      options.encodingExecutor, options.encodingParallelismFactor);
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
 
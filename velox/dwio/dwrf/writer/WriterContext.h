@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -256,18 +258,36 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. If columns are written in parallel,
+  /// each concurrent compression gets a buffer of its own, allocated from the
+  /// general memory pool on first use and reused after.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
-      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
-    VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override;
+
+  /// Sets the executor for writing the top level columns in parallel. Must be
+  /// called before the column writers are created.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
+  /// True if more than one column may be written at a time. The state that
+  /// column writers share through 'this' is then synchronized.
+  bool parallelWrite() const {
+    return encodingExecutor_ != nullptr && encodingParallelismFactor_ > 1;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -609,6 +629,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -618,6 +639,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -640,6 +662,11 @@ class WriterContext : public CompressionBufferPool {
   const dwio::common::MetricsLogPtr metricLogger_;
   const tz::TimeZone* sessionTimezone_;
   const bool adjustTimestampToTimezone_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
+  // Serializes the use of the compression buffers and 'decodedVectorPool_'
+  // by columns written in parallel.
+  std::mutex mutex_;
 
   // Map needs referential stability because reference to map value is stored by
   // another class.
@@ -659,6 +686,10 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers beyond 'compressionBuffer_' for columns written in
+  // parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilterPushdown.h"
+
+#include "velox/dwio/parquet/reader/ReadRegion.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Maximum number of values of an IN filter that are looked up in a bloom
+// filter. Larger lists are unlikely to rule out a row group.
+constexpr size_t kMaxBloomFilterValues = 1'000;
+
+// Number of bytes read speculatively to get the bloom filter header. The
+// header is usually much smaller.
+constexpr int64_t kBloomFilterHeaderSizeGuess = 256;
+
+bool isIntegerType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool containsInt64(
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    int64_t value) {
+  if (physicalType == thrift::Type::INT64) {
+    return bloomFilter.findHash(bloomFilter.hash(value));
+  }
+  if (value < std::numeric_limits<int32_t>::min() ||
+      value > std::numeric_limits<int32_t>::max()) {
+    // An INT32 column can not contain values outside of the int32 range.
+    return false;
+  }
+  return bloomFilter.findHash(bloomFilter.hash(static_cast<int32_t>(value)));
+}
+
+bool containsBytes(const BloomFilter& bloomFilter, std::string_view value) {
+  ByteArray byteArray(value);
+  return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+}
+} // namespace
+
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    const TypePtr& type,
+    thrift::Type::type physicalType) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (physicalType) {
+    case thrift::Type::INT32:
+      // Unsigned 32 bit integers are stored as INT32 and read as BIGINT. Their
+      // filter values do not match the stored bit pattern.
+      if (!isIntegerType(type) || type->kind() == TypeKind::BIGINT) {
+        return false;
+      }
+      break;
+    case thrift::Type::INT64:
+      if (type->kind() != TypeKind::BIGINT) {
+        return false;
+      }
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      if (type->kind() != TypeKind::VARCHAR &&
+          type->kind() != TypeKind::VARBINARY) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  const bool isBytes = physicalType == thrift::Type::BYTE_ARRAY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return !isBytes &&
+          static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return !isBytes && values.size() <= kMaxBloomFilterValues;
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return !isBytes;
+    case common::FilterKind::kBytesRange:
+      return isBytes &&
+          static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesValues:
+      return isBytes &&
+          static_cast<const common::BytesValues&>(filter).values().size() <=
+          kMaxBloomFilterValues;
+    default:
+      return false;
+  }
+}
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  auto containsAny = [&](const auto& values) {
+    for (auto value : values) {
+      if (containsInt64(bloomFilter, physicalType, value)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return containsInt64(
+          bloomFilter,
+          physicalType,
+          static_cast<const common::BigintRange&>(filter).lower());
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return containsAny(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values());
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values();
+      return values.size() > kMaxBloomFilterValues || containsAny(values);
+    }
+    case common::FilterKind::kBytesRange:
+      return containsBytes(
+          bloomFilter, static_cast<const common::BytesRange&>(filter).lower());
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (containsBytes(bloomFilter, value)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      VELOX_UNREACHABLE(
+          "Filter can not be tested with a bloom filter: {}",
+          filter.toString());
+  }
+}
+
+std::unique_ptr<BlockSplitBloomFilter> readBloomFilter(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    memory::MemoryPool& pool) {
+  const int64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset past end of file");
+  auto data = readRegion(
+      input, offset, std::min(kBloomFilterHeaderSizeGuess, fileSize - offset));
+
+  // Find the size of the header to know the total size of the bloom filter.
+  thrift::BloomFilterHeader header;
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(
+          data.data(), data.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  const int64_t headerSize = header.read(&protocol);
+  VELOX_CHECK_GT(header.numBytes, 0, "Invalid bloom filter size");
+  const int64_t totalSize = headerSize + header.numBytes;
+  VELOX_CHECK_LE(offset + totalSize, fileSize, "Bloom filter past end of file");
+  if (totalSize > static_cast<int64_t>(data.size())) {
+    data = readRegion(input, offset, totalSize);
+  }
+
+  dwio::common::SeekableArrayInputStream stream(data.data(), totalSize);
+  return std::make_unique<BlockSplitBloomFilter>(
+      BlockSplitBloomFilter::deserialize(&stream, pool));
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Returns true if 'filter' passes a small set of discrete values that can be
+/// looked up in a bloom filter of a column of 'type' stored as
+/// 'physicalType'. Filters that pass nulls are not eligible since bloom
+/// filters only cover non-null values.
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    const TypePtr& type,
+    thrift::Type::type physicalType);
+
+/// Returns false if none of the values passing 'filter' is in 'bloomFilter'.
+/// The values are hashed using the plain encoding of 'physicalType'.
+/// canUseBloomFilter() must be true for 'filter'.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType);
+
+/// Reads the bloom filter that starts at 'offset' in 'input'.
+std::unique_ptr<BlockSplitBloomFilter> readBloomFilter(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    memory::MemoryPool& pool);
+
+} // namespace facebook::velox::parquet
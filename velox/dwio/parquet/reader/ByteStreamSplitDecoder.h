@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+template <int32_t kBytes>
+using ByteStreamSplitWord = std::conditional_t<
+    kBytes == 1,
+    uint8_t,
+    std::conditional_t<kBytes == 2, uint16_t, uint32_t>>;
+
+// Interleaves the elements of 'kGroup' bytes of adjacent groups of
+// 'kGroup' batches in 'in' into groups of 2 * 'kGroup' batches in 'out'.
+// Byte k of the batches in a group is byte k of consecutive values, so
+// after log2('kWidth') steps 'out' holds 'kWidth' batches of whole values
+// in order.
+template <int32_t kWidth, int32_t kGroup>
+FOLLY_ALWAYS_INLINE void zipStreams(
+    const xsimd::batch<uint8_t>* in,
+    xsimd::batch<uint8_t>* out) {
+  using T = ByteStreamSplitWord<kGroup>;
+  for (auto first = 0; first < kWidth; first += 2 * kGroup) {
+    for (auto i = 0; i < kGroup; ++i) {
+      auto left = simd::reinterpretBatch<T>(in[first + i]);
+      auto right = simd::reinterpretBatch<T>(in[first + kGroup + i]);
+      out[first + 2 * i] =
+          simd::reinterpretBatch<uint8_t>(xsimd::zip_lo(left, right));
+      out[first + 2 * i + 1] =
+          simd::reinterpretBatch<uint8_t>(xsimd::zip_hi(left, right));
+    }
+  }
+}
+
+// Decodes values of 'kWidth' bytes, a batch of values per stream at a time.
+// Returns the number of values decoded.
+template <int32_t kWidth>
+int32_t decodeByteStreamSplitSimd(
+    const char* data,
+    int32_t numValues,
+    char* output) {
+  constexpr int32_t kBatchSize = xsimd::batch<uint8_t>::size;
+  static_assert(kWidth == 4 || kWidth == 8);
+  xsimd::batch<uint8_t> first[kWidth];
+  xsimd::batch<uint8_t> second[kWidth];
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    for (auto stream = 0; stream < kWidth; ++stream) {
+      first[stream] = xsimd::batch<uint8_t>::load_unaligned(
+          reinterpret_cast<const uint8_t*>(data) + stream * numValues + i);
+    }
+    zipStreams<kWidth, 1>(first, second);
+    zipStreams<kWidth, 2>(second, first);
+    if constexpr (kWidth == 8) {
+      zipStreams<kWidth, 4>(first, second);
+      for (auto j = 0; j < kWidth; ++j) {
+        second[j].store_unaligned(reinterpret_cast<uint8_t*>(
+            output + (i * kWidth) + j * kBatchSize));
+      }
+    } else {
+      for (auto j = 0; j < kWidth; ++j) {
+        first[j].store_unaligned(reinterpret_cast<uint8_t*>(
+            output + (i * kWidth) + j * kBatchSize));
+      }
+    }
+  }
+  return i;
+}
+
+} // namespace detail
+
+/// Decodes 'numValues' values of 'width' bytes from the BYTE_STREAM_SPLIT
+/// encoded 'data' into the PLAIN layout in 'output'. Byte k of the values
+/// is stored in the k-th of 'width' streams of 'numValues' bytes, so that
+/// the bytes of the values of a float or double column that change together
+/// compress together. FLOAT, INT32, DOUBLE and INT64 values are decoded with
+/// SIMD, FIXED_LEN_BYTE_ARRAY values of other widths one byte at a time.
+inline void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* output) {
+  int32_t numDecoded = 0;
+  if (width == 4) {
+    numDecoded = detail::decodeByteStreamSplitSimd<4>(data, numValues, output);
+  } else if (width == 8) {
+    numDecoded = detail::decodeByteStreamSplitSimd<8>(data, numValues, output);
+  }
+  for (auto i = numDecoded; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      output[i * width + stream] = data[stream * numValues + i];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
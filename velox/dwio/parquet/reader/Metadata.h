@@ -65,6 +65,35 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex of the column chunk. The
+  /// ColumnIndex holds the min/max values of each data page.
+  bool hasColumnIndex() const;
+
+  /// File offset of the ColumnIndex. Must check for its presence using
+  /// hasColumnIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex of the column chunk. The
+  /// OffsetIndex holds the location and first row of each data page.
+  bool hasOffsetIndex() const;
+
+  /// File offset of the OffsetIndex. Must check for its presence using
+  /// hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of a bloom filter for the column chunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the bloom filter header. Must check for its presence
+  /// using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
  private:
   const void* ptr_;
 };
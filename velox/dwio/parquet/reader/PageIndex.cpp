@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+template <typename T>
+void deserialize(const char* data, int32_t length, T& result) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  result.read(&protocol);
+}
+} // namespace
+
+void RowRanges::normalize() {
+  if (ranges_.size() < 2) {
+    return;
+  }
+  std::sort(ranges_.begin(), ranges_.end());
+  int32_t numMerged = 0;
+  for (auto i = 1; i < ranges_.size(); ++i) {
+    auto& last = ranges_[numMerged];
+    if (ranges_[i].first <= last.second) {
+      last.second = std::max(last.second, ranges_[i].second);
+    } else {
+      ranges_[++numMerged] = ranges_[i];
+    }
+  }
+  ranges_.resize(numMerged + 1);
+}
+
+int64_t RowRanges::numRows() const {
+  int64_t numRows = 0;
+  for (auto& range : ranges_) {
+    numRows += range.second - range.first;
+  }
+  return numRows;
+}
+
+int64_t RowRanges::skipFrom(int64_t row) const {
+  auto it = std::upper_bound(
+      ranges_.begin(),
+      ranges_.end(),
+      row,
+      [](int64_t row, const auto& range) { return row < range.first; });
+  if (it == ranges_.begin()) {
+    return row;
+  }
+  --it;
+  return row < it->second ? it->second : row;
+}
+
+int64_t RowRanges::nextBegin(int64_t row, int64_t limit) const {
+  auto it = std::upper_bound(
+      ranges_.begin(),
+      ranges_.end(),
+      row,
+      [](int64_t row, const auto& range) { return row < range.first; });
+  return it == ranges_.end() ? limit : std::min(limit, it->first);
+}
+
+bool RowRanges::covers(int64_t begin, int64_t end) const {
+  return begin >= end || skipFrom(begin) >= end;
+}
+
+PageIndex::PageIndex(
+    const char* offsetIndex,
+    int32_t offsetIndexLength,
+    const char* columnIndex,
+    int32_t columnIndexLength,
+    int64_t numRows)
+    : numRows_(numRows) {
+  deserialize(offsetIndex, offsetIndexLength, offsetIndex_);
+  if (columnIndex) {
+    columnIndex_.emplace();
+    deserialize(columnIndex, columnIndexLength, *columnIndex_);
+    VELOX_CHECK_EQ(
+        columnIndex_->null_pages.size(),
+        numPages(),
+        "ColumnIndex and OffsetIndex disagree on the number of pages");
+  }
+}
+
+int32_t PageIndex::pageForRow(int64_t row) const {
+  auto& locations = offsetIndex_.page_locations;
+  auto it = std::upper_bound(
+      locations.begin(),
+      locations.end(),
+      row,
+      [](int64_t row, const thrift::PageLocation& location) {
+        return row < location.first_row_index;
+      });
+  return it == locations.begin() ? 0 : (it - locations.begin()) - 1;
+}
+
+bool PageIndex::pageMatches(
+    int32_t page,
+    common::Filter& filter,
+    const TypePtr& type) const {
+  const auto numRows = numRowsInPage(page);
+  thrift::Statistics stats;
+  if (columnIndex_->null_pages[page]) {
+    // A null page has no min/max and only null values.
+    stats.__set_null_count(numRows);
+  } else {
+    stats.__set_min_value(columnIndex_->min_values[page]);
+    stats.__set_max_value(columnIndex_->max_values[page]);
+    if (columnIndex_->__isset.null_counts) {
+      stats.__set_null_count(columnIndex_->null_counts[page]);
+    }
+  }
+  auto columnStats = buildColumnStatisticsFromThrift(stats, *type, numRows);
+  return common::testFilter(&filter, columnStats.get(), numRows, type);
+}
+
+void PageIndex::pruneRows(
+    common::Filter& filter,
+    const TypePtr& type,
+    RowRanges& pruned) const {
+  if (!columnIndex_.has_value()) {
+    return;
+  }
+  for (auto page = 0; page < numPages(); ++page) {
+    if (!pageMatches(page, filter, type)) {
+      pruned.add(
+          firstRowOfPage(page), firstRowOfPage(page) + numRowsInPage(page));
+    }
+  }
+}
+
+std::vector<std::pair<int64_t, int64_t>> PageIndex::pageRegions(
+    const RowRanges& pruned) const {
+  std::vector<std::pair<int64_t, int64_t>> regions;
+  for (auto page = 0; page < numPages(); ++page) {
+    const auto firstRow = firstRowOfPage(page);
+    if (pruned.covers(firstRow, firstRow + numRowsInPage(page))) {
+      continue;
+    }
+    if (!regions.empty() &&
+        regions.back().first + regions.back().second == pageOffset(page)) {
+      regions.back().second += pageSize(page);
+    } else {
+      regions.emplace_back(pageOffset(page), pageSize(page));
+    }
+  }
+  return regions;
+}
+
+ColumnChunkRangesInputStream::ColumnChunkRangesInputStream(
+    std::vector<Range> ranges)
+    : ranges_(std::move(ranges)) {
+  for (auto i = 1; i < ranges_.size(); ++i) {
+    VELOX_CHECK_LE(
+        ranges_[i - 1].offset + ranges_[i - 1].length, ranges_[i].offset);
+  }
+  position_ = ranges_.empty() ? 0 : ranges_[0].offset;
+}
+
+bool ColumnChunkRangesInputStream::Next(const void** data, int32_t* size) {
+  if (rangeIndex_ >= ranges_.size()) {
+    return false;
+  }
+  auto& range = ranges_[rangeIndex_];
+  if (position_ < range.offset) {
+    // Sequential read into bytes that were not loaded.
+    return false;
+  }
+  if (!range.stream->Next(data, size)) {
+    return false;
+  }
+  position_ += *size;
+  return true;
+}
+
+void ColumnChunkRangesInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_LT(rangeIndex_, ranges_.size());
+  ranges_[rangeIndex_].stream->BackUp(count);
+  position_ -= count;
+}
+
+bool ColumnChunkRangesInputStream::SkipInt64(int64_t count) {
+  if (count < 0) {
+    return false;
+  }
+  seekTo(position_ + count);
+  return true;
+}
+
+google::protobuf::int64 ColumnChunkRangesInputStream::ByteCount() const {
+  return position_;
+}
+
+void ColumnChunkRangesInputStream::seekToPosition(
+    dwio::common::PositionProvider& position) {
+  seekTo(position.next());
+}
+
+void ColumnChunkRangesInputStream::seekTo(uint64_t offset) {
+  position_ = offset;
+  for (rangeIndex_ = 0; rangeIndex_ < ranges_.size(); ++rangeIndex_) {
+    auto& range = ranges_[rangeIndex_];
+    if (offset < range.offset) {
+      // 'offset' is in a gap. The next Next() fails unless there is a seek to
+      // a loaded range first.
+      return;
+    }
+    if (offset <= range.offset + range.length) {
+      std::vector<uint64_t> positions = {offset - range.offset};
+      dwio::common::PositionProvider provider(positions);
+      range.stream->seekToPosition(provider);
+      return;
+    }
+  }
+}
+
+std::string ColumnChunkRangesInputStream::getName() const {
+  return fmt::format(
+      "ColumnChunkRangesInputStream {} ranges at {}: {}",
+      ranges_.size(),
+      position_,
+      rangeIndex_ < ranges_.size() ? ranges_[rangeIndex_].stream->getName()
+                                   : "end");
+}
+
+} // namespace facebook::velox::parquet
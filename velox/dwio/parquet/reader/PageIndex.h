@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
+/// A set of [begin, end) top level row ranges inside a row group. Ranges are
+/// added in any order and must be normalized with normalize() before
+/// lookups.
+class RowRanges {
+ public:
+  void add(int64_t begin, int64_t end) {
+    if (begin < end) {
+      ranges_.emplace_back(begin, end);
+    }
+  }
+
+  void add(const RowRanges& other) {
+    ranges_.insert(ranges_.end(), other.ranges_.begin(), other.ranges_.end());
+  }
+
+  /// Sorts the ranges and merges overlapping and adjacent ones.
+  void normalize();
+
+  bool empty() const {
+    return ranges_.empty();
+  }
+
+  void clear() {
+    ranges_.clear();
+  }
+
+  const std::vector<std::pair<int64_t, int64_t>>& ranges() const {
+    return ranges_;
+  }
+
+  /// Returns the number of rows covered by the ranges.
+  int64_t numRows() const;
+
+  /// Returns the end of the range containing 'row' or 'row' if 'row' is not
+  /// in any range.
+  int64_t skipFrom(int64_t row) const;
+
+  /// Returns the begin of the first range starting after 'row', or 'limit' if
+  /// there is no such range.
+  int64_t nextBegin(int64_t row, int64_t limit) const;
+
+  /// True if all rows in [begin, end) are in the ranges.
+  bool covers(int64_t begin, int64_t end) const;
+
+ private:
+  std::vector<std::pair<int64_t, int64_t>> ranges_;
+};
+
+/// Page level statistics and page locations of a column chunk, deserialized
+/// from the ColumnIndex and OffsetIndex structures that writers place between
+/// the last row group and the footer. See
+/// https://github.com/apache/parquet-format/blob/master/PageIndex.md.
+class PageIndex {
+ public:
+  /// Deserializes the OffsetIndex from 'offsetIndex' and the ColumnIndex from
+  /// 'columnIndex' if not nullptr. 'numRows' is the number of rows in the row
+  /// group.
+  PageIndex(
+      const char* offsetIndex,
+      int32_t offsetIndexLength,
+      const char* columnIndex,
+      int32_t columnIndexLength,
+      int64_t numRows);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  bool hasColumnIndex() const {
+    return columnIndex_.has_value();
+  }
+
+  /// Returns the top level row number of the first row of 'page' from the
+  /// start of the row group.
+  int64_t firstRowOfPage(int32_t page) const {
+    return offsetIndex_.page_locations[page].first_row_index;
+  }
+
+  int64_t numRowsInPage(int32_t page) const {
+    return (page + 1 < numPages() ? firstRowOfPage(page + 1) : numRows_) -
+        firstRowOfPage(page);
+  }
+
+  /// Returns the file offset of the header of 'page'.
+  int64_t pageOffset(int32_t page) const {
+    return offsetIndex_.page_locations[page].offset;
+  }
+
+  /// Returns the size of 'page' including its header.
+  int32_t pageSize(int32_t page) const {
+    return offsetIndex_.page_locations[page].compressed_page_size;
+  }
+
+  /// Returns the index of the page that contains top level 'row'.
+  int32_t pageForRow(int64_t row) const;
+
+  /// Adds to 'pruned' the rows of the pages in which no value can pass
+  /// 'filter' according to the ColumnIndex. 'type' is the type of the column.
+  void pruneRows(
+      common::Filter& filter,
+      const TypePtr& type,
+      RowRanges& pruned) const;
+
+  /// Returns the [offset, length) byte ranges of the pages that have rows not
+  /// in 'pruned'. Adjacent pages are coalesced.
+  std::vector<std::pair<int64_t, int64_t>> pageRegions(
+      const RowRanges& pruned) const;
+
+ private:
+  // True if 'filter' may pass a value in 'page'.
+  bool pageMatches(int32_t page, common::Filter& filter, const TypePtr& type)
+      const;
+
+  const int64_t numRows_;
+  thrift::OffsetIndex offsetIndex_;
+  std::optional<thrift::ColumnIndex> columnIndex_;
+};
+
+/// Presents a set of byte ranges of a column chunk as one stream addressed by
+/// offsets from the start of the chunk. This is used when pages excluded by
+/// the page index are not read. Reading continues sequentially inside a
+/// range. Reaching the gap between two ranges requires a seek, which the
+/// PageReader does using the OffsetIndex.
+class ColumnChunkRangesInputStream : public dwio::common::SeekableInputStream {
+ public:
+  struct Range {
+    // Offset of the range from the start of the column chunk.
+    uint64_t offset;
+    uint64_t length;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+
+  explicit ColumnChunkRangesInputStream(std::vector<Range> ranges);
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool SkipInt64(int64_t count) override;
+
+  google::protobuf::int64 ByteCount() const override;
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override;
+
+  size_t positionSize() const override {
+    return 1;
+  }
+
+ private:
+  // Positions 'this' at 'offset' from the start of the column chunk. The
+  // offset must be inside one of 'ranges_'.
+  void seekTo(uint64_t offset);
+
+  std::vector<Range> ranges_;
+
+  // Index of the current range in 'ranges_'.
+  int32_t rangeIndex_{0};
+
+  // Offset from start of the chunk of the next byte returned by Next().
+  uint64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -50,6 +50,9 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
+    if (pageIndex_ && row != kRepDefOnly) {
+      seekToIndexedPage(row);
+    }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
@@ -81,6 +84,25 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::seekToIndexedPage(int64_t row) {
+  if (pageIndex_->numPages() == 0 ||
+      pageStart_ <
+          static_cast<uint64_t>(pageIndex_->pageOffset(0) - chunkOffset_)) {
+    return;
+  }
+  const auto page = pageIndex_->pageForRow(row);
+  const uint64_t offset = pageIndex_->pageOffset(page) - chunkOffset_;
+  if (offset <= pageStart_) {
+    return;
+  }
+  std::vector<uint64_t> positions = {offset};
+  dwio::common::PositionProvider position(positions);
+  inputStream_->seekToPosition(position);
+  bufferStart_ = bufferEnd_ = nullptr;
+  pageStart_ = offset;
+  rowOfPage_ = pageIndex_->firstRowOfPage(page);
+}
+
 PageHeader PageReader::readPageHeader() {
   TestValue::adjust(
       "facebook::velox::parquet::PageReader::readPageHeader", this);
@@ -655,6 +677,14 @@ int32_t PageReader::getLengthsAndNulls(
 }
 
 void PageReader::makeDecoder() {
+  directDecoder_.reset();
+  dictionaryIdDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaByteArrDecoder_.reset();
+  deltaLengthByteArrDecoder_.reset();
+
   auto parquetType = type_->parquetType_.value();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
@@ -663,37 +693,7 @@ void PageReader::makeDecoder() {
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BOOLEAN:
-          booleanDecoder_ = std::make_unique<BooleanDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          if (type_->type()->isVarbinary() || type_->type()->isVarchar()) {
-            stringDecoder_ = std::make_unique<StringDecoder>(
-                pageData_, pageData_ + encodedDataSize_, type_->typeLength_);
-          } else {
-            directDecoder_ =
-                std::make_unique<dwio::common::DirectDecoder<true>>(
-                    std::make_unique<dwio::common::SeekableArrayInputStream>(
-                        pageData_, encodedDataSize_),
-                    false,
-                    type_->typeLength_,
-                    true);
-          }
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
+      makePlainDecoder(pageData_, encodedDataSize_);
       break;
     case Encoding::DELTA_BINARY_PACKED:
       switch (parquetType) {
@@ -706,18 +706,114 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaLengthByteArrDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+      break;
     case Encoding::DELTA_BYTE_ARRAY:
-      if (parquetType == thrift::Type::BYTE_ARRAY) {
+      if (parquetType == thrift::Type::BYTE_ARRAY ||
+          (parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY &&
+           (type_->type()->isVarbinary() || type_->type()->isVarchar()))) {
         deltaByteArrDecoder_ =
             std::make_unique<DeltaByteArrayDecoder>(pageData_);
-        break;
+      } else if (parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY) {
+        makeFixedLengthDeltaByteArrayDecoder();
+      } else {
+        VELOX_UNSUPPORTED(
+            "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY and "
+            "FIXED_LEN_BYTE_ARRAY");
       }
-      FMT_FALLTHROUGH;
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      makeByteStreamSplitDecoder();
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makePlainDecoder(const char* data, int32_t size) {
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::BOOLEAN:
+      booleanDecoder_ = std::make_unique<BooleanDecoder>(data, data + size);
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(data, data + size);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      if (type_->type()->isVarbinary() || type_->type()->isVarchar()) {
+        stringDecoder_ = std::make_unique<StringDecoder>(
+            data, data + size, type_->typeLength_);
+      } else {
+        directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                data, size),
+            false,
+            type_->typeLength_,
+            true);
+      }
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(data, size),
+          false,
+          parquetTypeBytes(type_->parquetType_.value()));
+    }
+  }
+}
+
+void PageReader::makeByteStreamSplitDecoder() {
+  int32_t width;
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64:
+    case thrift::Type::FLOAT:
+    case thrift::Type::DOUBLE:
+      width = parquetTypeBytes(type_->parquetType_.value());
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      width = type_->typeLength_;
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "BYTE_STREAM_SPLIT decoder only supports FLOAT, DOUBLE, INT32, "
+          "INT64 and FIXED_LEN_BYTE_ARRAY");
+  }
+  VELOX_CHECK_GT(width, 0);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % width,
+      0,
+      "BYTE_STREAM_SPLIT data size is not a multiple of the value size");
+  // The values may be read a word at a time past the end.
+  dwio::common::ensureCapacity<char>(
+      decodedValues_, encodedDataSize_ + simd::kPadding, &pool_);
+  auto* values = decodedValues_->asMutable<char>();
+  decodeByteStreamSplit(pageData_, encodedDataSize_ / width, width, values);
+  makePlainDecoder(values, encodedDataSize_);
+}
+
+void PageReader::makeFixedLengthDeltaByteArrayDecoder() {
+  DeltaByteArrayDecoder decoder(pageData_);
+  const auto width = type_->typeLength_;
+  const auto size = decoder.numValues() * width;
+  dwio::common::ensureCapacity<char>(
+      decodedValues_, size + simd::kPadding, &pool_);
+  auto* values = decodedValues_->asMutable<char>();
+  for (auto i = 0; i < size; i += width) {
+    auto value = decoder.readString();
+    VELOX_CHECK_EQ(
+        static_cast<int32_t>(value.size()),
+        width,
+        "Value size does not match FIXED_LEN_BYTE_ARRAY length");
+    memcpy(values + i, value.data(), width);
+  }
+  makePlainDecoder(values, size);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -755,6 +851,8 @@ void PageReader::skip(int64_t numRows) {
     deltaBpDecoder_->skip(toSkip);
   } else if (deltaByteArrDecoder_) {
     deltaByteArrDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrDecoder_) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -23,8 +23,10 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/common/RleEncodingInternal.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -149,6 +151,20 @@ class PageReader {
     return sessionTimezone_;
   }
 
+  /// Sets the page index of the column chunk. 'chunkOffset' is the file
+  /// offset of the first byte of the stream of 'this'. With a page index, a
+  /// seek to a row of a top level column positions the stream at the page
+  /// containing the row without reading the headers of the pages in between.
+  /// This allows the stream to leave out the pages pruned by the page index.
+  void setPageIndex(
+      std::shared_ptr<const PageIndex> pageIndex,
+      int64_t chunkOffset) {
+    if (isTopLevel_) {
+      pageIndex_ = std::move(pageIndex);
+      chunkOffset_ = chunkOffset;
+    }
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -183,6 +199,11 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Positions the stream at the header of the page containing 'row' using
+  // 'pageIndex_' if the page is after the current page. Does nothing before
+  // the dictionary page, if any, has been read.
+  void seekToIndexedPage(int64_t row);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -205,6 +226,19 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Makes the decoder for the values of 'size' bytes at 'data' in the PLAIN
+  // layout.
+  void makePlainDecoder(const char* data, int32_t size);
+
+  // Decodes the BYTE_STREAM_SPLIT encoded values of the page into
+  // 'decodedValues_' and makes a PLAIN decoder for them.
+  void makeByteStreamSplitDecoder();
+
+  // Decodes the DELTA_BYTE_ARRAY encoded values of a FIXED_LEN_BYTE_ARRAY
+  // page that is not read as strings into 'decodedValues_' and makes a
+  // PLAIN decoder for them.
+  void makeFixedLengthDeltaByteArrayDecoder();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -312,6 +346,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         nullsFromFastPath = false;
         deltaByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -322,6 +359,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         deltaByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -435,6 +474,10 @@ class PageReader {
   // contiguous run of bytes.
   const char* pageData_{nullptr};
 
+  // Values of the page in the PLAIN layout for the encodings that are decoded
+  // a page at a time, e.g. BYTE_STREAM_SPLIT.
+  BufferPtr decodedValues_;
+
   // Dictionary contents.
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
@@ -445,6 +488,13 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Page locations of the column chunk. Set only for top level columns.
+  std::shared_ptr<const PageIndex> pageIndex_;
+
+  // File offset of the first byte of 'inputStream_'. Page locations in
+  // 'pageIndex_' are relative to the start of the file.
+  int64_t chunkOffset_{0};
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
@@ -499,6 +549,7 @@ class PageReader {
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/BloomFilterPushdown.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
 
 namespace facebook::velox::parquet {
@@ -89,6 +90,67 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+// static
+int64_t ParquetData::chunkReadOffset(const ColumnChunkMetaDataPtr& chunk) {
+  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    return chunk.dictionaryPageOffset();
+  }
+  return chunk.dataPageOffset();
+}
+
+std::optional<std::pair<int64_t, int32_t>> ParquetData::offsetIndexRegion(
+    uint32_t index) const {
+  if (maxRepeat_ > 0 || maxDefine_ > 1) {
+    return std::nullopt;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasMetadata() || !chunk.hasOffsetIndex()) {
+    return std::nullopt;
+  }
+  return std::make_pair(chunk.offsetIndexOffset(), chunk.offsetIndexLength());
+}
+
+std::optional<std::pair<int64_t, int32_t>> ParquetData::columnIndexRegion(
+    uint32_t index,
+    const dwio::common::StatsContext& statsContext) const {
+  auto parquetStatsContext =
+      reinterpret_cast<const ParquetStatsContext*>(&statsContext);
+  if (type_->parquetType_.has_value() &&
+      parquetStatsContext->shouldIgnoreStatistics(
+          type_->parquetType_.value())) {
+    return std::nullopt;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasMetadata() || !chunk.hasColumnIndex()) {
+    return std::nullopt;
+  }
+  return std::make_pair(chunk.columnIndexOffset(), chunk.columnIndexLength());
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t index,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) const {
+  if (!type_->parquetType_.has_value() ||
+      !canUseBloomFilter(filter, type_->type(), type_->parquetType_.value())) {
+    return true;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasBloomFilter()) {
+    return true;
+  }
+  auto bloomFilter = readBloomFilter(input, chunk.bloomFilterOffset(), pool_);
+  return testBloomFilter(filter, *bloomFilter, type_->parquetType_.value());
+}
+
+void ParquetData::setPageIndex(
+    uint32_t index,
+    std::shared_ptr<const PageIndex> pageIndex,
+    std::shared_ptr<const RowRanges> prunedRows) {
+  pageIndices_[index] = {std::move(pageIndex), std::move(prunedRows)};
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -98,12 +160,38 @@ void ParquetData::enqueueRowGroup(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
-  ;
 
-  uint64_t chunkReadOffset = chunk.dataPageOffset();
-  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = chunk.dictionaryPageOffset();
+  const int64_t readOffset = chunkReadOffset(chunk);
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  auto it = pageIndices_.find(index);
+  if (it != pageIndices_.end() && it->second.prunedRows &&
+      !it->second.prunedRows->empty()) {
+    // Read the dictionary, if any, and the pages that have unpruned rows.
+    auto& pageIndex = *it->second.pageIndex;
+    auto regions = pageIndex.pageRegions(*it->second.prunedRows);
+    if (pageIndex.numPages() > 0 && readOffset < pageIndex.pageOffset(0)) {
+      const auto dictionarySize = pageIndex.pageOffset(0) - readOffset;
+      if (!regions.empty() && regions[0].first == pageIndex.pageOffset(0)) {
+        regions[0].first = readOffset;
+        regions[0].second += dictionarySize;
+      } else {
+        regions.insert(
+            regions.begin(), std::make_pair(readOffset, dictionarySize));
+      }
+    }
+    std::vector<ColumnChunkRangesInputStream::Range> ranges;
+    ranges.reserve(regions.size());
+    for (auto& [offset, length] : regions) {
+      ranges.push_back(
+          {static_cast<uint64_t>(offset - readOffset),
+           static_cast<uint64_t>(length),
+           input.enqueue(
+               {static_cast<uint64_t>(offset), static_cast<uint64_t>(length)},
+               &id)});
+    }
+    streams_[index] =
+        std::make_unique<ColumnChunkRangesInputStream>(std::move(ranges));
+    return;
   }
 
   uint64_t readSize =
@@ -111,8 +199,8 @@ void ParquetData::enqueueRowGroup(
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
-  auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] =
+      input.enqueue({static_cast<uint64_t>(readOffset), readSize}, &id);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
@@ -127,6 +215,12 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       metadata.compression(),
       metadata.totalCompressedSize(),
       sessionTimezone_);
+  auto it = pageIndices_.find(index);
+  if (it != pageIndices_.end()) {
+    reader_->setPageIndex(
+        std::move(it->second.pageIndex), chunkReadOffset(metadata));
+    pageIndices_.erase(it);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -72,9 +75,42 @@ class ParquetData : public dwio::common::FormatData {
         rowsInRowGroup_(-1),
         sessionTimezone_(sessionTimezone) {}
 
-  /// Prepares to read data for 'index'th row group.
+  /// Prepares to read data for 'index'th row group. If a page index with
+  /// pruned rows is set for the row group, only the pages with rows outside of
+  /// the pruned rows are enqueued.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  /// Returns the file region of the OffsetIndex of the column chunk in
+  /// 'index'th row group or std::nullopt if the chunk has no OffsetIndex or
+  /// 'this' is not a top level column.
+  std::optional<std::pair<int64_t, int32_t>> offsetIndexRegion(
+      uint32_t index) const;
+
+  /// Returns the file region of the ColumnIndex of the column chunk in
+  /// 'index'th row group or std::nullopt if the chunk has no ColumnIndex or
+  /// the statistics of the column should not be used according to
+  /// 'statsContext'.
+  std::optional<std::pair<int64_t, int32_t>> columnIndexRegion(
+      uint32_t index,
+      const dwio::common::StatsContext& statsContext) const;
+
+  /// Returns false if the bloom filter of the column chunk in 'index'th row
+  /// group shows that no value can pass 'filter'. Reads the bloom filter from
+  /// 'input' only if the chunk has one and 'filter' tests for a small set of
+  /// discrete values.
+  bool bloomFilterMatches(
+      uint32_t index,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// Sets the page index for 'index'th row group together with the rows of
+  /// the row group that no filter can pass according to the page indices of
+  /// all filtered columns. Must be called before enqueueRowGroup().
+  void setPageIndex(
+      uint32_t index,
+      std::shared_ptr<const PageIndex> pageIndex,
+      std::shared_ptr<const RowRanges> prunedRows);
+
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
   /// Other formats may use it.
@@ -203,11 +239,23 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  int64_t numRowsInRowGroup(uint32_t index) const {
+    return fileMetaDataPtr_.rowGroup(index).numRows();
+  }
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Returns the file offset of the first page of 'chunk'.
+  static int64_t chunkReadOffset(const ColumnChunkMetaDataPtr& chunk);
+
+  struct RowGroupPageIndex {
+    std::shared_ptr<const PageIndex> pageIndex;
+    std::shared_ptr<const RowRanges> prunedRows;
+  };
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -222,6 +270,10 @@ class ParquetData : public dwio::common::FormatData {
   const tz::TimeZone* sessionTimezone_;
   std::unique_ptr<PageReader> reader_;
 
+  // Page indices set by setPageIndex(), keyed on row group. An entry is
+  // removed when its row group is seeked to.
+  folly::F14FastMap<uint32_t, RowGroupPageIndex> pageIndices_;
+
   // Nulls derived from leaf repdefs for non-leaf readers.
   BufferPtr presetNulls_;
 
@@ -83,6 +83,10 @@ class ReaderBase {
     return options_.sessionTimezone();
   }
 
+  bool pageIndexFilterEnabled() const {
+    return options_.parquetPageIndexFilterEnabled();
+  }
+
   std::optional<SemanticVersion> version() const {
     return version_;
   }
@@ -961,6 +965,10 @@ class ParquetRowReader::Impl {
         params,
         *options_.scanSpec());
     columnReader_->setIsTopLevel();
+    if (readerBase_->pageIndexFilterEnabled()) {
+      static_cast<StructColumnReader&>(*columnReader_)
+          .enablePageFiltering(&parquetStatsContext_);
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -999,7 +1007,8 @@ class ParquetRowReader::Impl {
 
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
-      if (rowGroupInRange && !isExcluded && !isEmpty) {
+      if (rowGroupInRange && !isExcluded && !isEmpty &&
+          !bloomFilterExcludes(i)) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       }
@@ -1008,9 +1017,15 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      skipPrunedRows();
+      if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -1020,7 +1035,12 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t endOfRead = rowsInCurrentRowGroup_;
+    if (prunedRows_) {
+      // Do not read into rows pruned by the page index.
+      endOfRead = prunedRows_->nextBegin(currentRowInGroup_, endOfRead);
+    }
+    return std::min(size, endOfRead - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1057,8 +1077,23 @@ class ParquetRowReader::Impl {
         rowGroups_[index].num_rows;
   }
 
+  // Returns true if a column chunk bloom filter shows that no row of
+  // 'rowGroup' passes the filters. Only called for row groups that are in
+  // range and pass the row group statistics, so that bloom filters are read
+  // only when they can make a difference.
+  bool bloomFilterExcludes(int32_t rowGroup) {
+    if (static_cast<StructColumnReader&>(*columnReader_)
+            .bloomFiltersMatch(rowGroup, readerBase_->bufferedInput())) {
+      return false;
+    }
+    ++bloomFilterSkippedStrides_;
+    return true;
+  }
+
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.bloomFilterSkippedStrides += bloomFilterSkippedStrides_;
+    stats.skippedPageRows += skippedPageRows_;
   }
 
   void resetFilterCaches() {
@@ -1070,6 +1105,24 @@ class ParquetRowReader::Impl {
   }
 
  private:
+  // Moves past the rows at the current position that the page index shows
+  // can not pass the filters. The rows are not decoded for any column.
+  void skipPrunedRows() {
+    if (!prunedRows_) {
+      return;
+    }
+    const uint64_t end = prunedRows_->skipFrom(currentRowInGroup_);
+    if (end == currentRowInGroup_) {
+      return;
+    }
+    const auto numSkipped =
+        std::min(end, rowsInCurrentRowGroup_) - currentRowInGroup_;
+    // The child readers seek to the new offset on their next read.
+    columnReader_->setReadOffset(columnReader_->readOffset() + numSkipped);
+    currentRowInGroup_ += numSkipped;
+    skippedPageRows_ += numSkipped;
+  }
+
   bool advanceToNextRowGroup() {
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
@@ -1085,6 +1138,8 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    prunedRows_ = static_cast<StructColumnReader&>(*columnReader_)
+                      .takePrunedRows(nextRowGroupIndex);
     return true;
   }
 
@@ -1102,6 +1157,15 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Rows of the current row group that are excluded by the page index.
+  std::shared_ptr<const RowRanges> prunedRows_;
+
+  // Number of rows skipped because of 'prunedRows_'.
+  int64_t skippedPageRows_{0};
+
+  // Number of row groups excluded by column chunk bloom filters.
+  int64_t bloomFilterSkippedStrides_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   TypePtr requestedType_;
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
+
+namespace facebook::velox::parquet {
+
+/// Reads 'length' bytes at 'offset' of 'input' into a string. Used for file
+/// metadata outside of the footer, such as page indices and bloom filters.
+inline std::string readRegion(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int64_t length) {
+  std::string data(length, '\0');
+  auto stream = input.read(offset, length, dwio::common::LogType::FOOTER);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), data.data(), bufferStart, bufferEnd);
+  return data;
+}
+
+} // namespace facebook::velox::parquet
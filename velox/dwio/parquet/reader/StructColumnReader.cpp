@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
+#include "velox/dwio/parquet/reader/ReadRegion.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
 namespace facebook::velox::common {
@@ -111,6 +112,9 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  if (pageFilterContext_) {
+    filterPages(index, *input);
+  }
   if (isRowGroupBuffered(index, *input)) {
     enqueueRowGroup(index, *input);
     return input;
@@ -129,6 +133,132 @@ bool StructColumnReader::isRowGroupBuffered(
   return input.isBuffered(offset, length);
 }
 
+namespace {
+// Maximum size of a single read covering the page indices of all columns of
+// a row group. Larger spans are read one index at a time.
+constexpr int64_t kMaxPageIndexSpan = 8 << 20;
+
+struct LeafPageIndex {
+  ParquetData* data;
+  common::Filter* filter;
+  TypePtr type;
+  std::pair<int64_t, int32_t> offsetIndex;
+  std::optional<std::pair<int64_t, int32_t>> columnIndex;
+};
+} // namespace
+
+void StructColumnReader::filterPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  std::vector<LeafPageIndex> leaves;
+  bool hasColumnIndex = false;
+  int64_t begin = std::numeric_limits<int64_t>::max();
+  int64_t end = 0;
+  auto addRegion = [&](const std::pair<int64_t, int32_t>& region) {
+    begin = std::min(begin, region.first);
+    end = std::max(end, region.first + region.second);
+  };
+  for (auto* child : children_) {
+    if (dynamic_cast<StructColumnReader*>(child) ||
+        dynamic_cast<ListColumnReader*>(child) ||
+        dynamic_cast<MapColumnReader*>(child)) {
+      continue;
+    }
+    auto& data = child->formatData().as<ParquetData>();
+    auto offsetIndex = data.offsetIndexRegion(index);
+    if (!offsetIndex.has_value()) {
+      continue;
+    }
+    auto* filter = child->scanSpec()->filter();
+    std::optional<std::pair<int64_t, int32_t>> columnIndex;
+    if (filter) {
+      columnIndex = data.columnIndexRegion(index, *pageFilterContext_);
+    }
+    addRegion(*offsetIndex);
+    if (columnIndex.has_value()) {
+      hasColumnIndex = true;
+      addRegion(*columnIndex);
+    }
+    leaves.push_back(
+        {&data, filter, child->fileType().type(), *offsetIndex, columnIndex});
+  }
+  if (!hasColumnIndex) {
+    return;
+  }
+
+  std::string span;
+  if (end - begin <= kMaxPageIndexSpan) {
+    span = readRegion(input, begin, end - begin);
+  }
+  auto regionData = [&](const std::pair<int64_t, int32_t>& region,
+                        std::string& copy) -> const char* {
+    if (!span.empty()) {
+      return span.data() + region.first - begin;
+    }
+    copy = readRegion(input, region.first, region.second);
+    return copy.data();
+  };
+
+  const auto numRows = leaves[0].data->numRowsInRowGroup(index);
+  auto prunedRows = std::make_shared<RowRanges>();
+  std::vector<std::shared_ptr<const PageIndex>> pageIndices;
+  pageIndices.reserve(leaves.size());
+  for (auto& leaf : leaves) {
+    std::string offsetIndexCopy;
+    std::string columnIndexCopy;
+    auto* offsetIndex = regionData(leaf.offsetIndex, offsetIndexCopy);
+    auto* columnIndex = leaf.columnIndex.has_value()
+        ? regionData(*leaf.columnIndex, columnIndexCopy)
+        : nullptr;
+    auto pageIndex = std::make_shared<PageIndex>(
+        offsetIndex,
+        leaf.offsetIndex.second,
+        columnIndex,
+        columnIndex ? leaf.columnIndex->second : 0,
+        numRows);
+    if (leaf.filter) {
+      pageIndex->pruneRows(*leaf.filter, leaf.type, *prunedRows);
+    }
+    pageIndices.push_back(std::move(pageIndex));
+  }
+  prunedRows->normalize();
+  for (auto i = 0; i < leaves.size(); ++i) {
+    leaves[i].data->setPageIndex(index, std::move(pageIndices[i]), prunedRows);
+  }
+  if (!prunedRows->empty()) {
+    prunedRows_[index] = std::move(prunedRows);
+  }
+}
+
+bool StructColumnReader::bloomFiltersMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  for (auto* child : children_) {
+    auto* filter = child->scanSpec()->filter();
+    if (!filter || dynamic_cast<StructColumnReader*>(child) ||
+        dynamic_cast<ListColumnReader*>(child) ||
+        dynamic_cast<MapColumnReader*>(child)) {
+      continue;
+    }
+    if (!child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, *filter, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<const RowRanges> StructColumnReader::takePrunedRows(
+    uint32_t index) {
+  auto it = prunedRows_.find(index);
+  if (it == prunedRows_.end()) {
+    return nullptr;
+  }
+  auto prunedRows = std::move(it->second);
+  prunedRows_.erase(it);
+  return prunedRows;
+}
+
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
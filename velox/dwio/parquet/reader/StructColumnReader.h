@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
@@ -44,11 +47,30 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads. If page filtering is enabled, first
+  /// reads the page indices of the row group and leaves out the pages whose
+  /// rows can not pass the filters.
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Enables filtering of pages by the ColumnIndex of filtered top level
+  /// columns. 'context' is used to decide whether the statistics of a column
+  /// can be trusted and must outlive 'this'. Called on the root reader.
+  void enablePageFiltering(const dwio::common::StatsContext* context) {
+    pageFilterContext_ = context;
+  }
+
+  /// Returns false if the bloom filter of a filtered top level column shows
+  /// that no row of 'index'th row group can pass the filter. Bloom filters
+  /// are read from 'input' on demand, only for filters on discrete values.
+  bool bloomFiltersMatch(uint32_t index, dwio::common::BufferedInput& input);
+
+  /// Returns the rows of 'index'th row group that can not pass the filters
+  /// according to the page indices and removes them from 'this'. Returns
+  /// nullptr if no rows are pruned.
+  std::shared_ptr<const RowRanges> takePrunedRows(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -82,6 +104,11 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
+  // Reads the page indices of the top level leaf children for 'index'th row
+  // group, computes the rows that no filter can pass and gives the page
+  // indices and pruned rows to the children.
+  void filterPages(uint32_t index, dwio::common::BufferedInput& input);
+
   // Leaf column reader used for getting nullability information for
   // 'this'. This is nullptr for the root of a table.
   dwio::common::SelectiveColumnReader* childForRepDefs_{nullptr};
@@ -93,6 +120,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   LevelInfo levelInfo_;
+
+  // Statistics context for page filtering. Page filtering is off if nullptr.
+  const dwio::common::StatsContext* pageFilterContext_{nullptr};
+
+  // Rows pruned by page filtering for each loaded row group.
+  folly::F14FastMap<uint32_t, std::shared_ptr<const RowRanges>> prunedRows_;
 };
 
 } // namespace facebook::velox::parquet
@@ -23,19 +23,99 @@
 #include <string>
 #include <vector>
 
+#include <folly/lang/Bits.h>
 #include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+#include <thrift/transport/TBufferTransports.h> // @manual
 
+#include "velox/common/file/File.h"
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/common/XxHasher.h"
+#include "velox/dwio/parquet/reader/BloomFilterPushdown.h"
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
 
-class BloomFilterTest : public ParquetTestBase {};
+class BloomFilterTest : public ParquetTestBase {
+ protected:
+  // Returns the bloom filter header and bitset of 'bloomFilter'.
+  std::string serialize(const BlockSplitBloomFilter& bloomFilter) {
+    dwio::common::DataBufferHolder bufferHolder{*leafPool_, 1'024};
+    dwio::common::AppendOnlyBufferedStream sink(
+        std::make_unique<dwio::common::BufferedOutputStream>(bufferHolder));
+    bloomFilter.writeTo(&sink);
+    sink.flush();
+    std::string data;
+    for (auto& buffer : bufferHolder.getBuffers()) {
+      data.append(buffer.data(), buffer.size());
+    }
+    return data;
+  }
+
+  // Copies the single column Parquet file at 'path' to a new file with a
+  // bloom filter of 'rowGroupValues[i]' for the column chunk of row group i,
+  // and returns the path of the new file. The Parquet writer does not write
+  // bloom filters.
+  std::string addBloomFilters(
+      const std::string& path,
+      const std::vector<std::vector<int64_t>>& rowGroupValues) {
+    std::string file;
+    {
+      LocalReadFile readFile(path);
+      file = readFile.pread(0, readFile.size());
+    }
+    // The file ends with the footer, its 4 byte length and "PAR1".
+    const auto footerLength =
+        folly::loadUnaligned<uint32_t>(file.data() + file.size() - 8);
+    const auto footerStart = file.size() - 8 - footerLength;
+    thrift::FileMetaData metadata;
+    {
+      auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+          file.data() + footerStart, footerLength);
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+          protocol(transport);
+      metadata.read(&protocol);
+    }
+    file.resize(footerStart);
+
+    VELOX_CHECK_EQ(metadata.row_groups.size(), rowGroupValues.size());
+    for (auto i = 0; i < rowGroupValues.size(); ++i) {
+      BlockSplitBloomFilter bloomFilter(leafPool_.get());
+      bloomFilter.init(BlockSplitBloomFilter::optimalNumOfBytes(
+          rowGroupValues[i].size(), 0.001));
+      for (auto value : rowGroupValues[i]) {
+        bloomFilter.insertHash(bloomFilter.hash(value));
+      }
+      metadata.row_groups[i].columns[0].meta_data.__set_bloom_filter_offset(
+          file.size());
+      file.append(serialize(bloomFilter));
+    }
+
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocolT<
+        apache::thrift::transport::TMemoryBuffer>
+        protocol(buffer);
+    metadata.write(&protocol);
+    uint8_t* footer;
+    uint32_t newFooterLength;
+    buffer->getBuffer(&footer, &newFooterLength);
+    file.append(reinterpret_cast<const char*>(footer), newFooterLength);
+    file.append(
+        reinterpret_cast<const char*>(&newFooterLength), sizeof(uint32_t));
+    file.append("PAR1");
+
+    const auto newPath = path + ".bloom";
+    LocalWriteFile writeFile(newPath);
+    writeFile.append(file);
+    writeFile.close();
+    return newPath;
+  }
+};
 
 TEST_F(BloomFilterTest, ConstructorTest) {
   BlockSplitBloomFilter bloomFilter(leafPool_.get());
@@ -395,3 +475,171 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, filterPushdown) {
+  BlockSplitBloomFilter bloomFilter(leafPool_.get());
+  bloomFilter.init(BlockSplitBloomFilter::optimalNumOfBytes(100, 0.001));
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter.insertHash(bloomFilter.hash(i * 1'000));
+  }
+  const auto kInt64 = thrift::Type::INT64;
+
+  auto equal = std::make_unique<common::BigintRange>(5'000, 5'000, false);
+  ASSERT_TRUE(canUseBloomFilter(*equal, BIGINT(), kInt64));
+  EXPECT_TRUE(testBloomFilter(*equal, bloomFilter, kInt64));
+  auto missing = std::make_unique<common::BigintRange>(5'001, 5'001, false);
+  EXPECT_FALSE(testBloomFilter(*missing, bloomFilter, kInt64));
+
+  auto in = common::createBigintValues({1, 7, 20'000'000}, false);
+  ASSERT_EQ(in->kind(), common::FilterKind::kBigintValuesUsingHashTable);
+  ASSERT_TRUE(canUseBloomFilter(*in, BIGINT(), kInt64));
+  EXPECT_FALSE(testBloomFilter(*in, bloomFilter, kInt64));
+  in = common::createBigintValues({1, 7, 20'000'000, 99'000}, false);
+  EXPECT_TRUE(testBloomFilter(*in, bloomFilter, kInt64));
+  auto bitmask = common::createBigintValues({1, 3, 5, 7, 9}, false);
+  ASSERT_EQ(bitmask->kind(), common::FilterKind::kBigintValuesUsingBitmask);
+  ASSERT_TRUE(canUseBloomFilter(*bitmask, BIGINT(), kInt64));
+  EXPECT_FALSE(testBloomFilter(*bitmask, bloomFilter, kInt64));
+
+  // Filters that pass nulls or ranges of values can not use bloom filters.
+  auto nullAllowed = std::make_unique<common::BigintRange>(5'000, 5'000, true);
+  EXPECT_FALSE(canUseBloomFilter(*nullAllowed, BIGINT(), kInt64));
+  auto range = std::make_unique<common::BigintRange>(5'000, 6'000, false);
+  EXPECT_FALSE(canUseBloomFilter(*range, BIGINT(), kInt64));
+  EXPECT_FALSE(canUseBloomFilter(*equal, DOUBLE(), thrift::Type::DOUBLE));
+  // Unsigned 32 bit integers are read as BIGINT from INT32.
+  EXPECT_FALSE(canUseBloomFilter(*equal, BIGINT(), thrift::Type::INT32));
+
+  // INT32 columns hash the 4 byte plain encoding.
+  BlockSplitBloomFilter intBloomFilter(leafPool_.get());
+  intBloomFilter.init(BlockSplitBloomFilter::optimalNumOfBytes(10, 0.001));
+  intBloomFilter.insertHash(intBloomFilter.hash(static_cast<int32_t>(5'000)));
+  ASSERT_TRUE(canUseBloomFilter(*equal, INTEGER(), thrift::Type::INT32));
+  EXPECT_TRUE(testBloomFilter(*equal, intBloomFilter, thrift::Type::INT32));
+  auto large = std::make_unique<common::BigintRange>(
+      (int64_t{1} << 32) + 5'000, (int64_t{1} << 32) + 5'000, false);
+  EXPECT_FALSE(testBloomFilter(*large, intBloomFilter, thrift::Type::INT32));
+
+  BlockSplitBloomFilter stringBloomFilter(leafPool_.get());
+  stringBloomFilter.init(BlockSplitBloomFilter::optimalNumOfBytes(10, 0.001));
+  for (const std::string_view value : {"apple", "banana", "cherry"}) {
+    ByteArray byteArray(value);
+    stringBloomFilter.insertHash(stringBloomFilter.hash(&byteArray));
+  }
+  const auto kByteArray = thrift::Type::BYTE_ARRAY;
+  auto stringEqual = std::make_unique<common::BytesRange>(
+      "banana", false, false, "banana", false, false, false);
+  ASSERT_TRUE(canUseBloomFilter(*stringEqual, VARCHAR(), kByteArray));
+  EXPECT_TRUE(testBloomFilter(*stringEqual, stringBloomFilter, kByteArray));
+  EXPECT_FALSE(canUseBloomFilter(*stringEqual, BIGINT(), kInt64));
+  auto stringIn = std::make_unique<common::BytesValues>(
+      std::vector<std::string>{"grape", "melon"}, false);
+  ASSERT_TRUE(canUseBloomFilter(*stringIn, VARCHAR(), kByteArray));
+  EXPECT_FALSE(testBloomFilter(*stringIn, stringBloomFilter, kByteArray));
+  stringIn = std::make_unique<common::BytesValues>(
+      std::vector<std::string>{"grape", "cherry"}, false);
+  EXPECT_TRUE(testBloomFilter(*stringIn, stringBloomFilter, kByteArray));
+}
+
+TEST_F(BloomFilterTest, readBloomFilter) {
+  // The bitset is larger than the speculative read of the header.
+  BlockSplitBloomFilter bloomFilter(leafPool_.get());
+  bloomFilter.init(4'096);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter.insertHash(bloomFilter.hash(i));
+  }
+  dwio::common::DataBufferHolder bufferHolder{*leafPool_.get(), 1'024};
+  dwio::common::AppendOnlyBufferedStream sink(
+      std::make_unique<dwio::common::BufferedOutputStream>(bufferHolder));
+  bloomFilter.writeTo(&sink);
+  sink.flush();
+
+  // Place the bloom filter after some other data.
+  constexpr int64_t kOffset = 100;
+  std::string data(kOffset, 'x');
+  for (auto& buffer : bufferHolder.getBuffers()) {
+    data.append(buffer.data(), buffer.size());
+  }
+  const auto filePath = tempPath_->getPath() + "/bloomFilter";
+  {
+    LocalWriteFile file(filePath);
+    file.append(data);
+    file.close();
+  }
+
+  dwio::common::BufferedInput input(
+      std::make_shared<LocalReadFile>(filePath), *leafPool_);
+  auto result = readBloomFilter(input, kOffset, *leafPool_);
+  EXPECT_EQ(result->getBitsetSize(), 4'096);
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(result->findHash(result->hash(i)));
+  }
+}
+
+TEST_F(BloomFilterTest, rowGroupSkipping) {
+  constexpr int32_t kNumRowGroups = 4;
+  constexpr int32_t kRowsPerRowGroup = 1'000;
+  const auto rowType = ROW({"a"}, {BIGINT()});
+  // Each row group has the even values in [0, 2 * kRowsPerRowGroup). Row
+  // group 2 also has 1'001, which is within the min/max range of all row
+  // groups but in the bloom filter of row group 2 only.
+  std::vector<std::vector<int64_t>> values(kNumRowGroups);
+  for (auto& rowGroup : values) {
+    for (auto row = 0; row < kRowsPerRowGroup; ++row) {
+      rowGroup.push_back(row * 2);
+    }
+  }
+  values[2][kRowsPerRowGroup / 2] = 1'001;
+
+  const auto filePath = tempPath_->getPath() + "/bloomFilter.parquet";
+  auto writer = createWriter(
+      createSink(filePath),
+      [&]() {
+        return std::make_unique<DefaultFlushPolicy>(kRowsPerRowGroup, 1 << 30);
+      },
+      rowType);
+  for (const auto& rowGroup : values) {
+    writer->write(makeRowVector({"a"}, {makeFlatVector<int64_t>(rowGroup)}));
+  }
+  writer->close();
+  const auto bloomFilterPath = addBloomFilters(filePath, values);
+
+  // Returns the number of rows that pass 'a = value' and the runtime stats.
+  auto read = [&](int64_t value) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(bloomFilterPath, readerOptions);
+    EXPECT_EQ(reader->fileMetaData().numRowGroups(), kNumRowGroups);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(
+        std::make_unique<common::BigintRange>(value, value, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    uint64_t numRows = 0;
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(1'000, result) > 0) {
+      numRows += result->size();
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return std::make_pair(numRows, stats);
+  };
+
+  // Only row group 2 is read.
+  auto [numRows, stats] = read(1'001);
+  EXPECT_EQ(numRows, 1);
+  EXPECT_EQ(stats.bloomFilterSkippedStrides, kNumRowGroups - 1);
+  EXPECT_EQ(stats.skippedStrides, kNumRowGroups - 1);
+
+  // No row group has 1'003.
+  std::tie(numRows, stats) = read(1'003);
+  EXPECT_EQ(numRows, 0);
+  EXPECT_EQ(stats.bloomFilterSkippedStrides, kNumRowGroups);
+  EXPECT_EQ(stats.skippedStrides, kNumRowGroups);
+
+  // All row groups have 4.
+  std::tie(numRows, stats) = read(4);
+  EXPECT_EQ(numRows, kNumRowGroups);
+  EXPECT_EQ(stats.bloomFilterSkippedStrides, 0);
+  EXPECT_EQ(stats.skippedStrides, 0);
+}
@@ -108,3 +108,26 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
       options.format.zlib.windowBits,
       dwio::common::compression::Compressor::PARQUET_ZLIB_WINDOW_BITS);
 }
+
+TEST(ByteStreamSplitTest, decode) {
+  // Covers the SIMD widths, FIXED_LEN_BYTE_ARRAY widths and tails that do
+  // not fill a SIMD batch.
+  for (auto width : {1, 2, 4, 8, 13, 16}) {
+    for (auto numValues : {0, 1, 7, 64, 100, 1'000}) {
+      std::vector<char> expected(numValues * width);
+      for (auto i = 0; i < expected.size(); ++i) {
+        expected[i] = static_cast<char>(i * 31 + i / width);
+      }
+      std::vector<char> encoded(expected.size());
+      for (auto i = 0; i < numValues; ++i) {
+        for (auto byte = 0; byte < width; ++byte) {
+          encoded[byte * numValues + i] = expected[i * width + byte];
+        }
+      }
+      std::vector<char> decoded(expected.size());
+      decodeByteStreamSplit(encoded.data(), numValues, width, decoded.data());
+      EXPECT_EQ(expected, decoded) << "width " << width << " numValues "
+                                   << numValues;
+    }
+  }
+}
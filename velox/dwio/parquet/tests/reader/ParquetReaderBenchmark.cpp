@@ -220,10 +220,11 @@ void run(
     float filterRateX100,
     uint8_t nullsRateX100,
     uint32_t nextSize,
-    bool disableDictionary) {
+    bool disableDictionary,
+    arrow::Encoding::type encoding) {
   RowTypePtr rowType = ROW({columnName}, {type});
   facebook::velox::parquet::test::ParquetReaderBenchmark benchmark(
-      disableDictionary, rowType);
+      disableDictionary, rowType, encoding);
   BIGINT()->toString();
   benchmark.readSingleColumn(
       columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
@@ -38,7 +38,8 @@ class ParquetReaderBenchmark {
  public:
   explicit ParquetReaderBenchmark(
       bool disableDictionary,
-      const facebook::velox::RowTypePtr& rowType)
+      const facebook::velox::RowTypePtr& rowType,
+      arrow::Encoding::type encoding = arrow::Encoding::PLAIN)
       : disableDictionary_(disableDictionary) {
     rootPool_ = facebook::velox::memory::memoryManager()->addRootPool(
         "ParquetReaderBenchmark");
@@ -52,9 +53,10 @@ class ParquetReaderBenchmark {
         std::move(localWriteFile), path);
     facebook::velox::parquet::WriterOptions options;
     if (disableDictionary_) {
-      // The parquet file is in plain encoding format.
+      // The values are written in 'encoding', PLAIN by default.
       options.enableDictionary = false;
     }
+    options.encoding = encoding;
     options.memoryPool = rootPool_.get();
     writer_ = std::make_unique<facebook::velox::parquet::Writer>(
         std::move(sink), options, rowType);
@@ -122,6 +124,7 @@ void run(
     float filterRateX100,
     uint8_t nullsRateX100,
     uint32_t nextSize,
-    bool disableDictionary);
+    bool disableDictionary,
+    arrow::Encoding::type encoding = arrow::Encoding::PLAIN);
 
 } // namespace facebook::velox::parquet::test
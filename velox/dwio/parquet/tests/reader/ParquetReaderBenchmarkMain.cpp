@@ -135,6 +135,31 @@ using namespace facebook::velox::test;
   PARQUET_BENCHMARKS_FILTERS(_type_, _name_, 100)    \
   BENCHMARK_DRAW_LINE();
 
+// Measures decoding the values of non-dictionary encodings with filters
+// evaluated during decoding.
+#define PARQUET_ENCODING_BENCHMARKS_FILTER_NULLS(                 \
+    _type_, _name_, _encoding_, _filter_, _null_)                 \
+  BENCHMARK_NAMED_PARAM(                                          \
+      run,                                                        \
+      _name_##_##_encoding_##_Filter_##_filter_##_Nulls_##_null_, \
+      #_name_,                                                    \
+      _type_,                                                     \
+      _filter_,                                                   \
+      _null_,                                                     \
+      10000,                                                      \
+      true,                                                       \
+      facebook::velox::parquet::arrow::Encoding::_encoding_);
+
+#define PARQUET_ENCODING_BENCHMARKS(_type_, _name_, _encoding_)              \
+  PARQUET_ENCODING_BENCHMARKS_FILTER_NULLS(_type_, _name_, _encoding_, 0, 0) \
+  PARQUET_ENCODING_BENCHMARKS_FILTER_NULLS(                                  \
+      _type_, _name_, _encoding_, 20, 0)                                     \
+  PARQUET_ENCODING_BENCHMARKS_FILTER_NULLS(                                  \
+      _type_, _name_, _encoding_, 100, 0)                                    \
+  PARQUET_ENCODING_BENCHMARKS_FILTER_NULLS(                                  \
+      _type_, _name_, _encoding_, 100, 50)                                   \
+  BENCHMARK_DRAW_LINE();
+
 PARQUET_BENCHMARKS(DECIMAL(18, 3), ShortDecimalType);
 PARQUET_BENCHMARKS(DECIMAL(38, 3), LongDecimalType);
 PARQUET_BENCHMARKS(VARCHAR(), Varchar);
@@ -144,6 +169,12 @@ PARQUET_BENCHMARKS(DOUBLE(), Double);
 PARQUET_BENCHMARKS_NO_FILTER(MAP(BIGINT(), BIGINT()), Map);
 PARQUET_BENCHMARKS_NO_FILTER(ARRAY(BIGINT()), List);
 
+PARQUET_ENCODING_BENCHMARKS(DOUBLE(), Double, PLAIN);
+PARQUET_ENCODING_BENCHMARKS(DOUBLE(), Double, BYTE_STREAM_SPLIT);
+PARQUET_ENCODING_BENCHMARKS(VARCHAR(), Varchar, PLAIN);
+PARQUET_ENCODING_BENCHMARKS(VARCHAR(), Varchar, DELTA_LENGTH_BYTE_ARRAY);
+PARQUET_ENCODING_BENCHMARKS(VARCHAR(), Varchar, DELTA_BYTE_ARRAY);
+
 // TODO: Add all data types
 
 int main(int argc, char** argv) {
@@ -28,6 +28,22 @@ TEST(ParquetReaderBenchmarkTest, basic) {
   run(5, "Varchar", VARCHAR(), 0, 0, 500, false);
   run(6, "Map", MAP(BIGINT(), BIGINT()), 100, 20, 500, false);
   run(7, "Array", ARRAY(BIGINT()), 100, 0, 500, false);
+  run(8,
+      "Double",
+      DOUBLE(),
+      5,
+      10,
+      500,
+      true,
+      arrow::Encoding::BYTE_STREAM_SPLIT);
+  run(9,
+      "Varchar",
+      VARCHAR(),
+      0,
+      0,
+      500,
+      true,
+      arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY);
 }
 } // namespace
 } // namespace facebook::velox::parquet::test
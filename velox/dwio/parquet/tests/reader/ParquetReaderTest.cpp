@@ -1556,3 +1556,61 @@ TEST_F(ParquetReaderTest, parquet251) {
   assertReadWithFilters(
       "parquet-251.parquet", rowType, std::move(filters), expected);
 }
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  constexpr int32_t kNumRows = 100'000;
+  auto rowType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  auto makeData = [&](int32_t size, int64_t firstRow) {
+    return makeRowVector(
+        {"a", "b"},
+        {makeFlatVector<int64_t>(
+             size, [&](auto row) { return firstRow + row; }),
+         makeFlatVector<std::string>(size, [&](auto row) {
+           return fmt::format("str{}", (firstRow + row) % 1'000);
+         })});
+  };
+
+  const auto filePath = tempPath_->getPath() + "/pageIndex.parquet";
+  WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 4 * 1'024;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(makeData(kNumRows, 0));
+  writer->close();
+
+  // Returns the number of rows skipped by the page index.
+  auto read = [&](bool pageIndexFilterEnabled) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setParquetPageIndexFilterEnabled(pageIndexFilterEnabled);
+    auto reader = createReader(filePath, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(
+        std::make_unique<BigintRange>(50'000, 50'099, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    // Rows outside of the pages that match the filter are not read, rows in
+    // the matching pages are filtered out row by row.
+    auto expected = makeData(100, 50'000);
+    uint64_t total = 0;
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(1'000, result) > 0) {
+      assertEqualVectorPart(expected, result, total);
+      total += result->size();
+    }
+    EXPECT_EQ(total, expected->size());
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedPageRows;
+  };
+
+  const auto skippedPageRows = read(true);
+  EXPECT_GT(skippedPageRows, kNumRows / 2);
+  EXPECT_LT(skippedPageRows, kNumRows);
+  EXPECT_EQ(read(false), 0);
+}
@@ -15,6 +15,7 @@
  */
 
 #include <arrow/type.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
@@ -146,6 +147,171 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, directVectorWrite) {
+  const vector_size_t kRows = 10'000;
+  const auto strings = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("string value {}", row); });
+  const auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row; }, nullEvery(7)),
+      wrapInDictionary(
+          makeIndices(kRows, [](auto row) { return (row * 17) % 100; }),
+          strings),
+      makeConstant<int64_t>(123, kRows),
+      makeFlatVector<int8_t>(kRows, [](auto row) { return row % 128; }),
+      makeFlatVector<bool>(
+          kRows, [](auto row) { return row % 3 == 0; }, nullEvery(11)),
+      makeArrayVector<int32_t>(
+          kRows, [](auto row) { return row % 5; }, [](auto i) { return i; }),
+      BaseVector::wrapInDictionary(
+          makeNulls(kRows, nullEvery(5)),
+          makeIndices(kRows, [](auto row) { return row % 10; }),
+          kRows,
+          makeFlatVector<double>(10, [](auto row) { return row * 0.5; })),
+      makeFlatVector<int32_t>(
+          kRows, [](auto row) { return 18'000 + row; }, nullptr, DATE()),
+      makeNullConstant(TypeKind::VARCHAR, kRows),
+  });
+  const auto schema = asRowType(data->type());
+
+  for (const bool enableDictionary : {true, false}) {
+    SCOPED_TRACE(fmt::format("enableDictionary {}", enableDictionary));
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.enableDictionary = enableDictionary;
+    writerOptions.enableDirectVectorWrite = true;
+    writerOptions.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(3'000, 1 << 30);
+    };
+
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    // The first row group spans the first two batches. The last batch is
+    // split between row groups.
+    writer->write(data->slice(0, 1'000));
+    writer->write(data->slice(1'000, 3'000));
+    writer->write(data->slice(4'000, kRows - 4'000));
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+    ASSERT_EQ(*reader->rowType(), *schema);
+
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
+TEST_F(ParquetWriterTest, directVectorWriteRetainedBytes) {
+  // Each batch is a dictionary of 100 rows over a base of about 1MB.
+  const auto base = makeFlatVector<std::string>(10'000, [](auto row) {
+    return fmt::format("{:0>100}", row);
+  });
+  const vector_size_t kRows = 500;
+  const auto data = makeRowVector({wrapInDictionary(
+      makeIndices(kRows, [](auto row) { return (row * 7) % 10'000; }),
+      base)});
+  const auto schema = asRowType(data->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableDirectVectorWrite = true;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(100'000, 512 << 10);
+  };
+
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (auto offset = 0; offset < kRows; offset += 100) {
+    writer->write(data->slice(offset, 100));
+  }
+  writer->close();
+
+  // The staged batches keep the base alive, so each one fills a row group
+  // although its rows are far below the byte limit.
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 5);
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, parallelEncoding) {
+  const vector_size_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kRows, [](auto row) { return row * 3; }, nullEvery(5)),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row % 300); }),
+      makeArrayVector<int32_t>(
+          kRows, [](auto row) { return row % 4; }, [](auto i) { return i; }),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 0.1; }),
+      makeRowVector({makeFlatVector<int32_t>(
+          kRows, [](auto row) { return row; }, nullEvery(7))}),
+  });
+  const auto schema = asRowType(data->type());
+
+  // Writes 'data' in several row groups and returns the file.
+  const auto writeFile = [&](std::shared_ptr<folly::Executor> executor,
+                             bool enableDirectVectorWrite) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.compressionKind = CompressionKind::CompressionKind_SNAPPY;
+    writerOptions.enableDirectVectorWrite = enableDirectVectorWrite;
+    writerOptions.encodingExecutor = executor;
+    writerOptions.encodingParallelismFactor = 4;
+    writerOptions.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(3'000, 1 << 30);
+    };
+
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data->slice(0, 5'000));
+    writer->write(data->slice(5'000, 5'000));
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  for (const bool enableDirectVectorWrite : {false, true}) {
+    SCOPED_TRACE(
+        fmt::format("enableDirectVectorWrite {}", enableDirectVectorWrite));
+    const auto expected = writeFile(nullptr, enableDirectVectorWrite);
+    const auto actual = writeFile(executor, enableDirectVectorWrite);
+    // The columns encoded in parallel produce the same file, with the column
+    // chunks in schema order.
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_TRUE(expected == actual);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = std::make_unique<facebook::velox::parquet::ParquetReader>(
+        std::make_unique<dwio::common::BufferedInput>(
+            std::make_shared<InMemoryReadFile>(actual), leafPool_.get()),
+        readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
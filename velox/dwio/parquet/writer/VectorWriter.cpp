@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/VectorWriter.h"
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T, typename P>
+P toParquet(const T& value) {
+  return static_cast<P>(value);
+}
+
+// Strings are referenced, not copied. The vector outlives the write.
+template <>
+arrow::ByteArray toParquet<StringView, arrow::ByteArray>(
+    const StringView& value) {
+  return arrow::ByteArray(
+      value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+}
+
+// Writes rows [begin, end) of 'vector' with Velox values of type 'T' to a
+// column of Parquet physical type 'DType'.
+template <typename T, typename DType>
+void writeTyped(
+    const VectorPtr& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    arrow::ColumnWriter& columnWriter) {
+  using P = typename DType::c_type;
+  auto& writer = static_cast<arrow::TypedColumnWriter<DType>&>(columnWriter);
+  const auto* descr = writer.descr();
+  VELOX_CHECK_EQ(descr->max_repetition_level(), 0);
+  const int16_t maxDefLevel = descr->max_definition_level();
+  const auto numRows = end - begin;
+
+  SelectivityVector rows(end, false);
+  rows.setValidRange(begin, end, true);
+  rows.updateBounds();
+  DecodedVector decoded(*vector, rows);
+
+  std::vector<int16_t> defLevels;
+  int64_t numNulls = 0;
+  if (decoded.mayHaveNulls()) {
+    VELOX_CHECK_GT(maxDefLevel, 0, "Nulls in a required column");
+    defLevels.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      const bool isNull = decoded.isNullAt(begin + i);
+      defLevels[i] = isNull ? maxDefLevel - 1 : maxDefLevel;
+      numNulls += isNull;
+    }
+  } else if (maxDefLevel > 0) {
+    defLevels.resize(numRows, maxDefLevel);
+  }
+  const int16_t* defLevelsData = defLevels.empty() ? nullptr : defLevels.data();
+
+  // Bit-packed booleans always take the copying path.
+  constexpr bool kSameLayout = std::is_same_v<T, P> && !std::is_same_v<T, bool>;
+  if constexpr (kSameLayout) {
+    if (decoded.isIdentityMapping() && numNulls == 0) {
+      writer.WriteBatch(
+          numRows, defLevelsData, nullptr, decoded.data<T>() + begin);
+      return;
+    }
+  }
+
+  if constexpr (!std::is_same_v<T, bool>) {
+    const auto baseSize = decoded.base()->size();
+    if (decoded.isConstantMapping() ||
+        (!decoded.isIdentityMapping() && baseSize <= numRows)) {
+      raw_vector<P> dictionary;
+      raw_vector<int32_t> indices;
+      indices.reserve(numRows - numNulls);
+      if (decoded.isConstantMapping()) {
+        if (numNulls < numRows) {
+          dictionary.push_back(toParquet<T, P>(decoded.valueAt<T>(begin)));
+        }
+        for (auto i = 0; i < numRows - numNulls; ++i) {
+          indices.push_back(0);
+        }
+      } else {
+        dictionary.resize(baseSize);
+        const auto* baseValues = decoded.data<T>();
+        for (auto i = 0; i < baseSize; ++i) {
+          dictionary[i] = toParquet<T, P>(baseValues[i]);
+        }
+        for (auto i = begin; i < end; ++i) {
+          if (numNulls == 0 || !decoded.isNullAt(i)) {
+            indices.push_back(decoded.index(i));
+          }
+        }
+      }
+      writer.WriteBatchDictionary(
+          numRows,
+          defLevelsData,
+          nullptr,
+          dictionary.data(),
+          dictionary.size(),
+          indices.data());
+      return;
+    }
+  }
+
+  raw_vector<P> values;
+  values.reserve(numRows - numNulls);
+  for (auto i = begin; i < end; ++i) {
+    if (numNulls == 0 || !decoded.isNullAt(i)) {
+      values.push_back(toParquet<T, P>(decoded.valueAt<T>(i)));
+    }
+  }
+  writer.WriteBatch(numRows, defLevelsData, nullptr, values.data());
+}
+
+} // namespace
+
+bool isDirectWriteSupported(const TypePtr& type) {
+  if (type->isDate()) {
+    return true;
+  }
+  // Excludes logical types like DECIMAL, INTERVAL DAY TO SECOND and JSON,
+  // which have a physical type of their own kind.
+  if (std::string_view(type->name()) != type->kindName()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void writeVector(
+    const VectorPtr& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    arrow::ColumnWriter& writer) {
+  VELOX_CHECK_LE(begin, end);
+  VELOX_CHECK_LE(end, vector->size());
+  switch (vector->typeKind()) {
+    case TypeKind::BOOLEAN:
+      return writeTyped<bool, arrow::BooleanType>(vector, begin, end, writer);
+    case TypeKind::TINYINT:
+      return writeTyped<int8_t, arrow::Int32Type>(vector, begin, end, writer);
+    case TypeKind::SMALLINT:
+      return writeTyped<int16_t, arrow::Int32Type>(vector, begin, end, writer);
+    case TypeKind::INTEGER:
+      return writeTyped<int32_t, arrow::Int32Type>(vector, begin, end, writer);
+    case TypeKind::BIGINT:
+      return writeTyped<int64_t, arrow::Int64Type>(vector, begin, end, writer);
+    case TypeKind::REAL:
+      return writeTyped<float, arrow::FloatType>(vector, begin, end, writer);
+    case TypeKind::DOUBLE:
+      return writeTyped<double, arrow::DoubleType>(vector, begin, end, writer);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return writeTyped<StringView, arrow::ByteArrayType>(
+          vector, begin, end, writer);
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type for direct Parquet write: {}",
+          vector->type()->toString());
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace arrow {
+class ColumnWriter;
+} // namespace arrow
+
+/// Returns true if a top level column of 'type' can be written with
+/// writeVector(), i.e. without converting it to an Arrow array first. These
+/// are the primitive types whose Velox values map to the Parquet physical
+/// values without a change of unit.
+bool isDirectWriteSupported(const TypePtr& type);
+
+/// Writes rows [begin, end) of 'vector' to the column chunk of 'writer'. The
+/// type of 'vector' must pass isDirectWriteSupported(). Flat values without
+/// nulls are passed to the column writer as is. Dictionary and constant
+/// vectors are passed as indices into their distinct values, so that a
+/// dictionary encoded column hashes each distinct value once instead of once
+/// per row.
+void writeVector(
+    const VectorPtr& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    arrow::ColumnWriter& writer);
+
+} // namespace facebook::velox::parquet
@@ -22,6 +22,8 @@
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/dwio/common/ParallelFor.h"
+#include "velox/dwio/parquet/writer/VectorWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -105,6 +107,16 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // Whether each column is written from Velox vectors with writeVector().
+  // Empty if no column is.
+  std::vector<bool> directColumns;
+  // columns, Velox vectors of the columns in 'directColumns'.
+  std::vector<std::vector<VectorPtr>> stagingVectors;
+  // Executor for writing the columns of a row group in parallel. The row
+  // groups are then buffered, so that the column chunks come out in schema
+  // order whatever the order of the writes.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 };
 
 Compression::type getArrowParquetCompression(
@@ -143,6 +155,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -216,6 +231,30 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Writes rows [offset, offset + size) of the concatenation of 'vectors' to
+// 'writer'.
+void writeStagedVectors(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    arrow::ColumnWriter& writer) {
+  int64_t start = 0;
+  for (const auto& vector : vectors) {
+    const int64_t end = start + vector->size();
+    if (end > offset && start < offset + size) {
+      writeVector(
+          vector,
+          std::max<int64_t>(offset - start, 0),
+          std::min<int64_t>(offset + size, end) - start,
+          writer);
+    }
+    if (end >= offset + size) {
+      break;
+    }
+    start = end;
+  }
+}
+
 std::optional<TimestampPrecision> getTimestampUnit(
     const config::ConfigBase& config,
     const char* configKey) {
@@ -268,6 +307,23 @@ Writer::Writer(
       getArrowParquetWriterOptions(options, flushPolicy_);
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
+  if (options.encodingExecutor != nullptr &&
+      options.encodingParallelismFactor > 1) {
+    arrowContext_->encodingExecutor = options.encodingExecutor;
+    arrowContext_->encodingParallelismFactor =
+        options.encodingParallelismFactor;
+  }
+  if (options.enableDirectVectorWrite) {
+    std::vector<bool> directColumns;
+    for (const auto& type : schema_->children()) {
+      directColumns.push_back(isDirectWriteSupported(type));
+    }
+    if (std::find(directColumns.begin(), directColumns.end(), true) !=
+        directColumns.end()) {
+      arrowContext_->directColumns = std::move(directColumns);
+      arrowContext_->stagingVectors.resize(schema_->size());
+    }
+  }
 }
 
 Writer::Writer(
@@ -289,6 +345,10 @@ void Writer::flush() {
       if (writeInt96AsTimestamp_) {
         builder.enable_deprecated_int96_timestamps();
       }
+      if (arrowContext_->encodingExecutor != nullptr) {
+        // Gives each column a write context of its own.
+        builder.set_use_threads(true);
+      }
       auto arrowProperties = builder.build();
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
@@ -301,8 +361,13 @@ void Writer::flush() {
     }
 
     auto fields = arrowContext_->schema->fields();
+    const auto& directColumns = arrowContext_->directColumns;
     std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+      if (!directColumns.empty() && directColumns[colIdx]) {
+        chunks.push_back(nullptr);
+        continue;
+      }
       auto dataType = fields.at(colIdx)->type();
       auto chunk =
           ::arrow::ChunkedArray::Make(
@@ -310,16 +375,65 @@ void Writer::flush() {
               .ValueOrDie();
       chunks.push_back(chunk);
     }
-    auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
-        std::move(chunks),
-        static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
+    const auto numRows = static_cast<int64_t>(arrowContext_->stagingRows);
+    const auto rowGroupRows =
+        static_cast<int64_t>(flushPolicy_->rowsInRowGroup());
+    if (arrowContext_->encodingExecutor != nullptr) {
+      auto& writer = arrowContext_->writer;
+      for (int64_t offset = 0; offset < numRows; offset += rowGroupRows) {
+        const auto size = std::min(rowGroupRows, numRows - offset);
+        PARQUET_THROW_NOT_OK(writer->NewBufferedRowGroup());
+        dwio::common::ParallelFor(
+            arrowContext_->encodingExecutor,
+            0,
+            fields.size(),
+            arrowContext_->encodingParallelismFactor)
+            .execute([&](size_t colIdx) {
+              if (!directColumns.empty() && directColumns[colIdx]) {
+                writeStagedVectors(
+                    arrowContext_->stagingVectors[colIdx],
+                    offset,
+                    size,
+                    *writer->BufferedColumn(colIdx));
+              } else {
+                PARQUET_THROW_NOT_OK(writer->WriteBufferedColumnChunk(
+                    chunks[colIdx], offset, size, colIdx));
+              }
+            });
+      }
+    } else if (directColumns.empty()) {
+      auto table = ::arrow::Table::Make(
+          arrowContext_->schema, std::move(chunks), numRows);
+      PARQUET_THROW_NOT_OK(
+          arrowContext_->writer->WriteTable(*table, rowGroupRows));
+    } else {
+      // Same row groups as WriteTable(). The columns are written in schema
+      // order, from Velox vectors or from Arrow arrays.
+      auto& writer = arrowContext_->writer;
+      for (int64_t offset = 0; offset < numRows; offset += rowGroupRows) {
+        const auto size = std::min(rowGroupRows, numRows - offset);
+        PARQUET_THROW_NOT_OK(writer->NewRowGroup(size));
+        for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+          if (directColumns[colIdx]) {
+            writeStagedVectors(
+                arrowContext_->stagingVectors[colIdx],
+                offset,
+                size,
+                *writer->NextColumn());
+          } else {
+            PARQUET_THROW_NOT_OK(
+                writer->WriteColumnChunk(chunks[colIdx], offset, size));
+          }
+        }
+      }
+    }
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
     }
+    for (auto& vectors : arrowContext_->stagingVectors) {
+      vectors.clear();
+    }
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
   }
@@ -345,9 +459,7 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
-  ArrowArray array;
   ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
   exportToArrow(data, schema, options_);
 
   // Convert the arrow schema to Schema and then update the column names based
@@ -362,11 +474,8 @@ void Writer::write(const VectorPtr& data) {
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
   }
 
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
   if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
+    arrowContext_->schema = ::arrow::schema(newFields);
     for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
          colIdx++) {
       arrowContext_->stagingChunks.push_back(
@@ -374,16 +483,70 @@ void Writer::write(const VectorPtr& data) {
     }
   }
 
-  auto bytes = data->estimateFlatSize();
   auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
           arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
     flush();
   }
 
-  for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
-    arrowContext_->stagingChunks.at(colIdx).push_back(
-        recordBatch->column(colIdx));
+  int64_t bytes = 0;
+  const auto& directColumns = arrowContext_->directColumns;
+  if (directColumns.empty()) {
+    bytes = data->estimateFlatSize();
+    ArrowArray array;
+    exportToArrow(data, array, generalPool_.get(), options_);
+    PARQUET_ASSIGN_OR_THROW(
+        auto recordBatch,
+        ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+    for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
+      arrowContext_->stagingChunks.at(colIdx).push_back(
+          recordBatch->column(colIdx));
+    }
+  } else {
+    auto* input = data->as<RowVector>();
+    VELOX_CHECK_NOT_NULL(
+        input, "Direct vector write expects a RowVector: {}", data->toString());
+    // Stages the direct columns as is and exports the others to Arrow.
+    std::vector<column_index_t> arrowColumns;
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    std::vector<VectorPtr> children;
+    std::vector<std::shared_ptr<::arrow::Field>> arrowFields;
+    for (auto i = 0; i < childSize; ++i) {
+      const auto& child = BaseVector::loadedVectorShared(input->childAt(i));
+      if (directColumns[i]) {
+        // The staged vector keeps all its buffers alive until the row group
+        // is flushed, e.g. the whole base of a dictionary. These are counted
+        // towards the row group size, not only the flat size of the rows.
+        // Buffers shared by several batches are counted once per batch.
+        bytes += child->retainedSize();
+        arrowContext_->stagingVectors[i].push_back(child);
+        continue;
+      }
+      bytes += child->estimateFlatSize();
+      arrowColumns.push_back(i);
+      names.push_back(schema_->nameOf(i));
+      types.push_back(schema_->childAt(i));
+      children.push_back(child);
+      arrowFields.push_back(newFields[i]);
+    }
+    if (!arrowColumns.empty()) {
+      auto arrowInput = std::make_shared<RowVector>(
+          generalPool_.get(),
+          ROW(std::move(names), std::move(types)),
+          nullptr,
+          numRows,
+          std::move(children));
+      ArrowArray array;
+      exportToArrow(arrowInput, array, generalPool_.get(), options_);
+      PARQUET_ASSIGN_OR_THROW(
+          auto recordBatch,
+          ::arrow::ImportRecordBatch(&array, ::arrow::schema(arrowFields)));
+      for (auto i = 0; i < arrowColumns.size(); ++i) {
+        arrowContext_->stagingChunks.at(arrowColumns[i]).push_back(
+            recordBatch->column(i));
+      }
+    }
   }
   arrowContext_->stagingRows += numRows;
   arrowContext_->stagingBytes += bytes;
@@ -408,6 +571,7 @@ void Writer::close() {
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -91,6 +91,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  // Whether to write the ColumnIndex and OffsetIndex of each column chunk.
+  // Readers use these to skip pages that can not pass filters.
+  bool enablePageIndex = false;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
@@ -108,6 +111,12 @@ struct WriterOptions : public dwio::common::WriterOptions {
   /// Timestamp time zone for Parquet write through Arrow bridge.
   std::optional<std::string> parquetWriteTimestampTimeZone;
   bool writeInt96AsTimestamp = false;
+  /// Whether to write the top level columns of primitive type straight from
+  /// the Velox vectors, without exporting them to Arrow arrays first. See
+  /// isDirectWriteSupported() for the types. Dictionary and constant vectors
+  /// keep their encoding up to the Parquet dictionary encoder. The other
+  /// columns are written through Arrow. The input must be a RowVector.
+  bool enableDirectVectorWrite = false;
 
   // Parsing session and hive configs.
 
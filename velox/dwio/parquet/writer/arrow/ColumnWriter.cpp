@@ -1538,6 +1538,93 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     return value_offset;
   }
 
+  int64_t WriteBatchDictionary(
+      int64_t num_values,
+      const int16_t* def_levels,
+      const int16_t* rep_levels,
+      const T* dictionary,
+      int32_t dictionary_size,
+      const int32_t* indices) override {
+    // Index in the column dictionary of each entry of 'dictionary', -1 until
+    // the entry is first used.
+    std::vector<int32_t> dictionary_map(dictionary_size, -1);
+    // Number of the last chunk that used each entry of 'dictionary'. The
+    // statistics of a chunk are updated once per distinct entry.
+    std::vector<int64_t> entry_chunk(dictionary_size, -1);
+    std::vector<int32_t> chunk_indices;
+    std::vector<int32_t> chunk_entries;
+    std::shared_ptr<ResizableBuffer> values_buffer = AllocateBuffer(allocator_);
+
+    // Copies the entries of 'dictionary' referenced by 'entries' to
+    // 'values_buffer'.
+    auto GatherValues = [&](const int32_t* entries, int64_t size) {
+      PARQUET_THROW_NOT_OK(values_buffer->Resize(size * sizeof(T), false));
+      auto* values = reinterpret_cast<T*>(values_buffer->mutable_data());
+      for (int64_t i = 0; i < size; ++i) {
+        values[i] = dictionary[entries[i]];
+      }
+      return static_cast<const T*>(values);
+    };
+
+    int64_t value_offset = 0;
+    int64_t chunk = 0;
+    auto WriteChunk = [&](int64_t offset, int64_t batch_size, bool check_page) {
+      int64_t values_to_write = WriteLevels(
+          batch_size,
+          AddIfNotNull(def_levels, offset),
+          AddIfNotNull(rep_levels, offset));
+      const int64_t num_nulls = batch_size - values_to_write;
+      const int32_t* batch_entries = indices + value_offset;
+
+      if (current_dict_encoder_ == nullptr) {
+        // Not dictionary encoding or fell back to plain encoding.
+        WriteValues(
+            GatherValues(batch_entries, values_to_write),
+            values_to_write,
+            num_nulls);
+      } else {
+        chunk_indices.resize(values_to_write);
+        chunk_entries.clear();
+        for (int64_t i = 0; i < values_to_write; ++i) {
+          const int32_t entry = batch_entries[i];
+          if (dictionary_map[entry] < 0) {
+            dictionary_map[entry] =
+                current_dict_encoder_->GetOrInsert(dictionary[entry]);
+          }
+          if (entry_chunk[entry] != chunk) {
+            entry_chunk[entry] = chunk;
+            chunk_entries.push_back(entry);
+          }
+          chunk_indices[i] = dictionary_map[entry];
+        }
+        current_dict_encoder_->PutIndices(
+            chunk_indices.data(), static_cast<int>(values_to_write));
+        if (page_statistics_ != nullptr) {
+          const auto num_entries = static_cast<int64_t>(chunk_entries.size());
+          page_statistics_->Update(
+              GatherValues(chunk_entries.data(), num_entries),
+              num_entries,
+              num_nulls);
+          page_statistics_->IncrementNumValues(values_to_write - num_entries);
+        }
+      }
+      CommitWriteAndCheckPageLimit(
+          batch_size, values_to_write, num_nulls, check_page);
+      value_offset += values_to_write;
+      ++chunk;
+
+      CheckDictionarySizeLimit();
+    };
+    DoInBatches(
+        def_levels,
+        rep_levels,
+        num_values,
+        properties_->write_batch_size(),
+        WriteChunk,
+        pages_change_on_record_boundaries());
+    return value_offset;
+  }
+
   void WriteBatchSpaced(
       int64_t num_values,
       const int16_t* def_levels,
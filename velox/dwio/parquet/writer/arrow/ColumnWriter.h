@@ -270,6 +270,22 @@ class TypedColumnWriter : public ColumnWriter {
       int64_t valid_bits_offset,
       const T* values) = 0;
 
+  /// Write a batch of levels and values given as indices into 'dictionary',
+  /// e.g. the values of a dictionary encoded Velox vector. The levels are as
+  /// in WriteBatch(). 'indices' has one entry per defined value. If the
+  /// column is dictionary encoded, each entry of 'dictionary' is added to the
+  /// column dictionary once per call instead of hashing every value, and
+  /// the indices are translated to the column dictionary.
+  ///
+  /// Returns the number of values written, as WriteBatch().
+  virtual int64_t WriteBatchDictionary(
+      int64_t num_values,
+      const int16_t* def_levels,
+      const int16_t* rep_levels,
+      const T* dictionary,
+      int32_t dictionary_size,
+      const int32_t* indices) = 0;
+
   // Estimated size of the values that are not written to a page yet
   virtual int64_t EstimatedBufferedValueBytes() const = 0;
 };
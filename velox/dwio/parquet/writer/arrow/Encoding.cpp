@@ -620,6 +620,19 @@ class DictEncoderImpl : public EncoderImpl, virtual public DictEncoder<DType> {
     }
   }
 
+  void PutIndices(const int32_t* indices, int num_values) override {
+    buffered_indices_.insert(
+        buffered_indices_.end(), indices, indices + num_values);
+  }
+
+  int32_t GetOrInsert(const T& value) override {
+    // Put() takes care of the dictionary size of a new value.
+    Put(value);
+    const int32_t memo_index = buffered_indices_.back();
+    buffered_indices_.pop_back();
+    return memo_index;
+  }
+
   std::shared_ptr<::arrow::Buffer> FlushValues() override {
     std::shared_ptr<ResizableBuffer> buffer =
         AllocateBuffer(this->pool_, EstimatedDataEncodedSize());
@@ -250,6 +250,14 @@ class DictEncoder : virtual public TypedEncoder<DType> {
   /// \param[in] values the dictionary values. Only valid for certain
   /// Parquet/Arrow type combinations, like BYTE_ARRAY/BinaryArray
   virtual void PutDictionary(const ::arrow::Array& values) = 0;
+
+  /// \brief Append dictionary indices into the encoder. The indices must
+  /// reference pre-existing dictionary values, e.g. from GetOrInsert().
+  virtual void PutIndices(const int32_t* indices, int num_values) = 0;
+
+  /// \brief Return the dictionary index of 'value', adding it to the
+  /// dictionary if not present. Does not append an index to the encoder.
+  virtual int32_t GetOrInsert(const typename DType::c_type& value) = 0;
 };
 
 // ----------------------------------------------------------------------
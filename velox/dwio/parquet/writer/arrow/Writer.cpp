@@ -329,6 +329,12 @@ class FileWriterImpl : public FileWriter {
   }
 
   Status Init() {
+    field_leaf_starts_.reserve(schema_->num_fields());
+    int leaf_start = 0;
+    for (const auto& field : schema_->fields()) {
+      field_leaf_starts_.push_back(leaf_start);
+      leaf_start += CalculateLeafCount(field->type().get());
+    }
     return SchemaManifest::Make(
         writer_->schema(),
         /*schema_metadata=*/nullptr,
@@ -389,6 +395,14 @@ class FileWriterImpl : public FileWriter {
     return WriteColumnChunk(data, 0, data->length());
   }
 
+  ColumnWriter* NextColumn() override {
+    if (row_group_writer_ == nullptr || row_group_writer_->buffered()) {
+      throw ParquetException(
+          "Cannot write column chunk without a non-buffered row group.");
+    }
+    return row_group_writer_->NextColumn();
+  }
+
   std::shared_ptr<::arrow::Schema> schema() const override {
     return schema_;
   }
@@ -441,6 +455,38 @@ class FileWriterImpl : public FileWriter {
     return Status::OK();
   }
 
+  Status WriteBufferedColumnChunk(
+      const std::shared_ptr<ChunkedArray>& data,
+      int64_t offset,
+      int64_t size,
+      int field_index) override {
+    if (row_group_writer_ == nullptr || !row_group_writer_->buffered()) {
+      return Status::Invalid(
+          "Cannot write buffered column chunk without a buffered row group.");
+    }
+    ARROW_ASSIGN_OR_RAISE(
+        std::unique_ptr<ArrowColumnWriterV2> writer,
+        ArrowColumnWriterV2::Make(
+            *data,
+            offset,
+            size,
+            schema_manifest_,
+            row_group_writer_,
+            field_leaf_starts_[field_index]));
+    if (arrow_properties_->use_threads()) {
+      return writer->Write(&parallel_column_write_contexts_[field_index]);
+    }
+    return writer->Write(&column_write_context_);
+  }
+
+  ColumnWriter* BufferedColumn(int field_index) override {
+    if (row_group_writer_ == nullptr || !row_group_writer_->buffered()) {
+      throw ParquetException(
+          "Cannot write buffered column chunk without a buffered row group.");
+    }
+    return row_group_writer_->column(field_leaf_starts_[field_index]);
+  }
+
   Status WriteRecordBatch(const RecordBatch& batch) override {
     if (batch.num_rows() == 0) {
       return Status::OK();
@@ -537,6 +583,9 @@ class FileWriterImpl : public FileWriter {
   /// schema_->num_fields() to make it thread-safe. Otherwise, the vector is
   /// empty and column_write_context_ above is shared by all columns.
   std::vector<ArrowWriteContext> parallel_column_write_contexts_;
+
+  /// Index of the first leaf column of each top level field.
+  std::vector<int> field_leaf_starts_;
 };
 
 FileWriter::~FileWriter() {}
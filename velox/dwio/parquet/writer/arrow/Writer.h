@@ -36,6 +36,7 @@ class Table;
 
 namespace facebook::velox::parquet::arrow {
 
+class ColumnWriter;
 class FileMetaData;
 class ParquetFileWriter;
 
@@ -128,11 +129,34 @@ class PARQUET_EXPORT FileWriter {
   virtual ::arrow::Status WriteColumnChunk(
       const std::shared_ptr<::arrow::ChunkedArray>& data) = 0;
 
+  /// \brief Return the writer of the next column of the row group started
+  /// with NewRowGroup, for writing the column chunk without converting it to
+  /// an Arrow array. The column chunks are written in schema order, so the
+  /// writer of a column is only valid until the next call.
+  virtual ColumnWriter* NextColumn() = 0;
+
   /// \brief Start a new buffered row group.
   ///
   /// Returns an error if not all columns have been written.
   virtual ::arrow::Status NewBufferedRowGroup() = 0;
 
+  /// \brief Write a slice of a ChunkedArray to the columns of the top level
+  /// field 'field_index' in the buffered row group.
+  ///
+  /// If ArrowWriterProperties::use_threads() is true, calls for different
+  /// fields may run concurrently. The column chunks are written in schema
+  /// order when the row group is closed.
+  virtual ::arrow::Status WriteBufferedColumnChunk(
+      const std::shared_ptr<::arrow::ChunkedArray>& data,
+      int64_t offset,
+      int64_t size,
+      int field_index) = 0;
+
+  /// \brief Return the writer of the column of the primitive top level field
+  /// 'field_index' in the buffered row group. Writers of different fields
+  /// may be used concurrently.
+  virtual ColumnWriter* BufferedColumn(int field_index) = 0;
+
   /// \brief Write a RecordBatch into the buffered row group.
   ///
   /// Multiple RecordBatches can be written into the same row group
@@ -664,6 +664,18 @@ class DictEncoderImpl : public EncoderImpl, virtual public DictEncoder<DType> {
     }
   }
 
+  void PutIndices(const int32_t* indices, int num_values) override {
+    buffered_indices_.insert(
+        buffered_indices_.end(), indices, indices + num_values);
+  }
+
+  int32_t GetOrInsert(const T& value) override {
+    Put(value);
+    const int32_t memo_index = buffered_indices_.back();
+    buffered_indices_.pop_back();
+    return memo_index;
+  }
+
   std::shared_ptr<Buffer> FlushValues() override {
     std::shared_ptr<ResizableBuffer> buffer =
         AllocateBuffer(this->pool_, EstimatedDataEncodedSize());
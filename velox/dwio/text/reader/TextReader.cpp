@@ -0,0 +1,743 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <folly/Conv.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/dwio/common/TypeWithId.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+using dwio::common::Mutation;
+using dwio::common::RowReader;
+
+namespace {
+
+// Bytes read from the file at a time. A buffer grows beyond this if a single
+// row does not fit.
+constexpr uint64_t kReadSize = 1 << 20;
+
+// A field of the rows of the current batch. 'size' is negative if the row has
+// no such field. 'escaped' is true if the field contains escape characters.
+struct Field {
+  const char* data;
+  int32_t size;
+  bool escaped;
+};
+
+// Returns true if the 8 bytes of 'chunk' are all ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of the 8 ASCII digits of 'chunk', the first digit being in
+// the lowest byte.
+inline uint64_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+}
+
+// Parses a decimal integer with an optional sign. Takes 8 digits at a time.
+// Returns false if the text is not an integer or does not fit in T.
+template <typename T>
+bool parseInteger(const char* data, int32_t size, T& result) {
+  const bool negative = size > 0 && data[0] == '-';
+  int32_t i = (size > 0 && (data[0] == '-' || data[0] == '+')) ? 1 : 0;
+  const int32_t numDigits = size - i;
+  if (numDigits == 0) {
+    return false;
+  }
+  if (numDigits > std::numeric_limits<uint64_t>::digits10) {
+    // Leading zeros or out of range.
+    auto value = folly::tryTo<T>(folly::StringPiece(data, size));
+    if (value.hasError()) {
+      return false;
+    }
+    result = value.value();
+    return true;
+  }
+  uint64_t magnitude = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    magnitude = magnitude * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  const uint64_t maxMagnitude =
+      static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative;
+  if (magnitude > maxMagnitude) {
+    return false;
+  }
+  result = negative ? static_cast<T>(static_cast<int64_t>(0 - magnitude))
+                    : static_cast<T>(magnitude);
+  return true;
+}
+
+bool parseBoolean(const char* data, int32_t size, bool& result) {
+  if (size == 4 && strncasecmp(data, "true", 4) == 0) {
+    result = true;
+    return true;
+  }
+  if (size == 5 && strncasecmp(data, "false", 5) == 0) {
+    result = false;
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool parseFloatingPoint(const char* data, int32_t size, T& result) {
+  auto value = folly::tryTo<T>(folly::StringPiece(data, size));
+  if (value.hasError()) {
+    return false;
+  }
+  result = value.value();
+  return true;
+}
+
+void checkSupportedType(const std::string& name, const TypePtr& type) {
+  VELOX_CHECK(
+      !type->isDecimal(),
+      "{} is not supported yet in TextReader: {}",
+      type->toString(),
+      name);
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return;
+    default:
+      VELOX_NYI(
+          "{} is not supported yet in TextReader: {}", type->toString(), name);
+  }
+}
+
+class TextRowReader : public RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<ReadFile> file,
+      const RowTypePtr& fileType,
+      const dwio::common::SerDeOptions& serDeOptions,
+      const dwio::common::RowReaderOptions& options,
+      memory::MemoryPool* pool);
+
+  uint64_t next(uint64_t size, VectorPtr& result, const Mutation* mutation)
+      override;
+
+  /// Returns the number of rows read so far. This is relative to the start of
+  /// the byte range since the rows before the range are not counted.
+  int64_t nextRowNumber() override {
+    return hasMoreRows() ? rowNumber_ : kAtEnd;
+  }
+
+  /// The number of rows is only known after reading them, so 'size' is
+  /// returned unless at end.
+  int64_t nextReadSize(uint64_t size) override {
+    return hasMoreRows() ? size : kAtEnd;
+  }
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override;
+
+ private:
+  // Positions the reader on the first row of the range and skips the header
+  // rows.
+  void initialize();
+
+  // Returns true if a row starts before the end of the range.
+  bool hasMoreRows();
+
+  // Reads more of the file into a new buffer that starts with the unconsumed
+  // bytes of the current one. The current buffer stays valid for the fields
+  // of the batch. Returns false at end of file.
+  bool loadBuffer();
+
+  // Moves 'pos_' past the next newline. Returns false if the file ends first.
+  bool skipLine();
+
+  // Splits the rows starting at 'pos_' into fields until there are 'maxRows'
+  // rows in the batch, the next row starts after the range or the buffer ends
+  // within a row. A row at the end of the file needs no newline. Returns the
+  // number of rows in the batch. 'numRows' is the number before the call.
+  vector_size_t tokenize(vector_size_t maxRows, vector_size_t numRows);
+
+  void addField(
+      column_index_t field,
+      const char* data,
+      int32_t size,
+      bool escaped) {
+    if (field < slots_.size() && slots_[field] >= 0) {
+      fields_[slots_[field]].push_back({data, size, escaped});
+    }
+  }
+
+  // Adds a null field to the columns that 'numRows'th row did not have.
+  void finishRow(vector_size_t numRows) {
+    for (auto& fields : fields_) {
+      if (fields.size() == numRows) {
+        fields.push_back({nullptr, -1, false});
+      }
+    }
+  }
+
+  bool isNull(const Field& field, bool isString) const {
+    return field.size < 0 || (field.size == 0 && !isString) ||
+        (field.size == nullString_.size() &&
+         memcmp(field.data, nullString_.data(), field.size) == 0);
+  }
+
+  // Returns the text of 'field' without escape characters.
+  std::string_view unescape(const Field& field, std::string& scratch) const;
+
+  // Makes a vector of 'type' from the fields of 'column'.
+  VectorPtr decodeColumn(column_index_t column, const TypePtr& type);
+
+  template <typename T, typename Parse>
+  VectorPtr decodeFlat(column_index_t column, const TypePtr& type, Parse parse);
+
+  VectorPtr decodeString(column_index_t column, const TypePtr& type);
+
+  const std::shared_ptr<ReadFile> file_;
+  memory::MemoryPool* const pool_;
+  const uint64_t fileSize_;
+  const uint64_t offset_;
+  const uint64_t limit_;
+  const uint64_t skipRows_;
+  const char fieldDelimiter_;
+  const char escapeChar_;
+  const bool isEscaped_;
+  const bool lastColumnTakesRest_;
+  const std::string nullString_;
+  const column_index_t numFileColumns_;
+  std::shared_ptr<common::ScanSpec> scanSpec_;
+
+  // The type of the columns that are read, in the order of 'fields_'.
+  RowTypePtr readType_;
+
+  // For each field of a row the index into 'fields_', or -1 if the field is
+  // not read.
+  std::vector<int32_t> slots_;
+
+  // The fields of the rows of the current batch, one vector per read column.
+  std::vector<std::vector<Field>> fields_;
+
+  // True for the read columns that are not in the file schema. These are
+  // null in all rows.
+  std::vector<bool> isMissing_;
+
+  bool initialized_{false};
+
+  // The buffer with the bytes at [bufferOffset_, bufferOffset_ + bufferSize_)
+  // of the file.
+  BufferPtr buffer_;
+  const char* bufferData_{nullptr};
+  uint64_t bufferOffset_{0};
+  int32_t bufferSize_{0};
+
+  // Offset in 'buffer_' of the next row.
+  int32_t pos_{0};
+
+  // File offset of the first byte not yet read into a buffer.
+  uint64_t filePos_{0};
+
+  // File offset of the first row of the range.
+  uint64_t firstRowOffset_{0};
+
+  // The buffers the fields of the current batch point into.
+  std::vector<BufferPtr> batchBuffers_;
+
+  int64_t rowNumber_{0};
+};
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<ReadFile> file,
+    const RowTypePtr& fileType,
+    const dwio::common::SerDeOptions& serDeOptions,
+    const dwio::common::RowReaderOptions& options,
+    memory::MemoryPool* pool)
+    : file_(std::move(file)),
+      pool_(pool),
+      fileSize_(file_->size()),
+      offset_(std::min(options.offset(), fileSize_)),
+      limit_(std::min(options.limit(), fileSize_)),
+      skipRows_(options.skipRows()),
+      fieldDelimiter_(serDeOptions.separators[static_cast<int>(
+          dwio::common::SerDeSeparator::FIELD_DELIM)]),
+      escapeChar_(serDeOptions.escapeChar),
+      isEscaped_(serDeOptions.isEscaped),
+      lastColumnTakesRest_(serDeOptions.lastColumnTakesRest),
+      nullString_(serDeOptions.nullString),
+      numFileColumns_(fileType->size()),
+      scanSpec_(options.scanSpec()),
+      slots_(fileType->size(), -1) {
+  VELOX_CHECK_NE(fieldDelimiter_, '\n', "Field delimiter can not be newline");
+  if (scanSpec_ == nullptr) {
+    scanSpec_ = std::make_shared<common::ScanSpec>("<root>");
+    scanSpec_->addAllChildFields(
+        options.requestedType() ? *options.requestedType() : *fileType);
+  }
+  // Only the fields of the columns in the scan spec are materialized. The
+  // others are skipped over by the tokenizer.
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  const auto& requestedType = options.requestedType();
+  for (const auto& child : scanSpec_->children()) {
+    if (child->isConstant()) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    const auto index = fileType->getChildIdxIfExists(name);
+    if (!index.has_value()) {
+      // A column after the last one of the file schema, e.g. one added to the
+      // table after the file was written, is missing from every row.
+      const auto requestedIndex = requestedType
+          ? requestedType->getChildIdxIfExists(name)
+          : std::nullopt;
+      isMissing_.push_back(true);
+      names.push_back(name);
+      types.push_back(
+          requestedIndex.has_value()
+              ? requestedType->childAt(requestedIndex.value())
+              : UNKNOWN());
+      continue;
+    }
+    const auto& type = fileType->childAt(index.value());
+    checkSupportedType(name, type);
+    slots_[index.value()] = names.size();
+    isMissing_.push_back(false);
+    names.push_back(name);
+    types.push_back(type);
+  }
+  readType_ = ROW(std::move(names), std::move(types));
+  fields_.resize(readType_->size());
+}
+
+void TextRowReader::initialize() {
+  initialized_ = true;
+  filePos_ = offset_;
+  if (offset_ > 0) {
+    // A row belongs to the range its first byte is in. Start one byte early so
+    // that a row starting at 'offset_' is found after the preceding newline.
+    filePos_ = offset_ - 1;
+    bufferOffset_ = filePos_;
+    skipLine();
+  } else {
+    for (uint64_t i = 0; i < skipRows_; ++i) {
+      if (!skipLine()) {
+        break;
+      }
+    }
+  }
+  firstRowOffset_ = bufferOffset_ + pos_;
+}
+
+bool TextRowReader::hasMoreRows() {
+  if (!initialized_) {
+    initialize();
+  }
+  if (pos_ >= bufferSize_ && !loadBuffer()) {
+    return false;
+  }
+  return bufferOffset_ + pos_ < limit_;
+}
+
+bool TextRowReader::loadBuffer() {
+  if (filePos_ >= fileSize_) {
+    return false;
+  }
+  const int32_t remaining = bufferSize_ - pos_;
+  const uint64_t readSize = std::min<uint64_t>(
+      std::max<uint64_t>(kReadSize, remaining), fileSize_ - filePos_);
+  VELOX_CHECK_LE(
+      remaining + readSize,
+      std::numeric_limits<int32_t>::max(),
+      "Text file row too long");
+  auto buffer = AlignedBuffer::allocate<char>(
+      remaining + readSize + simd::kPadding, pool_);
+  auto* data = buffer->asMutable<char>();
+  if (remaining > 0) {
+    memcpy(data, bufferData_ + pos_, remaining);
+  }
+  file_->pread(filePos_, readSize, data + remaining);
+  bufferOffset_ = filePos_ - remaining;
+  filePos_ += readSize;
+  bufferSize_ = remaining + readSize;
+  pos_ = 0;
+  buffer_ = std::move(buffer);
+  bufferData_ = data;
+  return true;
+}
+
+bool TextRowReader::skipLine() {
+  for (;;) {
+    if (pos_ < bufferSize_) {
+      const auto* newline = static_cast<const char*>(
+          memchr(bufferData_ + pos_, '\n', bufferSize_ - pos_));
+      if (newline != nullptr) {
+        pos_ = newline - bufferData_ + 1;
+        return true;
+      }
+      pos_ = bufferSize_;
+    }
+    if (!loadBuffer()) {
+      return false;
+    }
+  }
+}
+
+vector_size_t TextRowReader::tokenize(
+    vector_size_t maxRows,
+    vector_size_t numRows) {
+  using Batch = xsimd::batch<uint8_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const char* data = bufferData_;
+  const int32_t end = bufferSize_;
+  int32_t rowStart = pos_;
+  int32_t fieldStart = pos_;
+  column_index_t field = 0;
+  bool escaped = false;
+  // Delimiters and escape characters before this position are escaped.
+  int32_t escapedEnd = 0;
+
+  auto endField = [&](int32_t endPos) {
+    addField(field, data + fieldStart, endPos - fieldStart, escaped);
+    ++field;
+    fieldStart = endPos + 1;
+    escaped = false;
+  };
+
+  auto endRow = [&](int32_t endPos) {
+    // A row may end with "\r\n".
+    const bool carriageReturn = endPos > fieldStart && data[endPos - 1] == '\r';
+    endField(endPos - carriageReturn);
+    fieldStart = endPos + 1;
+    finishRow(numRows);
+    ++numRows;
+    rowStart = endPos + 1;
+    field = 0;
+    escapedEnd = 0;
+  };
+
+  // Handles the delimiter, newline or escape character at 'i'. Returns true
+  // if the batch is complete.
+  auto processHit = [&](int32_t i) {
+    const char c = data[i];
+    if (c == '\n') {
+      endRow(i);
+      return numRows == maxRows || bufferOffset_ + rowStart >= limit_;
+    }
+    if (i < escapedEnd) {
+      return false;
+    }
+    if (isEscaped_ && c == escapeChar_) {
+      escaped = true;
+      escapedEnd = i + 2;
+    } else if (field + 1 < numFileColumns_ || !lastColumnTakesRest_) {
+      endField(i);
+    }
+    return false;
+  };
+
+  const auto newlines = xsimd::broadcast<uint8_t>('\n');
+  const auto delimiters = xsimd::broadcast<uint8_t>(fieldDelimiter_);
+  const auto escapes = xsimd::broadcast<uint8_t>(escapeChar_);
+  bool done = numRows == maxRows;
+  int32_t i = pos_;
+  for (; !done && i + kBatchSize <= end; i += kBatchSize) {
+    const auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(data + i));
+    auto hits = (bytes == newlines) | (bytes == delimiters);
+    if (isEscaped_) {
+      hits = hits | (bytes == escapes);
+    }
+    auto mask = simd::toBitMask(hits);
+    while (mask != 0) {
+      if (processHit(i + __builtin_ctz(mask))) {
+        done = true;
+        break;
+      }
+      mask &= mask - 1;
+    }
+  }
+  for (; !done && i < end; ++i) {
+    const char c = data[i];
+    if ((c == '\n' || c == fieldDelimiter_ ||
+         (isEscaped_ && c == escapeChar_)) &&
+        processHit(i)) {
+      done = true;
+    }
+  }
+
+  if (!done && rowStart < end) {
+    if (filePos_ >= fileSize_) {
+      // The last row of the file has no newline.
+      endRow(end);
+      rowStart = end;
+    } else {
+      // The row continues in the next buffer. Drop its fields.
+      for (auto& fields : fields_) {
+        fields.resize(numRows);
+      }
+    }
+  }
+  pos_ = rowStart;
+  return numRows;
+}
+
+std::string_view TextRowReader::unescape(
+    const Field& field,
+    std::string& scratch) const {
+  if (!field.escaped) {
+    return std::string_view(field.data, field.size);
+  }
+  scratch.clear();
+  for (auto i = 0; i < field.size; ++i) {
+    if (field.data[i] == escapeChar_ && i + 1 < field.size) {
+      ++i;
+      // Hive writes newlines and carriage returns as an escaped 'n' and 'r'.
+      const char c = field.data[i];
+      scratch.push_back(c == 'n' ? '\n' : (c == 'r' ? '\r' : c));
+      continue;
+    }
+    scratch.push_back(field.data[i]);
+  }
+  return scratch;
+}
+
+template <typename T, typename Parse>
+VectorPtr TextRowReader::decodeFlat(
+    column_index_t column,
+    const TypePtr& type,
+    Parse parse) {
+  const auto& fields = fields_[column];
+  const vector_size_t numRows = fields.size();
+  auto result = BaseVector::create<FlatVector<T>>(type, numRows, pool_);
+  // Booleans are bits.
+  using TRaw = std::conditional_t<std::is_same_v<T, bool>, uint64_t, T>;
+  auto* rawValues = result->template mutableRawValues<TRaw>();
+  auto* rawNulls = result->mutableRawNulls();
+  std::string scratch;
+  T value;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const auto& field = fields[row];
+    bool isValid = !isNull(field, false);
+    if (isValid) {
+      const auto text = unescape(field, scratch);
+      isValid = parse(text.data(), text.size(), value);
+    }
+    if (!isValid) {
+      bits::setNull(rawNulls, row);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      bits::setBit(rawValues, row, value);
+    } else {
+      rawValues[row] = value;
+    }
+  }
+  return result;
+}
+
+VectorPtr TextRowReader::decodeString(
+    column_index_t column,
+    const TypePtr& type) {
+  const auto& fields = fields_[column];
+  const vector_size_t numRows = fields.size();
+  const bool isBinary = type->kind() == TypeKind::VARBINARY;
+  auto result =
+      BaseVector::create<FlatVector<StringView>>(type, numRows, pool_);
+  // Unescaped text values point into the file buffers.
+  result->setStringBuffers(batchBuffers_);
+  std::string scratch;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    const auto& field = fields[row];
+    if (isNull(field, true)) {
+      result->setNull(row, true);
+      continue;
+    }
+    if (isBinary) {
+      const auto text = unescape(field, scratch);
+      try {
+        scratch = encoding::Base64::decode(folly::StringPiece(text));
+      } catch (const VeloxException&) {
+        result->setNull(row, true);
+        continue;
+      }
+      result->set(row, StringView(scratch));
+    } else if (field.escaped) {
+      result->set(row, StringView(unescape(field, scratch)));
+    } else {
+      result->setNoCopy(row, StringView(field.data, field.size));
+    }
+  }
+  return result;
+}
+
+VectorPtr TextRowReader::decodeColumn(
+    column_index_t column,
+    const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return decodeFlat<bool>(column, type, parseBoolean);
+    case TypeKind::TINYINT:
+      return decodeFlat<int8_t>(column, type, parseInteger<int8_t>);
+    case TypeKind::SMALLINT:
+      return decodeFlat<int16_t>(column, type, parseInteger<int16_t>);
+    case TypeKind::INTEGER:
+      if (type->isDate()) {
+        return decodeFlat<int32_t>(
+            column, type, [](const char* data, int32_t size, int32_t& days) {
+              const auto result = util::fromDateString(
+                  data, size, util::ParseMode::kPrestoCast);
+              if (result.hasError()) {
+                return false;
+              }
+              days = result.value();
+              return true;
+            });
+      }
+      return decodeFlat<int32_t>(column, type, parseInteger<int32_t>);
+    case TypeKind::BIGINT:
+      return decodeFlat<int64_t>(column, type, parseInteger<int64_t>);
+    case TypeKind::REAL:
+      return decodeFlat<float>(column, type, parseFloatingPoint<float>);
+    case TypeKind::DOUBLE:
+      return decodeFlat<double>(column, type, parseFloatingPoint<double>);
+    case TypeKind::TIMESTAMP:
+      return decodeFlat<Timestamp>(
+          column,
+          type,
+          [](const char* data, int32_t size, Timestamp& timestamp) {
+            const auto result = util::fromTimestampString(
+                data, size, util::TimestampParseMode::kPrestoCast);
+            if (result.hasError()) {
+              return false;
+            }
+            timestamp = result.value();
+            return true;
+          });
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return decodeString(column, type);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const Mutation* mutation) {
+  if (!hasMoreRows()) {
+    return 0;
+  }
+  for (auto& fields : fields_) {
+    fields.clear();
+  }
+  batchBuffers_.clear();
+  batchBuffers_.push_back(buffer_);
+  const vector_size_t maxRows =
+      std::min<uint64_t>(size, std::numeric_limits<vector_size_t>::max());
+  vector_size_t numRows = 0;
+  for (;;) {
+    numRows = tokenize(maxRows, numRows);
+    if (numRows == maxRows || bufferOffset_ + pos_ >= limit_ ||
+        !loadBuffer()) {
+      break;
+    }
+    batchBuffers_.push_back(buffer_);
+  }
+  if (numRows == 0) {
+    return 0;
+  }
+  rowNumber_ += numRows;
+
+  std::vector<VectorPtr> children;
+  children.reserve(fields_.size());
+  for (auto column = 0; column < fields_.size(); ++column) {
+    const auto& type = readType_->childAt(column);
+    children.push_back(
+        isMissing_[column]
+            ? BaseVector::createNullConstant(type, numRows, pool_)
+            : decodeColumn(column, type));
+  }
+  auto input = std::make_shared<RowVector>(
+      pool_, readType_, nullptr, numRows, std::move(children));
+  result = projectColumns(input, *scanSpec_, mutation);
+  return numRows;
+}
+
+std::optional<size_t> TextRowReader::estimatedRowSize() const {
+  if (rowNumber_ == 0) {
+    return std::nullopt;
+  }
+  return (bufferOffset_ + pos_ - firstRowOffset_) / rowNumber_;
+}
+
+} // namespace
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : options_(options),
+      file_(input->getReadFile()),
+      rowType_(options.fileSchema()),
+      typeWithId_([&]() {
+        VELOX_CHECK_NOT_NULL(
+            rowType_, "Reading a text file requires a file schema");
+        return dwio::common::TypeWithId::create(rowType_);
+      }()) {}
+
+std::unique_ptr<RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      file_,
+      rowType_,
+      options_.serDeOptions(),
+      options,
+      options_.memoryPool());
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Reads delimited text files, e.g. Hive TEXTFILE, CSV or TSV. Rows end with
+/// '\n' and fields are separated by the field delimiter of the SerDeOptions
+/// of the ReaderOptions. There is no quoting. If the SerDeOptions are escaped,
+/// a delimiter preceded by the escape character is part of the field. A field
+/// equal to the null string of the SerDeOptions is null, as is an empty field
+/// of a non-string type, a field that does not parse as its type and a field
+/// missing at the end of a short row.
+///
+/// The file has no schema of its own. The file schema of the ReaderOptions
+/// gives the type of each field by position.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  ~TextReader() override = default;
+
+  /// The number of rows is not known without reading the file.
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  /// Creates a reader for the rows that start in the byte range of 'options'.
+  /// A row that starts in the range is read to its end even if this is past
+  /// the range, so that splitting a file by byte ranges reads each row once.
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const dwio::common::ReaderOptions options_;
+  const std::shared_ptr<ReadFile> file_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  TextReaderFactory() : ReaderFactory(dwio::common::FileFormat::TEXT) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(std::move(input), options);
+  }
+};
+
+} // namespace facebook::velox::text
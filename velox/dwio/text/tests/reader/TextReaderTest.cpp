@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::unique_ptr<dwio::common::RowReader> makeRowReader(
+      const std::string& text,
+      const RowTypePtr& fileType,
+      const dwio::common::SerDeOptions& serDeOptions = {},
+      const dwio::common::RowReaderOptions& rowReaderOptions = {}) {
+    dwio::common::ReaderOptions readerOptions(pool());
+    readerOptions.setFileSchema(fileType);
+    readerOptions.setSerDeOptions(serDeOptions);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(text), *pool());
+    TextReaderFactory factory;
+    auto reader = factory.createReader(std::move(input), readerOptions);
+    EXPECT_EQ(*reader->rowType(), *fileType);
+    EXPECT_FALSE(reader->numberOfRows().has_value());
+    return reader->createRowReader(rowReaderOptions);
+  }
+
+  // Reads all rows of 'rowReader' in batches of 'batchSize' rows.
+  VectorPtr readAll(dwio::common::RowReader& rowReader, uint64_t batchSize) {
+    VectorPtr result;
+    VectorPtr batch;
+    while (rowReader.next(batchSize, batch) > 0) {
+      EXPECT_LE(batch->size(), batchSize);
+      if (result == nullptr) {
+        result = BaseVector::create(batch->type(), 0, pool());
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(rowReader.nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  VectorPtr read(
+      const std::string& text,
+      const RowTypePtr& fileType,
+      const dwio::common::SerDeOptions& serDeOptions = {},
+      const dwio::common::RowReaderOptions& rowReaderOptions = {}) {
+    auto rowReader =
+        makeRowReader(text, fileType, serDeOptions, rowReaderOptions);
+    return readAll(*rowReader, 1'000);
+  }
+};
+
+TEST_F(TextReaderTest, types) {
+  auto type = ROW(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9", "c10"},
+      {BOOLEAN(),
+       TINYINT(),
+       SMALLINT(),
+       INTEGER(),
+       BIGINT(),
+       REAL(),
+       DOUBLE(),
+       TIMESTAMP(),
+       VARCHAR(),
+       VARBINARY(),
+       DATE()});
+  const std::string text =
+      "true\x01"
+      "1\x01"
+      "2\x01"
+      "3\x01"
+      "4\x01"
+      "1.5\x01"
+      "2.25\x01"
+      "2024-01-02 03:04:05.678\x01"
+      "hello\x01"
+      "aGVsbG8=\x01"
+      "2024-01-02\n"
+      // Nulls, empty fields and values that do not parse.
+      "FALSE\x01\\N\x01\x01x\x01-9223372036854775808\x01NaN\x01-Infinity\x01"
+      "\\N\x01\x01!\x01\\N\n"
+      // Missing fields and a CRLF line end.
+      "\\N\x01"
+      "127\x01-32768\r\n"
+      // Out of range and the last row without newline.
+      "yes\x01"
+      "128\x01"
+      "32768\x01"
+      "+12345678901\x01"
+      "9223372036854775807\x01"
+      "1e3\x01"
+      "1E-3\x01"
+      "2024-13-01\x01"
+      "a long string that is not inlined\x01"
+      "\x01"
+      "bad";
+
+  auto expected = makeRowVector(
+      type->names(),
+      {
+          makeNullableFlatVector<bool>(
+              {true, false, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<int8_t>({1, std::nullopt, 127, std::nullopt}),
+          makeNullableFlatVector<int16_t>(
+              {2, std::nullopt, -32768, std::nullopt}),
+          makeNullableFlatVector<int32_t>(
+              {3, std::nullopt, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<int64_t>(
+              {4,
+               std::numeric_limits<int64_t>::min(),
+               std::nullopt,
+               std::numeric_limits<int64_t>::max()}),
+          makeNullableFlatVector<float>(
+              {1.5,
+               std::numeric_limits<float>::quiet_NaN(),
+               std::nullopt,
+               1e3}),
+          makeNullableFlatVector<double>(
+              {2.25,
+               -std::numeric_limits<double>::infinity(),
+               std::nullopt,
+               1e-3}),
+          makeNullableFlatVector<Timestamp>(
+              {Timestamp(1704164645, 678'000'000),
+               std::nullopt,
+               std::nullopt,
+               std::nullopt}),
+          makeNullableFlatVector<StringView>(
+              {"hello", "", std::nullopt, "a long string that is not inlined"}),
+          makeNullableFlatVector<StringView>(
+              {"hello", std::nullopt, std::nullopt, ""}, VARBINARY()),
+          makeNullableFlatVector<int32_t>(
+              {19724, std::nullopt, std::nullopt, std::nullopt}, DATE()),
+      });
+  test::assertEqualVectors(expected, read(text, type));
+}
+
+TEST_F(TextReaderTest, integers) {
+  auto type = ROW({"c0"}, {BIGINT()});
+  std::vector<std::optional<int64_t>> values;
+  std::string text;
+  int64_t value = 1;
+  for (auto digits = 1; digits <= 19; ++digits) {
+    text += fmt::format("{}\n-{}\n{}x\n", value, value, value);
+    values.push_back(value);
+    values.push_back(-value);
+    values.push_back(std::nullopt);
+    if (digits < 19) {
+      value = value * 10 + digits % 10;
+    }
+  }
+  // Leading zeros, signs without digits, non-digits and overflow.
+  text += "00000000000000000000042\n-\n+\n1-2\n12345678.\n";
+  text += "9223372036854775808\n";
+  values.push_back(42);
+  values.insert(values.end(), 5, std::nullopt);
+  test::assertEqualVectors(
+      makeRowVector({makeNullableFlatVector<int64_t>(values)}),
+      read(text, type));
+}
+
+TEST_F(TextReaderTest, delimiters) {
+  auto type = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), VARCHAR()});
+  const std::string text =
+      "a,b,c\n"
+      "1,x\\,y,z\n"
+      "2,\\\\,p,q\n"
+      "3,NULL,\\\n"
+      "4\n";
+
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  serDeOptions.nullString = "NULL";
+  dwio::common::RowReaderOptions rowReaderOptions;
+  rowReaderOptions.setSkipRows(1);
+  test::assertEqualVectors(
+      makeRowVector(
+          type->names(),
+          {
+              makeFlatVector<int64_t>({1, 2, 3, 4}),
+              makeNullableFlatVector<StringView>(
+                  {"x,y", "\\", std::nullopt, std::nullopt}),
+              makeNullableFlatVector<StringView>(
+                  {"z", "p", "\\", std::nullopt}),
+          }),
+      read(text, type, serDeOptions, rowReaderOptions));
+
+  // The last column takes the rest of the row.
+  serDeOptions.lastColumnTakesRest = true;
+  test::assertEqualVectors(
+      makeRowVector(
+          type->names(),
+          {
+              makeFlatVector<int64_t>({1, 2, 3, 4}),
+              makeNullableFlatVector<StringView>(
+                  {"x,y", "\\", std::nullopt, std::nullopt}),
+              makeNullableFlatVector<StringView>(
+                  {"z", "p,q", "\\", std::nullopt}),
+          }),
+      read(text, type, serDeOptions, rowReaderOptions));
+
+  // Escaped 'n' and 'r' are a newline and a carriage return.
+  test::assertEqualVectors(
+      makeRowVector(
+          type->names(),
+          {
+              makeFlatVector<int64_t>({1}),
+              makeFlatVector<StringView>({"a\nb\rc"}),
+              makeFlatVector<StringView>({"\\n"}),
+          }),
+      read(
+          "1,a\\nb\\rc,\\\\n\n",
+          type,
+          dwio::common::SerDeOptions(',', '\2', '\3', '\\', true)));
+
+  // Tab separated without escaping.
+  test::assertEqualVectors(
+      makeRowVector(
+          type->names(),
+          {
+              makeFlatVector<int64_t>({1, 2}),
+              makeFlatVector<StringView>({"a\\", ""}),
+              makeFlatVector<StringView>({"b", "c d"}),
+          }),
+      read(
+          "1\ta\\\tb\n2\t\tc d\n",
+          type,
+          dwio::common::SerDeOptions('\t')));
+}
+
+TEST_F(TextReaderTest, scanSpec) {
+  auto type = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  std::string text;
+  for (auto i = 0; i < 1'000; ++i) {
+    text += fmt::format("{}\x01s{}\x01{}\n", i, i, i / 2.0);
+  }
+
+  // Only c0 and c2 are read. c0 is filtered and not projected out.
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField("c2", 0);
+  scanSpec->getOrCreateChild("c0")->setFilter(
+      std::make_unique<common::BigintRange>(100, 199, false));
+  dwio::common::RowReaderOptions rowReaderOptions;
+  rowReaderOptions.setScanSpec(scanSpec);
+  auto result = read(text, type, {}, rowReaderOptions);
+  test::assertEqualVectors(
+      makeRowVector(
+          {"c2"}, {makeFlatVector<double>(100, [](auto i) {
+            return (i + 100) / 2.0;
+          })}),
+      result);
+
+  // Columns after the last one of the file schema are missing from all rows
+  // and read as null. Their type comes from the requested type.
+  auto missing = std::make_shared<common::ScanSpec>("<root>");
+  missing->addField("c0", 0);
+  missing->addField("c3", 1);
+  rowReaderOptions.setScanSpec(missing);
+  rowReaderOptions.setRequestedType(
+      ROW({"c0", "c1", "c2", "c3"},
+          {BIGINT(), VARCHAR(), DOUBLE(), VARCHAR()}));
+  test::assertEqualVectors(
+      makeRowVector(
+          {"c0", "c3"},
+          {makeFlatVector<int64_t>(1'000, [](auto i) { return i; }),
+           makeNullConstant(TypeKind::VARCHAR, 1'000)}),
+      read(text, type, {}, rowReaderOptions));
+}
+
+TEST_F(TextReaderTest, byteRanges) {
+  auto type = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  // Rows of very different sizes, including rows longer than a read.
+  std::string text;
+  std::vector<std::string> strings;
+  std::vector<uint64_t> rowStarts;
+  for (auto i = 0; i < 5'000; ++i) {
+    auto size = i % 1'000 == 999 ? (3 << 20) : (i * 7) % 101;
+    strings.push_back(std::string(size, 'a' + i % 26));
+    rowStarts.push_back(text.size());
+    text += fmt::format("{}\x01{}\n", i, strings.back());
+  }
+  auto expected = makeRowVector(
+      type->names(),
+      {makeFlatVector<int64_t>(strings.size(), folly::identity),
+       makeFlatVector<std::string>(strings)});
+
+  for (const auto batchSize : {1, 17, 10'000}) {
+    SCOPED_TRACE(fmt::format("batchSize {}", batchSize));
+    auto rowReader = makeRowReader(text, type);
+    test::assertEqualVectors(expected, readAll(*rowReader, batchSize));
+  }
+
+  // Reading the file in consecutive ranges gives each row once.
+  for (const uint64_t rangeSize : {65'536UL, 1UL << 20, 5UL << 20}) {
+    SCOPED_TRACE(fmt::format("rangeSize {}", rangeSize));
+    auto result = BaseVector::create(type, 0, pool());
+    for (uint64_t offset = 0; offset < text.size(); offset += rangeSize) {
+      dwio::common::RowReaderOptions rowReaderOptions;
+      rowReaderOptions.range(offset, rangeSize);
+      auto rowReader = makeRowReader(text, type, {}, rowReaderOptions);
+      VectorPtr batch;
+      while (rowReader->next(1'000, batch) > 0) {
+        result->append(batch.get());
+      }
+    }
+    test::assertEqualVectors(expected, result);
+  }
+
+  // A range has the rows that start in it, if any.
+  for (uint64_t offset = 0; offset < text.size(); offset += 99'991) {
+    dwio::common::RowReaderOptions rowReaderOptions;
+    rowReaderOptions.range(offset, 10);
+    auto rowReader = makeRowReader(text, type, {}, rowReaderOptions);
+    VectorPtr batch;
+    std::vector<int64_t> rows;
+    while (rowReader->next(1'000, batch) > 0) {
+      auto* values =
+          batch->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < batch->size(); ++i) {
+        rows.push_back(values->valueAt(i));
+      }
+    }
+    std::vector<int64_t> expectedRows;
+    for (auto row = 0; row < rowStarts.size(); ++row) {
+      if (rowStarts[row] >= offset && rowStarts[row] < offset + 10) {
+        expectedRows.push_back(row);
+      }
+    }
+    EXPECT_EQ(rows, expectedRows) << offset;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::text
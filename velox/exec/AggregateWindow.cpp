@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <cstring>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -29,6 +32,15 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Sliding frames of aggregates that are not order sensitive are evaluated
+// from a segment tree over the partition. Level 0 of the tree is the rows of
+// the partition. Each node of level k + 1 holds the intermediate result of
+// kSegmentTreeFanout consecutive nodes of level k. A frame is covered by at
+// most 2 * (kSegmentTreeFanout - 1) nodes per level, so that its cost is
+// logarithmic in the frame size. Levels are only built up to the widest frame
+// seen in the partition, so that no node aggregates more rows than a frame,
+// e.g. a checked sum does not overflow on rows that no frame adds up.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -67,6 +79,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
         config);
     aggregate_->setAllocator(stringAllocator_);
 
+    if (config.windowSegmentTreeEnabled()) {
+      const auto* entry = exec::getAggregateFunctionEntry(name);
+      if (entry != nullptr && !entry->metadata.orderSensitive) {
+        intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+      }
+    }
+
     // Aggregate initialization.
     // Row layout is:
     //  - null flags - one bit per aggregate.
@@ -90,6 +109,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
         exec::RowContainer::initializedMask(kAccumulatorFlagsOffset),
         /* needed for out of line allocations */ kRowSizeOffset);
     singleGroupRowSize_ += aggregate_->accumulatorFixedWidthSize();
+    groupRowStride_ = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
 
     // Construct the single row in the MemoryPool.
     singleGroupRowBufferPtr_ =
@@ -99,6 +120,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // Constructing a vector of a single result value used for copying from
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
+    frameResults_ = BaseVector::create(resultType, 0, pool_);
 
     computeDefaultAggregateValue(resultType);
   }
@@ -116,6 +138,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTreeLevels_.clear();
   }
 
   void apply(
@@ -163,6 +186,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +371,219 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' should be evaluated from the
+  // segment tree. This is the case for wide enough frames if the aggregate
+  // can combine intermediate results in any order.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr || partition_->partial()) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    const int64_t numFrames = validRows.countSelected();
+    return numFrameRows >= numFrames * kMinSegmentTreeFrameSize;
+  }
+
+  // Allocates 'numGroups' accumulator rows, initializes them and sets
+  // 'groups' to point to them. The rows must be destroyed with
+  // destroyGroups() before the next call.
+  void initializeGroups(vector_size_t numGroups, std::vector<char*>& groups) {
+    const auto numBytes = numGroups * groupRowStride_;
+    if (groupRowsBuffer_ == nullptr ||
+        groupRowsBuffer_->capacity() < numBytes) {
+      groupRowsBuffer_ = AlignedBuffer::allocate<char>(numBytes, pool_);
+    }
+    auto* rawGroupRows = groupRowsBuffer_->asMutable<char>();
+    std::memset(rawGroupRows, 0, numBytes);
+    groups.resize(numGroups);
+    groupIndices_.resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = rawGroupRows + i * groupRowStride_;
+      groupIndices_[i] = i;
+    }
+    aggregate_->initializeNewGroups(groups.data(), groupIndices_);
+  }
+
+  void destroyGroups(std::vector<char*>& groups) {
+    aggregate_->destroy(folly::Range(groups.data(), groups.size()));
+  }
+
+  // Adds levels to the segment tree until the nodes of the next level would
+  // span more than 'maxFrameWidth' rows.
+  void extendSegmentTree(int64_t maxFrameWidth) {
+    int64_t nextNodeWidth = kSegmentTreeFanout;
+    for (auto i = 0; i < segmentTreeLevels_.size(); ++i) {
+      nextNodeWidth *= kSegmentTreeFanout;
+    }
+    vector_size_t levelSize = segmentTreeLevels_.empty()
+        ? partition_->numRows()
+        : segmentTreeLevels_.back()->size();
+    if (levelSize <= 1 || nextNodeWidth > maxFrameWidth) {
+      return;
+    }
+    aggregate_->clear();
+    std::vector<char*> nodeGroups;
+    std::vector<char*> inputGroups;
+    SelectivityVector inputRows;
+    VectorPtr nodeResults = BaseVector::create(intermediateType_, 0, pool_);
+    while (levelSize > 1 && nextNodeWidth <= maxFrameWidth) {
+      const auto numNodes = bits::divRoundUp(levelSize, kSegmentTreeFanout);
+      auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+      // The nodes are built in batches to bound the size of the extracted
+      // partition rows.
+      for (vector_size_t firstNode = 0; firstNode < numNodes;
+           firstNode += kSegmentTreeBuildBatchSize) {
+        const auto numBatchNodes =
+            std::min(kSegmentTreeBuildBatchSize, numNodes - firstNode);
+        const auto firstInput = firstNode * kSegmentTreeFanout;
+        const auto endInput = std::min(
+            levelSize, (firstNode + numBatchNodes) * kSegmentTreeFanout);
+        const auto numInputs = endInput - firstInput;
+        initializeGroups(numBatchNodes, nodeGroups);
+        inputGroups.resize(numInputs);
+        for (auto i = 0; i < numInputs; ++i) {
+          inputGroups[i] = nodeGroups[i / kSegmentTreeFanout];
+        }
+        inputRows.resizeFill(numInputs, true);
+        if (segmentTreeLevels_.empty()) {
+          fillArgVectors(firstInput, firstInput + numInputs - 1);
+          aggregate_->addRawInput(
+              inputGroups.data(), inputRows, argVectors_, false);
+        } else {
+          aggregate_->addIntermediateResults(
+              inputGroups.data(),
+              inputRows,
+              {segmentTreeLevels_.back()->slice(firstInput, numInputs)},
+              false);
+        }
+        BaseVector::prepareForReuse(nodeResults, numBatchNodes);
+        aggregate_->extractAccumulators(
+            nodeGroups.data(), numBatchNodes, &nodeResults);
+        level->copy(nodeResults.get(), firstNode, 0, numBatchNodes);
+        destroyGroups(nodeGroups);
+      }
+      segmentTreeLevels_.push_back(std::move(level));
+      levelSize = numNodes;
+      nextNodeWidth *= kSegmentTreeFanout;
+    }
+  }
+
+  // Evaluates the frames of 'validRows' from the segment tree. Each frame
+  // gets its own accumulator. The partition rows and tree nodes covering the
+  // frames are added to these with one call per tree level.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    int64_t maxFrameWidth = 0;
+    validRows.applyToSelected([&](auto i) {
+      maxFrameWidth = std::max<int64_t>(
+          maxFrameWidth, rawFrameEnds[i] - rawFrameStarts[i] + 1);
+    });
+    extendSegmentTree(maxFrameWidth);
+    const int32_t numLevels = segmentTreeLevels_.size() + 1;
+    // The inputs of each level that go into each frame, and the ordinal of
+    // the frame.
+    levelInputs_.resize(numLevels);
+    levelFrames_.resize(numLevels);
+    for (auto level = 0; level < numLevels; ++level) {
+      levelInputs_[level].clear();
+      levelFrames_[level].clear();
+    }
+    auto addInputs = [&](int32_t level,
+                         vector_size_t begin,
+                         vector_size_t end,
+                         vector_size_t frame) {
+      for (auto input = begin; input < end; ++input) {
+        levelInputs_[level].push_back(input);
+        levelFrames_[level].push_back(frame);
+      }
+    };
+
+    vector_size_t numFrames = 0;
+    validRows.applyToSelected([&](auto i) {
+      vector_size_t begin = rawFrameStarts[i];
+      vector_size_t end = rawFrameEnds[i] + 1;
+      for (auto level = 0; begin < end; ++level) {
+        const auto parentBegin = bits::divRoundUp(begin, kSegmentTreeFanout);
+        const auto parentEnd = end / kSegmentTreeFanout;
+        if (level + 1 == numLevels || parentBegin >= parentEnd) {
+          addInputs(level, begin, end, numFrames);
+          break;
+        }
+        addInputs(level, begin, parentBegin * kSegmentTreeFanout, numFrames);
+        addInputs(level, parentEnd * kSegmentTreeFanout, end, numFrames);
+        begin = parentBegin;
+        end = parentEnd;
+      }
+      ++numFrames;
+    });
+
+    aggregate_->clear();
+    initializeGroups(numFrames, frameGroups_);
+    std::vector<char*> inputGroups;
+    SelectivityVector inputRows;
+    for (auto level = 0; level < numLevels; ++level) {
+      const auto& inputs = levelInputs_[level];
+      const vector_size_t numInputs = inputs.size();
+      if (numInputs == 0) {
+        continue;
+      }
+      inputGroups.resize(numInputs);
+      for (auto i = 0; i < numInputs; ++i) {
+        inputGroups[i] = frameGroups_[levelFrames_[level][i]];
+      }
+      inputRows.resizeFill(numInputs, true);
+      if (level == 0) {
+        for (int i = 0; i < argIndices_.size(); i++) {
+          argVectors_[i]->resize(numInputs);
+          if (argIndices_[i] != kConstantChannel) {
+            partition_->extractColumn(
+                argIndices_[i],
+                folly::Range(inputs.data(), numInputs),
+                0,
+                argVectors_[i]);
+          }
+        }
+        aggregate_->addRawInput(
+            inputGroups.data(), inputRows, argVectors_, false);
+      } else {
+        auto indices = allocateIndices(numInputs, pool_);
+        std::memcpy(
+            indices->asMutable<vector_size_t>(),
+            inputs.data(),
+            numInputs * sizeof(vector_size_t));
+        aggregate_->addIntermediateResults(
+            inputGroups.data(),
+            inputRows,
+            {BaseVector::wrapInDictionary(
+                nullptr,
+                std::move(indices),
+                numInputs,
+                segmentTreeLevels_[level - 1])},
+            false);
+      }
+    }
+
+    BaseVector::prepareForReuse(frameResults_, numFrames);
+    aggregate_->extractValues(frameGroups_.data(), numFrames, &frameResults_);
+    destroyGroups(frameGroups_);
+    vector_size_t frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      result->copy(frameResults_.get(), resultOffset + i, frame++, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -358,6 +597,18 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregate_->clear();
   }
 
+  // Number of nodes of a segment tree level combined by one node of the next
+  // level.
+  static constexpr vector_size_t kSegmentTreeFanout = 8;
+
+  // Frames that are narrower than this on average are aggregated from their
+  // rows.
+  static constexpr vector_size_t kMinSegmentTreeFrameSize =
+      2 * kSegmentTreeFanout;
+
+  // Number of segment tree nodes built at a time.
+  static constexpr vector_size_t kSegmentTreeBuildBatchSize = 1'024;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -389,6 +640,30 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // Intermediate result type of the aggregate. Set only if frames may be
+  // evaluated from a segment tree.
+  TypePtr intermediateType_;
+
+  // Intermediate results of the segment tree nodes. Element k is level k + 1.
+  // Levels are added as wider frames of the partition are evaluated.
+  std::vector<VectorPtr> segmentTreeLevels_;
+
+  // Distance between accumulator rows in 'groupRowsBuffer_'.
+  vector_size_t groupRowStride_;
+
+  // Accumulator rows for segment tree nodes or frames.
+  BufferPtr groupRowsBuffer_;
+  std::vector<vector_size_t> groupIndices_;
+  std::vector<char*> frameGroups_;
+
+  // Per segment tree level, the inputs that go into the frames of an output
+  // block and the ordinal of the frame for each.
+  std::vector<std::vector<vector_size_t>> levelInputs_;
+  std::vector<std::vector<vector_size_t>> levelFrames_;
+
+  // Results for the frames of an output block.
+  VectorPtr frameResults_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 
 namespace facebook::velox::exec {
@@ -205,6 +206,148 @@ class TypedDistinctAggregations : public DistinctAggregations {
   VectorPtr inputForAccumulator_;
 };
 
+// De-duplicates (group, inputs) pairs of all groups in one hash table. The
+// first occurrence of a pair is added to the aggregates right away, so there
+// is nothing left to do but to extract the results at the end. The accumulator
+// of a group holds a unique id that identifies the group in the table. The
+// address of the group row can not serve as id since a group row may be freed
+// and reused for another group.
+class SharedTableDistinctAggregations : public DistinctAggregations {
+ public:
+  SharedTableDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool)
+      : pool_{pool},
+        aggregates_{std::move(aggregates)},
+        inputs_{aggregates_[0]->inputs} {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    std::vector<TypePtr> keyTypes;
+    hashers.push_back(VectorHasher::create(BIGINT(), 0));
+    keyTypes.push_back(BIGINT());
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      const auto& type = inputType->childAt(inputs_[i]);
+      hashers.push_back(VectorHasher::create(type, i + 1));
+      keyTypes.push_back(type);
+    }
+    keyType_ = ROW(std::move(keyTypes));
+    table_ = HashTable<false>::createForAggregation(
+        std::move(hashers), std::vector<Accumulator>{}, pool_);
+    lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  }
+
+  /// Returns metadata about the accumulator used to store the group id.
+  Accumulator accumulator() const override {
+    return {
+        true, // isFixedSize
+        sizeof(int64_t),
+        false, // usesExternalMemory
+        1, // alignment
+        nullptr,
+        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+          VELOX_UNREACHABLE();
+        },
+        [](folly::Range<char**> /*groups*/) {}};
+  }
+
+  void addInput(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    const auto numRows = input->size();
+    auto groupIds = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), numRows, pool_);
+    auto* rawGroupIds = groupIds->mutableRawValues();
+    rows.applyToSelected([&](vector_size_t row) {
+      rawGroupIds[row] = folly::loadUnaligned<int64_t>(groups[row] + offset_);
+    });
+
+    std::vector<VectorPtr> keys{groupIds};
+    std::vector<VectorPtr> args;
+    for (auto channel : inputs_) {
+      keys.push_back(input->childAt(channel));
+      args.push_back(input->childAt(channel));
+    }
+    auto keyInput = std::make_shared<RowVector>(
+        pool_, keyType_, nullptr, numRows, std::move(keys));
+
+    activeRows_ = rows;
+    table_->prepareForGroupProbe(
+        *lookup_,
+        keyInput,
+        activeRows_,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (lookup_->rows.empty()) {
+      return;
+    }
+    table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+
+    const auto& newPairs = lookup_->newGroups;
+    if (newPairs.empty()) {
+      return;
+    }
+    newPairRows_.resizeFill(numRows, false);
+    for (auto row : newPairs) {
+      newPairRows_.setValid(row, true);
+    }
+    newPairRows_.updateBounds();
+
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->addRawInput(groups, newPairRows_, args, false);
+    }
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    singleGroup_.resize(rows.end());
+    std::fill(singleGroup_.begin(), singleGroup_.end(), group);
+    addInput(singleGroup_.data(), input, rows);
+  }
+
+  void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
+      override {
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->extractValues(
+          groups.data(), groups.size(), &result->childAt(aggregate->output));
+    }
+  }
+
+  void clear() override {
+    table_->clear(/*freeTable=*/true);
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (auto i : indices) {
+      groups[i][nullByte_] |= nullMask_;
+      folly::storeUnaligned<int64_t>(groups[i] + offset_, nextGroupId_++);
+    }
+
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->initializeNewGroups(groups, indices);
+    }
+  }
+
+ private:
+  memory::MemoryPool* const pool_;
+  const std::vector<AggregateInfo*> aggregates_;
+  const std::vector<column_index_t> inputs_;
+
+  // Type of the keys of 'table_': the group id followed by the inputs.
+  RowTypePtr keyType_;
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  int64_t nextGroupId_{0};
+
+  SelectivityVector activeRows_;
+  SelectivityVector newPairRows_;
+  std::vector<char*> singleGroup_;
+};
+
 template <TypeKind Kind>
 std::unique_ptr<DistinctAggregations>
 createDistinctAggregationsWithCustomCompare(
@@ -222,10 +365,16 @@ createDistinctAggregationsWithCustomCompare(
 std::unique_ptr<DistinctAggregations> DistinctAggregations::create(
     std::vector<AggregateInfo*> aggregates,
     const RowTypePtr& inputType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool sharedTable) {
   VELOX_CHECK_EQ(aggregates.size(), 1);
   VELOX_CHECK(!aggregates[0]->inputs.empty());
 
+  if (sharedTable) {
+    return std::make_unique<SharedTableDistinctAggregations>(
+        aggregates, inputType, pool);
+  }
+
   const bool isSingleInput = aggregates[0]->inputs.size() == 1;
   if (!isSingleInput) {
     return std::make_unique<TypedDistinctAggregations<ComplexType>>(
@@ -32,10 +32,15 @@ class DistinctAggregations {
   /// aggregates should have the same inputs.
   /// @param inputType Input row type for the aggregation operator.
   /// @param pool Memory pool.
+  /// @param sharedTable If true, de-duplicates the inputs of all groups in one
+  /// hash table keyed on (group, inputs) instead of keeping a set of inputs
+  /// per group. This saves memory and allocations when there are many groups
+  /// with few distinct inputs each.
   static std::unique_ptr<DistinctAggregations> create(
       std::vector<AggregateInfo*> aggregates,
       const RowTypePtr& inputType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      bool sharedTable = false);
 
   virtual ~DistinctAggregations() = default;
 
@@ -91,6 +96,10 @@ class DistinctAggregations {
       folly::Range<char**> groups,
       const RowVectorPtr& result) = 0;
 
+  /// Frees the state that is kept outside of the group rows. Called after all
+  /// groups have been extracted or dropped.
+  virtual void clear() {}
+
  protected:
   // Initializes null flags and accumulators for newly encountered groups.  This
   // function should be called only once for each group.
@@ -16,6 +16,7 @@
 
 #include "velox/exec/Driver.h"
 
+#include "velox/common/process/Numa.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/exec/Task.h"
 
@@ -144,7 +145,9 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillReadAheadBuffers(),
+      queryConfig.spillIoUringEnabled());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -240,8 +243,7 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  driver->task()->driverExecutor()->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -321,6 +323,8 @@ RowVectorPtr Driver::next(ContinueFuture* future) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  // Operator pools allocate from the NUMA node of the task, if any.
+  process::ScopedPreferredNumaNode scopedNumaNode(self->task()->numaNode());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr result;
   const auto stop = runInternal(self, blockingState, result);
@@ -763,6 +767,8 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
+  // Operator pools allocate from the NUMA node of the task, if any.
+  process::ScopedPreferredNumaNode scopedNumaNode(self->task()->numaNode());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
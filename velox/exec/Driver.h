@@ -305,7 +305,8 @@ struct DriverCtx {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
         queryConfig().prefixSortMinRows(),
-        queryConfig().prefixSortMaxStringPrefixLength()};
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().prefixSortRadixSortEnabled()};
   }
 };
 
@@ -148,6 +148,10 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (currentPages_.front()->kind() == SerializedPage::Kind::kVector) {
+    return getOutputFromVectorPage();
+  }
+
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
   if (getSerde()->supportsAppendInDeserialize()) {
@@ -207,6 +211,24 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+RowVectorPtr Exchange::getOutputFromVectorPage() {
+  // A page from a producer in the same process. Returns a copy of its vector,
+  // one page at a time. The copy is in the memory of this operator, so that
+  // the page and the producer's memory are released here.
+  auto page = std::move(currentPages_.front());
+  currentPages_.erase(currentPages_.begin());
+  VELOX_CHECK(page->kind() == SerializedPage::Kind::kVector);
+  auto result = std::static_pointer_cast<RowVector>(
+      BaseVector::copy(*page->vector(), pool()));
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->rawInputBytes += page->size();
+    lockedStats->rawInputPositions += result->size();
+    lockedStats->addInputVector(result->estimateFlatSize(), result->size());
+  }
+  return result;
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
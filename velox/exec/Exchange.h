@@ -79,6 +79,10 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  // Returns a copy of the vector of the first of 'currentPages_', which is a
+  // page of a vector, in the memory of this operator and removes the page.
+  RowVectorPtr getOutputFromVectorPage();
+
   const uint64_t preferredOutputBatchBytes_;
 
   const VectorSerde::Kind serdeKind_;
@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -114,6 +115,16 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  if (queuedBytes_.count > 0) {
+    stats["queuedBytes"] = queuedBytes_;
+  }
+  if (consumerWaitNanos_.count > 0) {
+    stats["consumerWaitWallNanos"] = consumerWaitNanos_;
+  }
+  if (adaptive_) {
+    stats["targetQueuedBytes"] =
+        RuntimeMetric(targetQueuedBytes_, RuntimeCounter::Unit::kBytes);
+  }
 
   return stats;
 }
@@ -134,13 +145,17 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeClient::next(
     }
 
     *atEnd = false;
+    const auto queuedBytes = queue_->totalBytes();
     pages = queue_->dequeueLocked(
         consumerId, maxBytes, atEnd, future, &stalePromise);
+    queuedBytes_.addValue(queuedBytes);
+    RECORD_HISTOGRAM_METRIC_VALUE(kMetricExchangeQueuedBytes, queuedBytes);
+    updateFlowControlLocked(consumerId, pages.size(), *atEnd);
     if (*atEnd) {
       return pages;
     }
 
-    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytes_) {
+    if (!pages.empty() && queue_->totalBytes() > queueLimitLocked()) {
       return pages;
     }
 
@@ -192,6 +207,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 if (self->closed_) {
                   return;
                 }
+                if (spec.maxBytes > 0) {
+                  self->recordTransferRateLocked(
+                      spec.source.get(), response.bytes, requestTimeMs);
+                }
                 if (!response.atEnd) {
                   if (!response.remainingBytes.empty()) {
                     for (auto bytes : response.remainingBytes) {
@@ -239,11 +258,15 @@ ExchangeClient::pickSourcesToRequestLocked() {
     emptySources_.pop();
   }
   int64_t availableSpace =
-      maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+      queueLimitLocked() - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
+    const int64_t maxRequestBytes = maxRequestBytesLocked(source.get());
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > maxRequestBytes) {
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -275,6 +298,71 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+int64_t ExchangeClient::maxRequestBytesLocked(
+    const ExchangeSource* source) const {
+  if (!adaptive_) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  // Leaves room for other sources to be in flight, so that one slow source
+  // does not hold up the rest.
+  int64_t maxBytes = targetQueuedBytes_ / kMinAdaptiveSourcesInFlight;
+  auto it = sourceBytesPerMs_.find(source);
+  if (it != sourceBytesPerMs_.end()) {
+    // A request should take about as long as the longest wait of a source for
+    // data.
+    maxBytes = std::min<int64_t>(
+        maxBytes, it->second * kRequestDataMaxWait.count());
+  }
+  return maxBytes;
+}
+
+void ExchangeClient::updateFlowControlLocked(
+    int consumerId,
+    size_t numPages,
+    bool atEnd) {
+  if (numPages == 0 && !atEnd) {
+    consumerWaitStartUs_.emplace(consumerId, getCurrentTimeMicro());
+    // The consumer starves while sources have data that is not requested for
+    // lack of space. Doubles the space.
+    if (adaptive_ && !producingSources_.empty()) {
+      targetQueuedBytes_ = std::min(maxQueuedBytes_, targetQueuedBytes_ * 2);
+    }
+    return;
+  }
+
+  auto it = consumerWaitStartUs_.find(consumerId);
+  if (it != consumerWaitStartUs_.end()) {
+    const auto waitUs = getCurrentTimeMicro() - it->second;
+    consumerWaitStartUs_.erase(it);
+    consumerWaitNanos_.addValue(waitUs * 1'000);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricExchangeQueueWaitTimeMs, waitUs / 1'000);
+  }
+
+  // Data waits in the queue, so the consumers are slower than the sources.
+  // Shrinks the space by 1/8 to hold less memory.
+  if (adaptive_ && numPages > 0 &&
+      queue_->totalBytes() > targetQueuedBytes_ / 2) {
+    targetQueuedBytes_ = std::max(
+        kMinAdaptiveQueuedBytes, targetQueuedBytes_ - targetQueuedBytes_ / 8);
+  }
+}
+
+void ExchangeClient::recordTransferRateLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t requestTimeMs) {
+  if (!adaptive_ || bytes == 0) {
+    return;
+  }
+  const double bytesPerMs =
+      static_cast<double>(bytes) / std::max<uint64_t>(1, requestTimeMs);
+  auto [it, inserted] = sourceBytesPerMs_.emplace(source, bytesPerMs);
+  if (!inserted) {
+    it->second = 0.7 * it->second + 0.3 * bytesPerMs;
+  }
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
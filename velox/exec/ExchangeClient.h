@@ -29,6 +29,18 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
 
+  /// With adaptive flow control, the bytes to keep queued or in flight never
+  /// go below this.
+  static constexpr int64_t kMinAdaptiveQueuedBytes = 1 << 20; // 1 MB.
+
+  /// With adaptive flow control, a single request asks for at most this
+  /// fraction of the bytes to keep queued or in flight, so that this many
+  /// sources can be in flight at a time.
+  static constexpr int32_t kMinAdaptiveSourcesInFlight = 4;
+
+  /// @param adaptiveFlowControl If true, keeps only as many bytes queued or in
+  /// flight as the consumers need, up to 'maxQueuedBytes'. See
+  /// QueryConfig::kExchangeAdaptiveFlowControl.
   ExchangeClient(
       std::string taskId,
       int destination,
@@ -36,7 +48,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       int32_t numberOfConsumers,
       uint64_t minOutputBatchBytes,
       memory::MemoryPool* pool,
-      folly::Executor* executor)
+      folly::Executor* executor,
+      bool adaptiveFlowControl = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
@@ -44,7 +57,11 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
         executor_(executor),
         queue_(std::make_shared<ExchangeQueue>(
             numberOfConsumers,
-            minOutputBatchBytes)) {
+            minOutputBatchBytes)),
+        adaptive_(adaptiveFlowControl),
+        targetQueuedBytes_(std::min(
+            maxQueuedBytes_,
+            std::max(kMinAdaptiveQueuedBytes, maxQueuedBytes_ / 4))) {
     VELOX_CHECK_NOT_NULL(pool_);
     VELOX_CHECK_NOT_NULL(executor_);
     // NOTE: the executor is used to run async response callback from the
@@ -119,6 +136,26 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   void request(std::vector<RequestSpec>&& requestSpecs);
 
+  // Returns the bytes to keep queued or in flight.
+  int64_t queueLimitLocked() const {
+    return adaptive_ ? targetQueuedBytes_ : maxQueuedBytes_;
+  }
+
+  // Returns the most bytes to request from 'source' in one request.
+  int64_t maxRequestBytesLocked(const ExchangeSource* source) const;
+
+  // Records the queue occupancy and the wait time of consumer 'consumerId'
+  // for a call to next() that returned 'numPages' pages. With adaptive flow
+  // control, also adjusts 'targetQueuedBytes_'.
+  void updateFlowControlLocked(int consumerId, size_t numPages, bool atEnd);
+
+  // Records the transfer rate of 'source' for a response of 'bytes' that took
+  // 'requestTimeMs'.
+  void recordTransferRateLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t requestTimeMs);
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
@@ -139,6 +176,24 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  const bool adaptive_;
+
+  // The bytes to keep queued or in flight with adaptive flow control. Between
+  // kMinAdaptiveQueuedBytes and 'maxQueuedBytes_'.
+  int64_t targetQueuedBytes_;
+
+  // Moving average of the transfer rate of each source in bytes per ms.
+  folly::F14FastMap<const ExchangeSource*, double> sourceBytesPerMs_;
+
+  // The time in us at which each consumer that is waiting for data found the
+  // queue empty.
+  folly::F14FastMap<int, uint64_t> consumerWaitStartUs_;
+
+  // The bytes in the queue at each call to next() and the time consumers
+  // waited for data.
+  RuntimeMetric queuedBytes_{RuntimeCounter::Unit::kBytes};
+  RuntimeMetric consumerWaitNanos_{RuntimeCounter::Unit::kNanos};
 };
 
 } // namespace facebook::velox::exec
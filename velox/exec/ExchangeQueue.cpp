@@ -36,6 +36,64 @@ SerializedPage::SerializedPage(
   }
 }
 
+namespace {
+// The buffer of a page of Kind::kVector. The IOBuf owns the holder, so that
+// clones of it keep the vector alive.
+struct VectorPageHolder {
+  RowVectorPtr vector;
+  int64_t bytes;
+  std::function<void()> releaseFn;
+};
+
+void freeVectorPage(void* /*buffer*/, void* userData) {
+  auto* holder = static_cast<VectorPageHolder*>(userData);
+  if (holder->releaseFn) {
+    holder->releaseFn();
+  }
+  delete holder;
+}
+
+std::unique_ptr<folly::IOBuf> makeVectorPageBuffer(
+    RowVectorPtr vector,
+    int64_t bytes,
+    std::function<void()> releaseFn) {
+  auto* holder =
+      new VectorPageHolder{std::move(vector), bytes, std::move(releaseFn)};
+  return folly::IOBuf::takeOwnership(
+      holder, sizeof(VectorPageHolder), freeVectorPage, holder);
+}
+} // namespace
+
+SerializedPage::SerializedPage(
+    RowVectorPtr vector,
+    std::function<void()> releaseFn,
+    std::optional<int64_t> bytes)
+    : iobuf_(makeVectorPageBuffer(
+          vector,
+          bytes.value_or(vector->retainedSize()),
+          std::move(releaseFn))),
+      iobufBytes_(bytes.value_or(vector->retainedSize())),
+      numRows_(vector->size()),
+      kind_(Kind::kVector),
+      vector_(std::move(vector)) {}
+
+// static
+RowVectorPtr SerializedPage::vectorOf(
+    const folly::IOBuf& iobuf,
+    int64_t* bytes) {
+  // The buffer of a vector page is identified by its free function, which no
+  // other buffer has.
+  if (iobuf.isChained() || iobuf.getFreeFn() != freeVectorPage) {
+    return nullptr;
+  }
+  const auto* holder =
+      static_cast<const VectorPageHolder*>(iobuf.getUserData());
+  if (bytes != nullptr) {
+    *bytes = holder->bytes;
+  }
+  return holder->vector;
+}
+
 SerializedPage::~SerializedPage() {
   if (onDestructionCb_) {
     onDestructionCb_(*iobuf_.get());
@@ -43,6 +101,8 @@ SerializedPage::~SerializedPage() {
 }
 
 std::unique_ptr<ByteInputStream> SerializedPage::prepareStreamForDeserialize() {
+  VELOX_CHECK(
+      kind_ == Kind::kSerialized, "A page of a vector has no serialized data");
   return std::make_unique<BufferInputStream>(std::move(ranges_));
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -23,12 +24,32 @@ namespace facebook::velox::exec {
 /// in Presto wire format.
 class SerializedPage {
  public:
+  /// The content of a page.
+  enum class Kind {
+    /// Vectors serialized by a VectorSerde.
+    kSerialized,
+    /// A vector passed as is to a consumer in the same process.
+    kVector,
+  };
+
   /// Construct from IOBuf chain.
   explicit SerializedPage(
       std::unique_ptr<folly::IOBuf> iobuf,
       std::function<void(folly::IOBuf&)> onDestructionCb = nullptr,
       std::optional<int64_t> numRows = std::nullopt);
 
+  /// Constructs a page that carries 'vector' as is, for a consumer in the
+  /// same process. The page is of Kind::kVector. getIOBuf() returns a buffer
+  /// that holds a reference to 'vector' and from which vectorOf() gets it
+  /// back. 'releaseFn' is called when the last reference to the buffer is
+  /// dropped. size() is 'bytes', or the retained size of 'vector' if not
+  /// given. 'bytes' is set for a vector that shares its buffers with other
+  /// vectors, e.g. a slice.
+  SerializedPage(
+      RowVectorPtr vector,
+      std::function<void()> releaseFn,
+      std::optional<int64_t> bytes = std::nullopt);
+
   ~SerializedPage();
 
   /// Returns the size of the serialized data in bytes.
@@ -48,6 +69,22 @@ class SerializedPage {
     return iobuf_->clone();
   }
 
+  Kind kind() const {
+    return kind_;
+  }
+
+  /// Returns the vector of a page of Kind::kVector, nullptr otherwise.
+  const RowVectorPtr& vector() const {
+    return vector_;
+  }
+
+  /// Returns the vector if 'iobuf' comes from getIOBuf() of a page of
+  /// Kind::kVector, nullptr otherwise. Sets 'bytes' to the size() of that
+  /// page if not nullptr.
+  static RowVectorPtr vectorOf(
+      const folly::IOBuf& iobuf,
+      int64_t* bytes = nullptr);
+
  private:
   static int64_t chainBytes(folly::IOBuf& iobuf) {
     int64_t size = 0;
@@ -74,6 +111,11 @@ class SerializedPage {
   // from caller. Caller is responsible to pass in proper cleanup logic to
   // prevent any memory leak.
   std::function<void(folly::IOBuf&)> onDestructionCb_;
+
+  const Kind kind_{Kind::kSerialized};
+
+  // The vector carried by 'this' if 'kind_' is Kind::kVector.
+  const RowVectorPtr vector_;
 };
 
 /// Queue of results retrieved from source. Owned by shared_ptr by
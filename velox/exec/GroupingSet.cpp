@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/GroupingSet.h"
+#include <folly/container/F14Set.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
@@ -57,6 +58,7 @@ GroupingSet::GroupingSet(
     folly::Synchronized<common::SpillStats>* spillStats)
     : preGroupedKeyChannels_(std::move(preGroupedKeys)),
       groupingKeyOutputProjections_(std::move(groupingKeyOutputProjections)),
+      inputType_(inputType),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
       isPartial_(isPartial),
@@ -72,6 +74,10 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      sortFallbackMinPct_(queryConfig_.aggregationSortFallbackMinPct()),
+      sortFallbackMinRows_(queryConfig_.aggregationSortFallbackMinRows()),
+      sharedDistinctTableMinPct_(
+          queryConfig_.distinctAggregationSharedTableMinPct()),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -200,10 +206,86 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   activeRows_.setAll();
 
   addInputForActiveRows(input, mayPushdown);
+
+  if (clusteredEvictionBatches_ > 0) {
+    maybeEvictGroups();
+  }
+}
+
+void GroupingSet::setClusteredInput(int32_t evictionBatches) {
+  VELOX_CHECK_GT(evictionBatches, 0);
+  VELOX_CHECK_NULL(table_, "Clustered input must be set before any input");
+  VELOX_CHECK(!isGlobal_ && !isPartial_);
+  VELOX_CHECK_NULL(spillConfig_);
+  VELOX_CHECK_NULL(sortedAggregations_);
+  for (const auto& aggregation : distinctAggregations_) {
+    VELOX_CHECK_NULL(aggregation);
+  }
+  clusteredEvictionBatches_ = evictionBatches;
+}
+
+void GroupingSet::updateLastSeenBatch() {
+  for (auto row : lookup_->rows) {
+    *reinterpret_cast<uint32_t*>(lookup_->hits[row] + lastSeenBatchOffset_) =
+        numInputBatches_;
+  }
+}
+
+void GroupingSet::maybeEvictGroups() {
+  ++numInputBatches_;
+  // Scanning the groups once every 'clusteredEvictionBatches_' batches keeps
+  // the cost per batch proportional to the groups of a batch. A group is then
+  // freed after between one and two times that many batches without input.
+  if (table_ == nullptr || !evictedGroups_.empty() ||
+      numInputBatches_ % clusteredEvictionBatches_ != 0) {
+    return;
+  }
+  const uint32_t minLastSeenBatch =
+      numInputBatches_ - clusteredEvictionBatches_;
+  auto* rows = table_->rows();
+  RowContainerIterator iterator;
+  std::array<char*, 1024> groups;
+  for (;;) {
+    const auto numGroups =
+        rows->listRows(&iterator, groups.size(), groups.data());
+    if (numGroups == 0) {
+      break;
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      const auto lastSeenBatch =
+          *reinterpret_cast<const uint32_t*>(groups[i] + lastSeenBatchOffset_);
+      if (lastSeenBatch < minLastSeenBatch) {
+        evictedGroups_.push_back(groups[i]);
+      }
+    }
+  }
+  numEvictedGroups_ += evictedGroups_.size();
+
+  if (isDistinct() && !evictedGroups_.empty()) {
+    // A distinct aggregation has produced its groups when they were new.
+    table_->erase(folly::Range<char**>(
+        evictedGroups_.data(), evictedGroups_.size()));
+    evictedGroups_.clear();
+  }
+}
+
+bool GroupingSet::getEvictedOutput(
+    int32_t maxOutputRows,
+    const RowVectorPtr& result) {
+  const auto numGroups =
+      std::min<size_t>(maxOutputRows, evictedGroups_.size());
+  folly::Range<char**> groups(
+      evictedGroups_.data() + evictedGroups_.size() - numGroups, numGroups);
+  extractGroups(table_->rows(), groups, result);
+  table_->erase(groups);
+  evictedGroups_.resize(evictedGroups_.size() - numGroups);
+  return true;
 }
 
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
+  // The groups not produced yet are produced with the rest of 'table_'.
+  evictedGroups_.clear();
 
   if (remainingInput_) {
     addRemainingInput();
@@ -229,7 +311,7 @@ bool GroupingSet::hasSpilled() const {
 }
 
 bool GroupingSet::hasOutput() {
-  return noMoreInput_ || remainingInput_;
+  return noMoreInput_ || remainingInput_ || !evictedGroups_.empty();
 }
 
 void GroupingSet::addInputForActiveRows(
@@ -237,25 +319,35 @@ void GroupingSet::addInputForActiveRows(
     bool mayPushdown) {
   VELOX_CHECK(!isGlobal_);
   if (!table_) {
-    createHashTable();
+    createHashTable(input);
   }
   ensureInputFits(input);
 
   TestValue::adjust(
       "facebook::velox::exec::GroupingSet::addInputForActiveRows", this);
 
-  table_->prepareForGroupProbe(
-      *lookup_,
-      input,
-      activeRows_,
-      BaseHashTable::kNoSpillInputStartPartitionBit);
-  if (lookup_->rows.empty()) {
-    // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
-    // have null keys.
-    return;
-  }
+  if (sortFallback_) {
+    if (!addNewGroupsWithoutProbe(input)) {
+      return;
+    }
+  } else {
+    table_->prepareForGroupProbe(
+        *lookup_,
+        input,
+        activeRows_,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (lookup_->rows.empty()) {
+      // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
+      // have null keys.
+      return;
+    }
 
-  table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+    table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+    numTableInputRows_ += lookup_->rows.size();
+    if (clusteredEvictionBatches_ > 0) {
+      updateLastSeenBatch();
+    }
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
@@ -309,6 +401,70 @@ void GroupingSet::addInputForActiveRows(
     }
     sortedAggregations_->addInput(groups, input);
   }
+
+  maybeStartSortFallback();
+}
+
+void GroupingSet::maybeStartSortFallback() {
+  if (sortFallback_ || sortFallbackMinPct_ <= 0 || isPartial_ ||
+      spillConfig_ == nullptr || isDistinct() ||
+      !preGroupedKeyChannels_.empty() ||
+      numTableInputRows_ < static_cast<uint64_t>(sortFallbackMinRows_)) {
+    return;
+  }
+  const uint64_t numDistinct = table_->numDistinct();
+  if (numDistinct * 100 < numTableInputRows_ * sortFallbackMinPct_) {
+    return;
+  }
+  sortFallback_ = true;
+  spill();
+}
+
+bool GroupingSet::addNewGroupsWithoutProbe(const RowVectorPtr& input) {
+  auto* rows = table_->rows();
+  // Writes a sorted run once the groups reach the rows of a spill run.
+  if (spillConfig_->maxSpillRunRows > 0 &&
+      rows->numRows() >= spillConfig_->maxSpillRunRows) {
+    spill();
+  }
+
+  const auto& hashers = lookup_->hashers;
+  for (auto& hasher : hashers) {
+    hasher->decode(
+        *input->childAt(hasher->channel())->loadedVector(), activeRows_);
+  }
+  if (ignoreNullKeys_) {
+    // A null in any of the keys disables the row.
+    for (auto& hasher : hashers) {
+      const auto& decoded = hasher->decodedVector();
+      if (!decoded.mayHaveNulls()) {
+        continue;
+      }
+      for (auto row = activeRows_.begin(); row < activeRows_.end(); ++row) {
+        if (activeRows_.isValid(row) && decoded.isNullAt(row)) {
+          activeRows_.setValid(row, false);
+        }
+      }
+    }
+    activeRows_.updateBounds();
+  }
+
+  lookup_->reset(activeRows_.end());
+  lookup_->rows.clear();
+  if (!activeRows_.hasSelections()) {
+    return false;
+  }
+
+  activeRows_.applyToSelected([&](auto row) {
+    char* group = rows->newRow();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      rows->store(hashers[i]->decodedVector(), row, group, i);
+    }
+    lookup_->hits[row] = group;
+    lookup_->rows.push_back(row);
+    lookup_->newGroups.push_back(row);
+  });
+  return true;
 }
 
 void GroupingSet::addRemainingInput() {
@@ -368,10 +524,67 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
       accumulators.push_back(aggregation->accumulator());
     }
   }
+
+  if (clusteredEvictionBatches_ > 0) {
+    // The number of the last input batch of the group. Not spilled since
+    // clustered input disables spilling.
+    accumulators.push_back(Accumulator{
+        true,
+        sizeof(uint32_t),
+        false,
+        alignof(uint32_t),
+        INTEGER(),
+        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+          VELOX_UNREACHABLE();
+        },
+        [](folly::Range<char**> /*groups*/) {}});
+  }
   return accumulators;
 }
 
-void GroupingSet::createHashTable() {
+void GroupingSet::maybeShareDistinctTable(const RowVectorPtr& input) {
+  if (sharedDistinctTableMinPct_ == 0 || sharedDistinctTable_ ||
+      !activeRows_.hasSelections()) {
+    return;
+  }
+  if (std::all_of(
+          distinctAggregations_.begin(),
+          distinctAggregations_.end(),
+          [](const auto& aggregation) { return aggregation == nullptr; })) {
+    return;
+  }
+
+  // Estimates the number of groups from the distinct grouping keys of the
+  // first batch. With many groups of few rows each, the fixed size and the
+  // allocations of a set per group outweigh the distinct inputs in the sets.
+  raw_vector<uint64_t> hashes(activeRows_.end());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    auto& hasher = hashers_[i];
+    hasher->decode(
+        *input->childAt(hasher->channel())->loadedVector(), activeRows_);
+    hasher->hash(activeRows_, i > 0, hashes);
+  }
+  folly::F14FastSet<uint64_t> distinctHashes;
+  activeRows_.applyToSelected(
+      [&](vector_size_t row) { distinctHashes.insert(hashes[row]); });
+  if (distinctHashes.size() * 100 <
+      static_cast<uint64_t>(sharedDistinctTableMinPct_) *
+          activeRows_.countSelected()) {
+    return;
+  }
+
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (distinctAggregations_[i] != nullptr) {
+      distinctAggregations_[i] = DistinctAggregations::create(
+          {&aggregates_[i]}, inputType_, &pool_, /*sharedTable=*/true);
+    }
+  }
+  sharedDistinctTable_ = true;
+}
+
+void GroupingSet::createHashTable(const RowVectorPtr& input) {
+  maybeShareDistinctTable(input);
+
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
         std::move(hashers_), accumulators(false), &pool_);
@@ -416,6 +629,10 @@ void GroupingSet::createHashTable() {
     }
   }
 
+  if (clusteredEvictionBatches_ > 0) {
+    lastSeenBatchOffset_ = rows.columnAt(numColumns).offset();
+  }
+
   lookup_ = std::make_unique<HashLookup>(table_->hashers());
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
@@ -738,21 +955,38 @@ bool GroupingSet::getOutput(
     int32_t maxOutputBytes,
     RowContainerIterator& iterator,
     RowVectorPtr& result) {
+  return getOutput(maxOutputRows, maxOutputBytes, iterator, result, nullptr);
+}
+
+bool GroupingSet::getOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result,
+    const RowVectorPtr& intermediateResult) {
   TestValue::adjust("facebook::velox::exec::GroupingSet::getOutput", this);
 
   if (isGlobal_) {
+    VELOX_CHECK_NULL(intermediateResult);
     return getGlobalAggregationOutput(iterator, result);
   }
 
   if (hasDefaultGlobalGroupingSetOutput()) {
+    VELOX_CHECK_NULL(intermediateResult);
     return getDefaultGlobalGroupingSetOutput(iterator, result);
   }
 
   if (hasSpilled()) {
+    VELOX_CHECK_NULL(intermediateResult);
     return getOutputWithSpill(maxOutputRows, maxOutputBytes, result);
   }
   VELOX_CHECK(!isDistinct());
 
+  if (!evictedGroups_.empty()) {
+    VELOX_CHECK_NULL(intermediateResult);
+    return getEvictedOutput(maxOutputRows, result);
+  }
+
   // @lint-ignore CLANGTIDY
   char* groups[maxOutputRows];
   const int32_t numGroups = table_
@@ -763,13 +997,41 @@ bool GroupingSet::getOutput(
     if (table_ != nullptr) {
       table_->clear(/*freeTable=*/true);
     }
+    clearDistinctAggregations();
     return false;
   }
+  if (intermediateResult != nullptr) {
+    // Extracts the accumulators before the final values since extracting the
+    // final values may change the accumulators of some aggregates.
+    extractIntermediateGroups(
+        folly::Range<char**>(groups, numGroups), intermediateResult);
+  }
   extractGroups(
       table_->rows(), folly::Range<char**>(groups, numGroups), result);
   return true;
 }
 
+void GroupingSet::extractIntermediateGroups(
+    folly::Range<char**> groups,
+    const RowVectorPtr& result) {
+  VELOX_CHECK_NULL(sortedAggregations_);
+  result->resize(groups.size());
+  auto* rows = table_->rows();
+  const auto numKeys = rows->keyTypes().size();
+  for (auto i = 0; i < numKeys; ++i) {
+    rows->extractColumn(
+        groups.data(),
+        groups.size(),
+        groupingKeyOutputProjections_[i],
+        result->childAt(i));
+  }
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    VELOX_CHECK(!aggregates_[i].distinct);
+    aggregates_[i].function->extractAccumulators(
+        groups.data(), groups.size(), &result->childAt(numKeys + i));
+  }
+}
+
 void GroupingSet::extractGroups(
     RowContainer* rowContainer,
     folly::Range<char**> groups,
@@ -814,9 +1076,19 @@ void GroupingSet::extractGroups(
 }
 
 void GroupingSet::resetTable(bool freeTable) {
+  evictedGroups_.clear();
   if (table_ != nullptr) {
     table_->clear(freeTable);
   }
+  clearDistinctAggregations();
+}
+
+void GroupingSet::clearDistinctAggregations() {
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->clear();
+    }
+  }
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -860,8 +1132,8 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     return;
   }
 
-  const auto numDistinct = table_->numDistinct();
-  if (numDistinct == 0) {
+  // In sort-based aggregation the groups are not in the hash table.
+  if (table_->rows()->numRows() == 0) {
     // Table is empty. Nothing to spill.
     return;
   }
@@ -883,7 +1155,8 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool_.availableReservation();
-  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  const auto tableIncrementBytes =
+      sortFallback_ ? 0 : table_->hashTableSizeIncrease(input->size());
   const auto incrementBytes =
       rows->sizeIncrement(input->size(), outOfLineBytes ? flatBytes * 2 : 0) +
       tableIncrementBytes;
@@ -1001,7 +1274,7 @@ void GroupingSet::spill() {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
   // Correspondingly, 'table_' will not be initialized at that point.
-  if (table_ == nullptr || table_->numDistinct() == 0) {
+  if (table_ == nullptr || table_->rows()->numRows() == 0) {
     return;
   }
 
@@ -1049,6 +1322,7 @@ void GroupingSet::spill() {
     sortedAggregations_->clear();
   }
   table_->clear(/*freeTable=*/true);
+  numTableInputRows_ = 0;
 }
 
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
@@ -1133,7 +1407,11 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->executor,
+      spillConfig_->numReadAheadBuffers);
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -59,12 +59,20 @@ class GroupingSet {
 
   void noMoreInput();
 
+  /// Declares the input clustered on all grouping keys. The groups that have
+  /// not received input for 'evictionBatches' input batches are then produced
+  /// by getOutput() and freed before all input is received. A distinct
+  /// aggregation, which produces its groups when they are new, frees them
+  /// right away. Must be called before the first input. See
+  /// core::AggregationNode::clusteredInput().
+  void setClusteredInput(int32_t evictionBatches);
+
   /// Typically, the output is not available until all input has been added.
   /// However, in case when input is clustered on some of the grouping keys, the
   /// output becomes available every time one of these grouping keys changes
   /// value. This method returns true if no-more-input message has been received
   /// or if some groups are ready for output because pre-grouped keys values
-  /// have changed.
+  /// have changed or because clustered input has not reached them for a while.
   bool hasOutput();
 
   /// Called if partial aggregation has reached memory limit or if hasOutput()
@@ -77,6 +85,17 @@ class GroupingSet {
       RowContainerIterator& iterator,
       RowVectorPtr& result);
 
+  /// Same as above but also extracts the grouping keys and the intermediate
+  /// results of the returned groups into 'intermediateResult' if not null. The
+  /// groups can then be aggregated further over a subset of the grouping
+  /// keys. Not supported for global aggregations and after spilling.
+  bool getOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result,
+      const RowVectorPtr& intermediateResult);
+
   uint64_t allocatedBytes() const;
 
   /// Resets the hash table inside the grouping set when partial aggregation
@@ -122,6 +141,25 @@ class GroupingSet {
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
+  /// Returns true if 'this' has switched from hashing to sorting the input
+  /// into spill runs. See QueryConfig::kAggregationSortFallbackMinPct.
+  bool isSortFallback() const {
+    return sortFallback_;
+  }
+
+  /// Returns true if the aggregations over distinct inputs de-duplicate the
+  /// inputs of all groups in one hash table. See
+  /// QueryConfig::kDistinctAggregationSharedTableMinPct.
+  bool hasSharedDistinctTable() const {
+    return sharedDistinctTable_;
+  }
+
+  /// Returns the number of groups freed before the end of input because of
+  /// clustered input. See setClusteredInput().
+  uint64_t numEvictedGroups() const {
+    return numEvictedGroups_;
+  }
+
   /// Returns the hashtable stats.
   HashTableStats hashTableStats() const {
     return table_ ? table_->stats() : HashTableStats{};
@@ -163,6 +201,30 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Records the current input batch as the last batch of the groups in
+  // 'lookup_'.
+  void updateLastSeenBatch();
+
+  // Called after each input batch if the input is clustered. Every
+  // 'clusteredEvictionBatches_' batches, moves the groups that have not
+  // received input for that many batches to 'evictedGroups_'.
+  void maybeEvictGroups();
+
+  // Produces up to 'maxOutputRows' groups of 'evictedGroups_' into 'result'
+  // and erases them from 'table_'.
+  bool getEvictedOutput(int32_t maxOutputRows, const RowVectorPtr& result);
+
+  // Switches to sort-based aggregation if the groups are nearly as many as the
+  // input rows, so that hashing does not reduce the data. Spills the groups so
+  // far as the first sorted run.
+  void maybeStartSortFallback();
+
+  // Stores a new group for each of 'activeRows_' in 'input' without probing
+  // the hash table and sets 'lookup_' as groupProbe() would. The groups are
+  // sorted and aggregated when spilled. Returns false if there are no rows to
+  // add.
+  bool addNewGroupsWithoutProbe(const RowVectorPtr& input);
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -180,7 +242,16 @@ class GroupingSet {
         isRawInput_;
   }
 
-  void createHashTable();
+  // Creates 'table_' before adding the first batch of 'input'.
+  void createHashTable(const RowVectorPtr& input);
+
+  // Switches the aggregations over distinct inputs to a shared hash table if
+  // the active rows of 'input' have many distinct grouping keys.
+  void maybeShareDistinctTable(const RowVectorPtr& input);
+
+  // Frees the state of 'distinctAggregations_' that is kept outside of
+  // 'table_'. Called when 'table_' is cleared.
+  void clearDistinctAggregations();
 
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
@@ -206,6 +277,12 @@ class GroupingSet {
       folly::Range<char**> groups,
       const RowVectorPtr& result);
 
+  // Extracts the grouping keys and the accumulators of 'groups' of 'table_'
+  // into 'result'.
+  void extractIntermediateGroups(
+      folly::Range<char**> groups,
+      const RowVectorPtr& result);
+
   // Produces output in if spilling has occurred. First produces data
   // from non-spilled partitions, then merges spill runs and unspilled data
   // form spilled partitions. Returns nullptr when at end. 'maxOutputRows' and
@@ -282,6 +359,7 @@ class GroupingSet {
   // is the corresponding column index stored in 'table_'.
   std::vector<column_index_t> groupingKeyOutputProjections_;
 
+  const RowTypePtr inputType_;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   const bool isGlobal_;
   const bool isPartial_;
@@ -328,6 +406,38 @@ class GroupingSet {
 
   bool noMoreInput_{false};
 
+  // See QueryConfig::kAggregationSortFallbackMinPct.
+  const int32_t sortFallbackMinPct_;
+  const int32_t sortFallbackMinRows_;
+
+  // True after switching to sort-based aggregation.
+  bool sortFallback_{false};
+
+  // Number of input rows added to 'table_' since it was last cleared.
+  uint64_t numTableInputRows_{0};
+
+  // See QueryConfig::kDistinctAggregationSharedTableMinPct.
+  const int32_t sharedDistinctTableMinPct_;
+
+  // True if 'distinctAggregations_' use a shared hash table.
+  bool sharedDistinctTable_{false};
+
+  // See setClusteredInput(). 0 if the input is not clustered.
+  int32_t clusteredEvictionBatches_{0};
+
+  // Offset of the number of the last input batch of a group in the rows of
+  // 'table_'. Set if 'clusteredEvictionBatches_' is not 0.
+  int32_t lastSeenBatchOffset_{0};
+
+  // Number of input batches received if the input is clustered.
+  uint32_t numInputBatches_{0};
+
+  // Groups of 'table_' to produce and erase before the end of input.
+  std::vector<char*> evictedGroups_;
+
+  // Number of groups freed before the end of input.
+  uint64_t numEvictedGroups_{0};
+
   // In case of partial streaming aggregation, the input vector passed to
   // addInput(). A set of rows that belong to the last group of pre-grouped
   // keys need to be processed after flushing the hash table and accumulators.
@@ -115,6 +115,13 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  const auto evictionBatches = operatorCtx_->driverCtx()
+                                   ->queryConfig()
+                                   .aggregationClusteredInputEvictionBatches();
+  if (aggregationNode_->clusteredInput() && evictionBatches > 0) {
+    groupingSet_->setClusteredInput(evictionBatches);
+  }
+
   aggregationNode_.reset();
 }
 
@@ -242,6 +249,16 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->isSortFallback()) {
+    runtimeStats[kSortFallback] = RuntimeMetric(1);
+  }
+  if (groupingSet_->hasSharedDistinctTable()) {
+    runtimeStats[kSharedDistinctTable] = RuntimeMetric(1);
+  }
+  if (groupingSet_->numEvictedGroups() > 0) {
+    runtimeStats[kNumEvictedGroups] =
+        RuntimeMetric(groupingSet_->numEvictedGroups());
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
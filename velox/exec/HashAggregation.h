@@ -22,6 +22,20 @@ namespace facebook::velox::exec {
 
 class HashAggregation : public Operator {
  public:
+  /// Runtime stat that is set to 1 if the aggregation switched to sort-based
+  /// aggregation. See QueryConfig::kAggregationSortFallbackMinPct.
+  static inline const std::string kSortFallback{"sortFallback"};
+
+  /// Runtime stat that is set to 1 if the aggregations over distinct inputs
+  /// use a shared hash table. See
+  /// QueryConfig::kDistinctAggregationSharedTableMinPct.
+  static inline const std::string kSharedDistinctTable{"sharedDistinctTable"};
+
+  /// Runtime stat with the number of groups produced and freed before the end
+  /// of input because the input is clustered on the grouping keys. See
+  /// core::AggregationNode::clusteredInput().
+  static inline const std::string kNumEvictedGroups{"numEvictedGroups"};
+
   HashAggregation(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -43,6 +43,80 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+// Returns true if a bloom filter over join key values of 'type' can be pushed
+// down into the probe side table scan.
+bool isKeyBloomFilterSupported(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the size in bytes of a bloom filter for 'numDistinct' values.
+uint64_t keyBloomFilterSize(uint64_t numDistinct) {
+  return std::max<uint64_t>(4, bits::nextPowerOfTwo(numDistinct) / 4) *
+      sizeof(uint64_t);
+}
+
+template <TypeKind Kind>
+void addKeysToBloomFilter(
+    const BaseVector& values,
+    vector_size_t numRows,
+    common::BloomFilterValues::Bits& bloomFilter) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto* simpleValues = values.asUnchecked<SimpleVector<T>>();
+  for (auto row = 0; row < numRows; ++row) {
+    if (simpleValues->isNullAt(row)) {
+      continue;
+    }
+    const auto value = simpleValues->valueAt(row);
+    if constexpr (std::is_same_v<T, StringView>) {
+      bloomFilter.insert(
+          common::BloomFilterValues::hashBytes(value.data(), value.size()));
+    } else {
+      bloomFilter.insert(common::BloomFilterValues::hashInt64(value));
+    }
+  }
+}
+
+// Adds the non-null values of the first 'numRows' rows of 'values' to
+// 'bloomFilter'.
+void addKeysToBloomFilter(
+    const BaseVector& values,
+    vector_size_t numRows,
+    common::BloomFilterValues::Bits& bloomFilter) {
+  switch (values.typeKind()) {
+    case TypeKind::TINYINT:
+      return addKeysToBloomFilter<TypeKind::TINYINT>(
+          values, numRows, bloomFilter);
+    case TypeKind::SMALLINT:
+      return addKeysToBloomFilter<TypeKind::SMALLINT>(
+          values, numRows, bloomFilter);
+    case TypeKind::INTEGER:
+      return addKeysToBloomFilter<TypeKind::INTEGER>(
+          values, numRows, bloomFilter);
+    case TypeKind::BIGINT:
+      return addKeysToBloomFilter<TypeKind::BIGINT>(
+          values, numRows, bloomFilter);
+    case TypeKind::VARCHAR:
+      return addKeysToBloomFilter<TypeKind::VARCHAR>(
+          values, numRows, bloomFilter);
+    case TypeKind::VARBINARY:
+      return addKeysToBloomFilter<TypeKind::VARBINARY>(
+          values, numRows, bloomFilter);
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported join key type: {}", values.type()->toString());
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -203,7 +277,11 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), &spillStats_);
+        config->readBufferSize,
+        pool(),
+        &spillStats_,
+        config->executor,
+        config->numReadAheadBuffers);
     startPartitionBit =
         spillPartition->id().partitionBitOffset() + config->numPartitionBits;
     // Disable spilling if exceeding the max spill level and the query might run
@@ -745,11 +823,15 @@ bool HashBuild::finishHashBuild() {
   CpuWallTiming timing;
   {
     CpuWallTimer cpuWallTimer{timing};
+    table_->setRadixPartitionedJoinBuild(
+        operatorCtx_->driverCtx()
+            ->queryConfig()
+            .hashJoinRadixPartitionedBuildEnabled());
     table_->prepareJoinTable(
         std::move(otherTables),
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit,
-        allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
+        allowParallelJoinBuild ? operatorCtx_->task()->driverExecutor()
                                : nullptr);
   }
   stats_.wlock()->addRuntimeStat(
@@ -758,6 +840,8 @@ bool HashBuild::finishHashBuild() {
 
   addRuntimeStats();
 
+  auto keyBloomFilters = makeKeyBloomFilters(spillPartitions);
+
   // Setup spill function for spilling hash table directly from hash join
   // bridge after transferring of table ownership.
   HashJoinTableSpillFunc tableSpillFunc;
@@ -776,13 +860,92 @@ bool HashBuild::finishHashBuild() {
       std::move(table_),
       std::move(spillPartitions),
       joinHasNullKeys_,
-      std::move(tableSpillFunc));
+      std::move(tableSpillFunc),
+      std::move(keyBloomFilters));
   if (canSpill()) {
     stateCleared_ = true;
   }
   return true;
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeKeyBloomFilters(
+    const SpillPartitionSet& spillPartitions) {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  // Value range and value set filters are pushed down from the hashers if the
+  // table is not in kHash mode. With spilling, the table does not have all
+  // the build side keys. The probe side only pushes down filters for the join
+  // types below.
+  if (maxSize == 0 || table_->hashMode() != BaseHashTable::HashMode::kHash ||
+      !spillPartitions.empty() || table_->numDistinct() == 0 ||
+      table_->numDistinct() > std::numeric_limits<int32_t>::max() ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
+        isRightJoin(joinType_))) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  uint64_t totalSize{0};
+  for (const auto& hasher : hashers) {
+    if (!isKeyBloomFilterSupported(*hasher->type())) {
+      return {};
+    }
+    totalSize += keyBloomFilterSize(table_->numDistinct());
+  }
+  if (totalSize > maxSize) {
+    return {};
+  }
+
+  CpuWallTiming timing;
+  std::vector<std::shared_ptr<common::Filter>> filters;
+  {
+    CpuWallTimer cpuWallTimer{timing};
+    // One bloom filter per key column. A probe row can only match if each of
+    // its keys is in the corresponding filter.
+    std::vector<std::shared_ptr<common::BloomFilterValues::Bits>> bloomFilters;
+    std::vector<VectorPtr> values;
+    for (const auto& hasher : hashers) {
+      auto bloomFilter = std::make_shared<common::BloomFilterValues::Bits>();
+      bloomFilter->reset(table_->numDistinct());
+      bloomFilters.push_back(std::move(bloomFilter));
+      values.push_back(BaseVector::create(hasher->type(), 0, pool()));
+    }
+
+    constexpr int32_t kBatchSize = 1'024;
+    std::vector<char*> rows(kBatchSize);
+    BaseHashTable::RowsIterator iter;
+    auto* rowContainer = table_->rows();
+    while (const auto numRows = table_->listAllRows(
+               &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) {
+      for (auto i = 0; i < hashers.size(); ++i) {
+        RowContainer::extractColumn(
+            rows.data(),
+            numRows,
+            rowContainer->columnAt(i),
+            /*columnHasNulls=*/true,
+            values[i]);
+        addKeysToBloomFilter(*values[i], numRows, *bloomFilters[i]);
+      }
+    }
+    for (auto& bloomFilter : bloomFilters) {
+      filters.push_back(std::make_shared<common::BloomFilterValues>(
+          std::move(bloomFilter), /*nullAllowed=*/false));
+    }
+  }
+
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      kKeyBloomFilterBuildWallNanos,
+      RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      kKeyBloomFilterSize,
+      RuntimeCounter(totalSize, RuntimeCounter::Unit::kBytes));
+  return filters;
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
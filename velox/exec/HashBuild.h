@@ -56,6 +56,13 @@ class HashBuild final : public Operator {
   };
   static std::string stateName(State state);
 
+  /// Runtime stats for the bloom filters built over the join keys for
+  /// pushdown into the probe side. See
+  /// QueryConfig::kHashProbeBloomFilterPushdownMaxSize.
+  static inline const std::string kKeyBloomFilterBuildWallNanos{
+      "keyBloomFilterBuildWallNanos"};
+  static inline const std::string kKeyBloomFilterSize{"keyBloomFilterSize"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -107,6 +114,14 @@ class HashBuild final : public Operator {
   // merged from all the other drivers.
   bool finishHashBuild();
 
+  // Invoked by finishHashBuild() after the hash table is built to create one
+  // bloom filter per join key for pushdown into the probe side. Returns an
+  // empty vector if the table is not in kHash mode, has spilled partitions,
+  // has an unsupported key type or the filters would exceed the configured
+  // size.
+  std::vector<std::shared_ptr<common::Filter>> makeKeyBloomFilters(
+      const SpillPartitionSet& spillPartitions);
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
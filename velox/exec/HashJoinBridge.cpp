@@ -211,7 +211,8 @@ void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys,
-    HashJoinTableSpillFunc&& tableSpillFunc) {
+    HashJoinTableSpillFunc&& tableSpillFunc,
+    std::vector<std::shared_ptr<common::Filter>> keyBloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   std::vector<ContinuePromise> promises;
@@ -230,6 +231,7 @@ void HashJoinBridge::setHashTable(
         std::move(restoringSpillPartitionId_),
         spillPartitionIdSet,
         hasNullKeys);
+    buildResult_->keyBloomFilters = std::move(keyBloomFilters);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
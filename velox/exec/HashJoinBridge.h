@@ -48,11 +48,15 @@ class HashJoinBridge : public JoinBridge {
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'keyBloomFilters' has one bloom filter per join key of 'table' for
+  /// pushdown into the probe side if non-empty. See
+  /// QueryConfig::kHashProbeBloomFilterPushdownMaxSize.
   void setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys,
-      HashJoinTableSpillFunc&& tableSpillFunc);
+      HashJoinTableSpillFunc&& tableSpillFunc,
+      std::vector<std::shared_ptr<common::Filter>> keyBloomFilters = {});
 
   /// Invoked by the probe operator to append the spilled hash table partitions
   /// while probing. The function appends the spilled table partitions into
@@ -90,6 +94,10 @@ class HashJoinBridge : public JoinBridge {
     /// fine-grained spilling for hash table, either 'table' is empty or
     /// 'spillPartitionIds' is empty.
     SpillPartitionIdSet spillPartitionIds;
+
+    /// Bloom filters over the values of each join key in 'table'. Empty if
+    /// not built.
+    std::vector<std::shared_ptr<common::Filter>> keyBloomFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
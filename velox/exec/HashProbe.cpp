@@ -290,7 +290,11 @@ void HashProbe::maybeSetupSpillInputReader(
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->executor,
+      spillConfig_->numReadAheadBuffers);
   inputSpillPartitionSet_.erase(iter);
 }
 
@@ -430,25 +434,35 @@ void HashProbe::asyncWaitForHashTable() {
        isRightSemiFilterJoin(joinType_) ||
        (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
        isRightJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->keyBloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
-    // push down.
+    // push down. In kHash mode, the hashers do not track the key values and
+    // the filters are the bloom filters made by the build side.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& keyBloomFilters = hashBuildResult->keyBloomFilters;
+    VELOX_CHECK(
+        keyBloomFilters.empty() ||
+        keyBloomFilters.size() == keyChannels_.size());
     const auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() == BaseHashTable::HashMode::kHash) {
+        dynamicFilters_.emplace(keyChannels_[i], keyBloomFilters[i]);
+      } else if (
+          auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -631,10 +645,13 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
       tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
-      !isRightJoin(joinType_)) {
+      !isRightJoin(joinType_) &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -1934,7 +1951,11 @@ void HashProbe::maybeSetupSpillOutputReader() {
 
   spillOutputReader_ =
       spillOutputPartitionSet_.begin()->second->createUnorderedReader(
-          spillConfig_->readBufferSize, pool(), &spillStats_);
+          spillConfig_->readBufferSize,
+          pool(),
+          &spillStats_,
+          spillConfig_->executor,
+          spillConfig_->numReadAheadBuffers);
   spillOutputPartitionSet_.clear();
 }
 
@@ -415,7 +415,7 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
 }
 
 namespace {
-// Group prefetch size for join build & probe.
+// Group prefetch size for join build.
 constexpr int32_t kPrefetchSize = 64;
 
 // Normalized keys have non0-random bits. Bits need to be propagated
@@ -463,79 +463,10 @@ void HashTable<ignoreNullKeys>::groupProbe(
   checkSize(lookup.rows.size(), false, spillInputStartPartitionBit);
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    groupNormalizedKeyProbe(lookup);
+    probeInGroups<false, true>(lookup);
     return;
   }
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  auto rows = lookup.rows.data();
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-
-    fullProbe<false>(lookup, state1, false);
-    fullProbe<false>(lookup, state2, true);
-    fullProbe<false>(lookup, state3, true);
-    fullProbe<false>(lookup, state4, true);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<false>(lookup, state1, false);
-  }
-}
-
-template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  auto rows = lookup.rows.data();
-  constexpr int32_t kKeyOffset =
-      -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
-    fullProbe<false, true>(lookup, state2, true);
-    fullProbe<false, true>(lookup, state3, true);
-    fullProbe<false, true>(lookup, state4, true);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
-  }
+  probeInGroups<false, false>(lookup);
 }
 
 template <bool ignoreNullKeys>
@@ -597,40 +528,10 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
+    probeInGroups<true, true>(lookup);
     return;
   }
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-  }
+  probeInGroups<true, false>(lookup);
 }
 
 template <bool ignoreNullKeys>
@@ -676,34 +577,69 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
+template <bool isJoin, bool isNormalizedKey>
+void HashTable<ignoreNullKeys>::probeInGroups(HashLookup& lookup) {
+  constexpr ProbeState::Operation op =
+      isJoin ? ProbeState::Operation::kProbe : ProbeState::Operation::kInsert;
+  constexpr int32_t kKeyOffset =
+      isNormalizedKey ? -static_cast<int32_t>(sizeof(normalized_key_t)) : 0;
+  ProbeState states[kMaxProbeGroupSize];
+  const int32_t groupSize = probeGroupSize_;
+  const int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState states[kPrefetchSize];
-  const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
-  char** hits = lookup.hits.data();
-  constexpr int32_t kKeyOffset =
-      -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      int32_t row = rows[probeIndex + i];
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += groupSize) {
+    const int32_t numStates = std::min(groupSize, numProbes - probeIndex);
+    // Issues the bucket loads for the whole group.
+    for (int32_t i = 0; i < numStates; ++i) {
+      const int32_t row = rows[probeIndex + i];
       states[i].preProbe(*this, hashes[row], row);
     }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      states[i].firstProbe(*this, kKeyOffset);
-    }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+    // Compares tags and issues the load of the first candidate row while the
+    // buckets of the later states are still in flight.
+    for (int32_t i = 0; i < numStates; ++i) {
+      states[i].firstProbe<op>(*this, kKeyOffset);
+    }
+    // Compares keys. For group by, inserts from earlier states may have
+    // changed the bucket of a later state, so these reload their tags.
+    for (int32_t i = 0; i < numStates; ++i) {
+      if constexpr (isJoin && isNormalizedKey) {
+        lookup.hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(
+            *this, lookup.normalizedKeys.data());
+      } else {
+        fullProbe<isJoin, isNormalizedKey>(lookup, states[i], i > 0);
+      }
     }
   }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
-  }
+}
+
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::adaptiveProbeGroupSize() const {
+  // The table and the rows it points to are the working set of a probe. If
+  // these fit in the core's cache, the loads hit and the group loop does not
+  // pay for itself. Otherwise, the more misses are outstanding at a time the
+  // better, up to the number of line fill buffers of the core.
+  const uint64_t workingSetBytes =
+      capacity_ * tableSlotSize() + numDistinct_ * rows_->fixedRowSize();
+  if (workingSetBytes <= process::l2CacheSize()) {
+    return kMinProbeGroupSize;
+  }
+  if (workingSetBytes <= process::lastLevelCacheSize()) {
+    return 16;
+  }
+  return kMaxProbeGroupSize;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setProbeGroupSize(int32_t size) {
+  VELOX_CHECK(
+      size == 0 || (size >= 1 && size <= kMaxProbeGroupSize),
+      "Probe group size must be 0 or between 1 and {}: {}",
+      kMaxProbeGroupSize,
+      size);
+  fixedProbeGroupSize_ = size;
+  probeGroupSize_ = size == 0 ? adaptiveProbeGroupSize() : size;
 }
 
 template <bool ignoreNullKeys>
@@ -721,6 +657,9 @@ void HashTable<ignoreNullKeys>::allocateTables(
   sizeBits_ = __builtin_popcountll(sizeMask_);
   checkHashBitsOverlap(spillInputStartPartitionBit);
   bucketOffsetMask_ = sizeMask_ & ~(kBucketSize - 1);
+  if (fixedProbeGroupSize_ == 0) {
+    probeGroupSize_ = adaptiveProbeGroupSize();
+  }
   // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
   // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
   // cache line.
@@ -1088,6 +1027,236 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+HashBitRange HashTable<ignoreNullKeys>::radixJoinBuildBits(
+    int32_t numThreads) const {
+  const uint64_t tableBytes = sizeMask_ + 1;
+  int64_t numPartitions = std::min<int64_t>(
+      kMaxRadixJoinBuildPartitions,
+      bits::nextPowerOfTwo(std::max<uint64_t>(
+          numThreads, tableBytes / process::l2CacheSize())));
+  // A partition spans at least one bucket and more entries than the minimum
+  // for a parallel build.
+  while (numPartitions > 1 &&
+         (tableBytes / numPartitions < kBucketSize ||
+          capacity_ / numPartitions <= minTableSizeForParallelJoinBuild_)) {
+    numPartitions /= 2;
+  }
+  const uint8_t numBits = __builtin_ctzll(numPartitions);
+  return HashBitRange(sizeBits_ - numBits, sizeBits_);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::radixPartitionedJoinBuild() {
+  process::TraceContext trace("HashTable::radixPartitionedJoinBuild");
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::radixPartitionedJoinBuild",
+      rows_->pool());
+  const int32_t numThreads = 1 + otherTables_.size();
+  const auto radixBits = radixJoinBuildBits(numThreads);
+  const int32_t numPartitions = radixBits.numPartitions();
+  numRadixJoinBuildPartitions_ = numPartitions;
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> countSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> scatterSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
+  // 'partitionedRows', 'overflowPerPartition' and 'overflowHashesPerPartition'
+  // are used in the async threads, so declare them before the sync guard.
+  std::vector<RadixPartitionedRows> partitionedRows;
+  std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
+  std::vector<std::vector<uint64_t>> overflowHashesPerPartition(numPartitions);
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(countSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(scatterSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(buildSteps, error, offThreadBuildTiming_, true);
+  });
+
+  const auto getTable = [this](size_t i) INLINE_LAMBDA {
+    return i == 0 ? this : otherTables_[i - 1].get();
+  };
+
+  partitionedRows.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    partitionedRows.emplace_back(*rows_->pool());
+    partitionedRows.back().offsets.resize(numPartitions + 1, 0);
+    partitionedRows.back().listedHashes.resize(getTable(i)->rows_->numRows());
+  }
+
+  // Passing driver context directly to avoid cross thread access to thread
+  // local driver thread context.
+  const DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+
+  const auto runSteps =
+      [&](std::vector<std::shared_ptr<AsyncSource<bool>>>& steps,
+          int32_t numSteps,
+          const std::function<void(int32_t)>& step) {
+        for (auto i = 0; i < numSteps; ++i) {
+          steps.push_back(std::make_shared<AsyncSource<bool>>([i, &step]() {
+            step(i);
+            return std::make_unique<bool>(true);
+          }));
+          buildExecutor_->add([driverCtx, source = steps.back()]() {
+            ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+            source->prepare();
+          });
+        }
+        std::exception_ptr error;
+        syncWorkItems(steps, error, offThreadBuildTiming_);
+        if (error != nullptr) {
+          std::rethrow_exception(error);
+        }
+      };
+
+  constexpr int32_t kBatch = 1024;
+  // Hashes and counts the rows per partition of each RowContainer. This also
+  // computes the normalized keys in kNormalizedKey mode.
+  runSteps(countSteps, numThreads, [&](int32_t i) {
+    auto* table = getTable(i);
+    auto& partitioned = partitionedRows[i];
+    auto& offsets = partitioned.offsets;
+    raw_vector<char*> rows(kBatch);
+    raw_vector<uint64_t> hashes(kBatch);
+    RowContainerIterator iter;
+    int64_t numListed = 0;
+    while (const auto numRows = table->rows_->listRows(
+               &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+      hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
+      for (auto row = 0; row < numRows; ++row) {
+        ++offsets[radixBits.partition(hashes[row]) + 1];
+      }
+      std::copy(
+          hashes.begin(),
+          hashes.begin() + numRows,
+          partitioned.listedHashes.begin() + numListed);
+      numListed += numRows;
+    }
+  });
+
+  // Large allocations are made here, before any scatter is started, to reduce
+  // the chances of concurrency issues on OOM.
+  for (auto& partitioned : partitionedRows) {
+    auto& offsets = partitioned.offsets;
+    for (auto partition = 0; partition < numPartitions; ++partition) {
+      offsets[partition + 1] += offsets[partition];
+    }
+    partitioned.rows.resize(offsets.back());
+    partitioned.hashes.resize(offsets.back());
+  }
+
+  runSteps(scatterSteps, numThreads, [&](int32_t i) {
+    auto* table = getTable(i);
+    auto& partitioned = partitionedRows[i];
+    std::vector<int64_t> cursors(
+        partitioned.offsets.begin(), partitioned.offsets.end() - 1);
+    raw_vector<char*> rows(kBatch);
+    const auto* hashes = partitioned.listedHashes.data();
+    RowContainerIterator iter;
+    while (const auto numRows = table->rows_->listRows(
+               &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+      for (auto row = 0; row < numRows; ++row) {
+        const auto hash = hashes[row];
+        const auto index = cursors[radixBits.partition(hash)]++;
+        partitioned.rows[index] = rows[row];
+        partitioned.hashes[index] = hash;
+      }
+      hashes += numRows;
+    }
+    VELOX_CHECK_EQ(table->rows_->numRows(), partitioned.offsets.back());
+    VELOX_CHECK_EQ(
+        hashes - partitioned.listedHashes.data(), partitioned.offsets.back());
+    // Frees the listed hashes before the build allocates.
+    partitioned.listedHashes.clear();
+    partitioned.listedHashes.shrink_to_fit();
+  });
+
+  VELOX_CHECK(joinInsertAllocators_.empty());
+  joinInsertAllocators_.reserve(numThreads - 1);
+  for (int i = 0; i < numThreads - 1; ++i) {
+    joinInsertAllocators_.push_back(
+        std::make_unique<HashStringAllocator>(rows_->pool()));
+  }
+  // Each thread inserts with its own allocator and takes the next partition
+  // until all are built.
+  std::atomic_int32_t nextPartition{0};
+  runSteps(buildSteps, numThreads, [&](int32_t i) {
+    auto* allocator = i == 0 ? &rows_->stringAllocator()
+                             : joinInsertAllocators_[i - 1].get();
+    for (auto partition = nextPartition++; partition < numPartitions;
+         partition = nextPartition++) {
+      buildRadixJoinPartition(
+          partition,
+          radixBits,
+          partitionedRows,
+          allocator,
+          overflowPerPartition[partition],
+          overflowHashesPerPartition[partition]);
+    }
+  });
+
+  numRadixJoinBuildOverflowRows_ = 0;
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    auto& overflows = overflowPerPartition[partition];
+    if (overflows.empty()) {
+      continue;
+    }
+    numRadixJoinBuildOverflowRows_ += overflows.size();
+    auto& hashes = overflowHashesPerPartition[partition];
+    VELOX_CHECK_EQ(overflows.size(), hashes.size());
+    insertForJoin(
+        rows_.get(),
+        overflows.data(),
+        hashes.data(),
+        overflows.size(),
+        nullptr,
+        &rows_->stringAllocator());
+  }
+
+  for (auto i = 0; i < numThreads; ++i) {
+    auto* table = getTable(i);
+    VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildRadixJoinPartition(
+    int32_t partition,
+    const HashBitRange& radixBits,
+    const std::vector<RadixPartitionedRows>& partitionedRows,
+    HashStringAllocator* allocator,
+    std::vector<char*>& overflow,
+    std::vector<uint64_t>& overflowHashes) {
+  const PartitionBoundIndexType partitionBytes = 1L << radixBits.begin();
+  TableInsertPartitionInfo partitionInfo{
+      partition * partitionBytes,
+      (partition + 1) * partitionBytes,
+      overflow,
+      &overflowHashes};
+  for (auto i = 0; i < partitionedRows.size(); ++i) {
+    auto* table = i == 0 ? this : otherTables_[i - 1].get();
+    const auto& partitioned = partitionedRows[i];
+    const auto begin = partitioned.offsets[partition];
+    const auto numRows = partitioned.offsets[partition + 1] - begin;
+    if (numRows == 0) {
+      continue;
+    }
+    // 'groups' and 'hashes' are not modified by the insert.
+    insertForJoin(
+        table->rows_.get(),
+        const_cast<char**>(partitioned.rows.data() + begin),
+        const_cast<uint64_t*>(partitioned.hashes.data() + begin),
+        numRows,
+        &partitionInfo,
+        allocator);
+    table->numParallelBuildRows_ += numRows;
+  }
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1206,7 +1375,7 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
       -static_cast<int32_t>(sizeof(normalized_key_t));
   auto insertFn = [&](int32_t /*row*/, PartitionBoundIndexType index) {
     if (partitionInfo != nullptr && !partitionInfo->inRange(index)) {
-      partitionInfo->addOverflow(inserted);
+      partitionInfo->addOverflow(inserted, hash);
       return nullptr;
     }
     storeRowPointer(index, hash, inserted);
@@ -1329,7 +1498,11 @@ void HashTable<ignoreNullKeys>::rehash(
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
-    parallelJoinBuild();
+    if (radixPartitionedJoinBuild_) {
+      radixPartitionedJoinBuild();
+    } else {
+      parallelJoinBuild();
+    }
     return;
   }
   raw_vector<uint64_t> hashes;
@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -32,12 +33,18 @@ struct TableInsertPartitionInfo {
   /// Used to contains the overflowed rows which can't be inserted into the
   /// given table partition range.
   std::vector<char*>& overflows;
+  /// If not null, receives the hash of each row added to 'overflows'.
+  std::vector<uint64_t>* const overflowHashes;
 
   TableInsertPartitionInfo(
       PartitionBoundIndexType _start,
       PartitionBoundIndexType _end,
-      std::vector<char*>& _overflows)
-      : start(_start), end(_end), overflows(_overflows) {
+      std::vector<char*>& _overflows,
+      std::vector<uint64_t>* _overflowHashes = nullptr)
+      : start(_start),
+        end(_end),
+        overflows(_overflows),
+        overflowHashes(_overflowHashes) {
     VELOX_CHECK_GE(start, 0);
     VELOX_CHECK_LT(start, end);
   }
@@ -48,8 +55,12 @@ struct TableInsertPartitionInfo {
   }
 
   /// Adds 'row' falls outside of this partititon range into 'overflows'.
-  void addOverflow(char* row) {
+  /// 'hash' is the hash of 'row'.
+  void addOverflow(char* row, uint64_t hash) {
     overflows.push_back(row);
+    if (overflowHashes != nullptr) {
+      overflowHashes->push_back(hash);
+    }
   }
 };
 
@@ -287,6 +298,14 @@ class BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) = 0;
 
+  /// If 'enabled', a parallel build in prepareJoinTable() splits the table
+  /// into many partitions that fit in the CPU cache instead of one partition
+  /// per build thread. The build rows are first scattered by the hash bits
+  /// that select their partition, then the build threads take turns
+  /// inserting whole partitions. The probe needs no change since the same
+  /// hash bits select the partition of a probe row in the table.
+  virtual void setRadixPartitionedJoinBuild(bool enabled) = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -566,6 +585,23 @@ class HashTable : public BaseHashTable {
     return hashMode_;
   }
 
+  /// Smallest and largest number of rows that groupProbe() and joinProbe()
+  /// look up together so that their cache misses overlap.
+  static constexpr int32_t kMinProbeGroupSize = 4;
+  static constexpr int32_t kMaxProbeGroupSize = 64;
+
+  /// Returns the number of rows that are looked up together. Unless set with
+  /// setProbeGroupSize(), this is chosen whenever the table is allocated:
+  /// small groups if the table and its rows fit in the L2 cache, larger ones
+  /// if they spill to the last level cache or to memory.
+  int32_t probeGroupSize() const {
+    return probeGroupSize_;
+  }
+
+  /// Fixes the probe group size to 'size', between 1 and kMaxProbeGroupSize.
+  /// 0 restores the adaptive choice. Used in tests and benchmarks.
+  void setProbeGroupSize(int32_t size);
+
   void decideHashMode(
       int32_t numNew,
       int8_t spillInputStartPartitionBit,
@@ -588,6 +624,16 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit,
       folly::Executor* executor = nullptr) override;
 
+  void setRadixPartitionedJoinBuild(bool enabled) override {
+    radixPartitionedJoinBuild_ = enabled;
+  }
+
+  /// Returns the number of partitions of the last radix partitioned join
+  /// build. 0 if the last build was not radix partitioned.
+  int32_t numRadixJoinBuildPartitions() const {
+    return numRadixJoinBuildPartitions_;
+  }
+
   void prepareForJoinProbe(
       HashLookup& lookup,
       const RowVectorPtr& input,
@@ -858,6 +904,52 @@ class HashTable : public BaseHashTable {
       const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
       std::vector<char*>& overflow);
 
+  // Maximum number of partitions of a radix partitioned join build.
+  static constexpr int32_t kMaxRadixJoinBuildPartitions = 4096;
+
+  // The rows of one build side RowContainer scattered into the partitions of
+  // a radix partitioned join build. The rows of partition i are at
+  // ['offsets[i]', 'offsets[i + 1]') in 'rows' and 'hashes'.
+  struct RadixPartitionedRows {
+    explicit RadixPartitionedRows(memory::MemoryPool& pool)
+        : rows(memory::StlAllocator<char*>(pool)),
+          hashes(memory::StlAllocator<uint64_t>(pool)),
+          listedHashes(memory::StlAllocator<uint64_t>(pool)) {}
+
+    std::vector<int64_t> offsets;
+    std::vector<char*, memory::StlAllocator<char*>> rows;
+    std::vector<uint64_t, memory::StlAllocator<uint64_t>> hashes;
+    // The hashes of the counting pass in RowContainer list order. Read by the
+    // scatter pass and freed after it.
+    std::vector<uint64_t, memory::StlAllocator<uint64_t>> listedHashes;
+  };
+
+  // Returns the hash bits that select the partition of a row in a radix
+  // partitioned join build with 'numThreads' build threads. The partitions
+  // are ranges of bucket offsets, i.e. the top bits of the bucket offset. A
+  // partition's range of the table fits in the L2 cache if possible.
+  HashBitRange radixJoinBuildBits(int32_t numThreads) const;
+
+  // Builds the join table like parallelJoinBuild() with the partitions given
+  // by radixJoinBuildBits(). First, each RowContainer hashes and counts its
+  // rows per partition, then copies the rows and their hashes into contiguous
+  // runs by partition. Next, '1 + otherTables_.size()' threads take the next
+  // unbuilt partition until all are built. Rows that would go past the end
+  // of their partition are inserted sequentially at the end. Rows are hashed
+  // only once.
+  void radixPartitionedJoinBuild();
+
+  // Inserts the rows of 'partition' from all of 'partitionedRows' into
+  // 'this'. The rows that would have gone past the end of the partition are
+  // returned in 'overflow' and their hashes in 'overflowHashes'.
+  void buildRadixJoinPartition(
+      int32_t partition,
+      const HashBitRange& radixBits,
+      const std::vector<RadixPartitionedRows>& partitionedRows,
+      HashStringAllocator* allocator,
+      std::vector<char*>& overflow,
+      std::vector<uint64_t>& overflowHashes);
+
   // Assigns a partition to each row of 'subtable' in RowPartitions of
   // subtable's RowContainer. If 'hashMode_' is kNormalizedKeys, records the
   // normalized key of each row below the row in its container.
@@ -885,15 +977,20 @@ class HashTable : public BaseHashTable {
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
-  // Shortcut path for group by with normalized keys.
-  void groupNormalizedKeyProbe(HashLookup& lookup);
+  // Probes or inserts 'lookup.rows' in groups of 'probeGroupSize_'. The
+  // bucket loads of a group are issued before the tags of the first bucket
+  // are compared, and the candidate row loads of a group before the first
+  // keys are compared, so that the cache misses of the group overlap.
+  template <bool isJoin, bool isNormalizedKey>
+  void probeInGroups(HashLookup& lookup);
+
+  // Returns the probe group size for the current size of the table and its
+  // rows relative to the CPU cache sizes.
+  int32_t adaptiveProbeGroupSize() const;
 
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
-  // Shortcut for probe with normalized keys.
-  void joinNormalizedKeyProbe(HashLookup& lookup);
-
   // Returns the total size of the variable size 'columns' in 'row'.
   // NOTE: No checks are done in the method for performance considerations.
   // Caller needs to make sure only variable size columns are inside of
@@ -1047,6 +1144,13 @@ class HashTable : public BaseHashTable {
   // number.
   int64_t bucketOffsetMask_{0};
   int64_t numBuckets_{0};
+
+  // Number of rows looked up together by groupProbe() and joinProbe().
+  int32_t probeGroupSize_{kMinProbeGroupSize};
+
+  // Probe group size set by setProbeGroupSize(). 0 if adaptive.
+  int32_t fixedProbeGroupSize_{0};
+
   int64_t numDistinct_{0};
   // Counts the number of tombstone table slots.
   int64_t numTombstones_{0};
@@ -1092,6 +1196,16 @@ class HashTable : public BaseHashTable {
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 
+  // True if a parallel join build uses radixPartitionedJoinBuild().
+  bool radixPartitionedJoinBuild_{false};
+
+  // Number of partitions of the last radixPartitionedJoinBuild().
+  int32_t numRadixJoinBuildPartitions_{0};
+
+  // Number of rows that overflowed their partition in the last
+  // radixPartitionedJoinBuild() and were inserted sequentially.
+  int64_t numRadixJoinBuildOverflowRows_{0};
+
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HierarchicalAggregation.h"
+
+#include <algorithm>
+#include <numeric>
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+HierarchicalAggregation::HierarchicalAggregation(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    : Operator(
+          driverCtx,
+          aggregationNode->outputType(),
+          operatorId,
+          aggregationNode->id(),
+          "HierarchicalAggregation"),
+      aggregationNode_(aggregationNode),
+      numKeys_(aggregationNode->groupingKeys().size()) {
+  VELOX_CHECK(!aggregationNode_->groupingSets().empty());
+}
+
+void HierarchicalAggregation::initialize() {
+  Operator::initialize();
+
+  VELOX_CHECK(pool()->trackUsage());
+
+  const auto& inputType = aggregationNode_->sources()[0]->outputType();
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(numKeys_);
+  for (const auto& key : aggregationNode_->groupingKeys()) {
+    keyChannels.push_back(exprToChannel(key.get(), inputType));
+  }
+
+  makeLevels();
+  for (auto i = 0; i < levels_.size(); ++i) {
+    createGroupingSet(i, keyChannels);
+  }
+
+  aggregationNode_.reset();
+}
+
+void HierarchicalAggregation::makeLevels() {
+  const auto& groupingKeys = aggregationNode_->groupingKeys();
+  std::unordered_map<std::string, column_index_t> keyIndices;
+  for (auto i = 0; i < numKeys_; ++i) {
+    keyIndices[groupingKeys[i]->name()] = i;
+  }
+
+  levels_.emplace_back();
+  levels_[0].keys.resize(numKeys_);
+  std::iota(levels_[0].keys.begin(), levels_[0].keys.end(), 0);
+
+  const auto& groupingSets = aggregationNode_->groupingSets();
+  for (auto i = 0; i < groupingSets.size(); ++i) {
+    std::vector<column_index_t> keys;
+    keys.reserve(groupingSets[i].size());
+    for (const auto& name : groupingSets[i]) {
+      keys.push_back(keyIndices.at(name));
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto it = std::find_if(levels_.begin(), levels_.end(), [&](auto& level) {
+      return level.keys == keys;
+    });
+    if (it == levels_.end()) {
+      levels_.emplace_back();
+      levels_.back().keys = std::move(keys);
+      it = levels_.end() - 1;
+    }
+    it->groupIds.push_back(i);
+  }
+
+  // A level can only be aggregated from a level with more keys, which then
+  // comes first.
+  std::stable_sort(
+      levels_.begin() + 1, levels_.end(), [](const auto& a, const auto& b) {
+        return a.keys.size() > b.keys.size();
+      });
+
+  for (auto i = 1; i < levels_.size(); ++i) {
+    auto& level = levels_[i];
+    // The finer level with the fewest keys has the fewest groups to aggregate.
+    int32_t parent = 0;
+    for (auto j = 1; j < i; ++j) {
+      const auto& candidate = levels_[j].keys;
+      if (candidate.size() > level.keys.size() &&
+          candidate.size() < levels_[parent].keys.size() &&
+          std::includes(
+              candidate.begin(),
+              candidate.end(),
+              level.keys.begin(),
+              level.keys.end())) {
+        parent = j;
+      }
+    }
+    level.parent = parent;
+    levels_[parent].children.push_back(i);
+  }
+}
+
+void HierarchicalAggregation::createGroupingSet(
+    int32_t index,
+    const std::vector<column_index_t>& keyChannels) {
+  auto& level = levels_[index];
+  const auto& sourceType = aggregationNode_->sources()[0]->outputType();
+  const auto numLevelKeys = level.keys.size();
+
+  // The finest level aggregates the input. The other levels aggregate the
+  // intermediate results of their parent.
+  const bool isRawInput = level.parent == -1;
+  const RowTypePtr& inputType =
+      isRawInput ? sourceType : levels_[level.parent].intermediateType;
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  std::vector<TypePtr> keyTypes;
+  for (auto key : level.keys) {
+    const auto& type = sourceType->childAt(keyChannels[key]);
+    column_index_t channel = keyChannels[key];
+    if (!isRawInput) {
+      const auto& parentKeys = levels_[level.parent].keys;
+      channel = std::lower_bound(parentKeys.begin(), parentKeys.end(), key) -
+          parentKeys.begin();
+    }
+    hashers.push_back(VectorHasher::create(type, channel));
+    keyTypes.push_back(type);
+  }
+
+  // The aggregates follow the grouping keys and the group id in the output
+  // of the plan node.
+  auto aggregates = toAggregateInfo(
+      *aggregationNode_, *operatorCtx_, numKeys_ + 1, expressionEvaluator_);
+
+  auto resultTypes = keyTypes;
+  auto intermediateTypes = keyTypes;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    auto& aggregate = aggregates[i];
+    if (!isRawInput) {
+      const auto numParentKeys = levels_[level.parent].keys.size();
+      aggregate.inputs = {static_cast<column_index_t>(numParentKeys + i)};
+      aggregate.constantInputs = {nullptr};
+      aggregate.mask = std::nullopt;
+    }
+    aggregate.output = numLevelKeys + i;
+    resultTypes.push_back(aggregate.function->resultType());
+    intermediateTypes.push_back(aggregate.intermediateType);
+  }
+  level.resultType = ROW(std::move(resultTypes));
+  level.intermediateType = ROW(std::move(intermediateTypes));
+
+  level.groupingSet = std::make_unique<GroupingSet>(
+      inputType,
+      std::move(hashers),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>{},
+      std::move(aggregates),
+      false, // ignoreNullKeys
+      false, // isPartial
+      isRawInput,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+}
+
+void HierarchicalAggregation::addInput(RowVectorPtr input) {
+  levels_[0].groupingSet->addInput(input, false /*mayPushdown*/);
+}
+
+void HierarchicalAggregation::noMoreInput() {
+  Operator::noMoreInput();
+  levels_[0].groupingSet->noMoreInput();
+}
+
+RowVectorPtr HierarchicalAggregation::getOutput() {
+  if (finished_ || !noMoreInput_) {
+    return nullptr;
+  }
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  while (pendingOutput_.empty()) {
+    if (outputLevel_ == levels_.size()) {
+      finished_ = true;
+      return nullptr;
+    }
+
+    auto& level = levels_[outputLevel_];
+    const auto maxOutputRows = level.keys.empty() ? 1 : outputBatchRows();
+    auto result = std::static_pointer_cast<RowVector>(
+        BaseVector::create(level.resultType, maxOutputRows, pool()));
+    RowVectorPtr intermediateResult;
+    if (!level.children.empty()) {
+      intermediateResult = std::static_pointer_cast<RowVector>(
+          BaseVector::create(level.intermediateType, 0, pool()));
+    }
+
+    if (!level.groupingSet->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            outputIterator_,
+            result,
+            intermediateResult)) {
+      // All the input of the children of 'level' is in.
+      for (auto child : level.children) {
+        levels_[child].groupingSet->noMoreInput();
+      }
+      level.groupingSet.reset();
+      outputIterator_.reset();
+      ++outputLevel_;
+      continue;
+    }
+
+    for (auto child : level.children) {
+      levels_[child].groupingSet->addInput(intermediateResult, false);
+    }
+    for (auto groupId : level.groupIds) {
+      pendingOutput_.push_back(makeOutput(level, result, groupId));
+    }
+  }
+
+  auto output = std::move(pendingOutput_.back());
+  pendingOutput_.pop_back();
+  return output;
+}
+
+RowVectorPtr HierarchicalAggregation::makeOutput(
+    const Level& level,
+    const RowVectorPtr& result,
+    int64_t groupId) {
+  const auto numRows = result->size();
+  std::vector<VectorPtr> children(outputType_->size());
+  for (auto i = 0; i < numKeys_; ++i) {
+    children[i] =
+        BaseVector::createNullConstant(outputType_->childAt(i), numRows, pool());
+  }
+  for (auto i = 0; i < level.keys.size(); ++i) {
+    children[level.keys[i]] = result->childAt(i);
+  }
+  children[numKeys_] =
+      BaseVector::createConstant(BIGINT(), groupId, numRows, pool());
+  for (auto i = level.keys.size(); i < result->childrenSize(); ++i) {
+    children[numKeys_ + 1 + i - level.keys.size()] = result->childAt(i);
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numRows, std::move(children));
+}
+
+void HierarchicalAggregation::close() {
+  Operator::close();
+  pendingOutput_.clear();
+  levels_.clear();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/GroupingSet.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Computes the grouping sets of an AggregationNode with grouping sets. The
+/// input is aggregated once over all grouping keys. After all input is
+/// received, each coarser grouping set, or level, is aggregated from the
+/// intermediate results of the smallest finer level that contains its keys.
+/// The levels are produced finest first, so that a level has received all
+/// its input when its turn comes, and its memory is freed once it has been
+/// produced.
+class HierarchicalAggregation : public Operator {
+ public:
+  HierarchicalAggregation(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+
+  void initialize() override;
+
+  bool needsInput() const override {
+    return !noMoreInput_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return finished_;
+  }
+
+  void close() override;
+
+ private:
+  struct Level {
+    // Indices of the grouping keys of the level into the grouping keys of the
+    // plan node, in ascending order.
+    std::vector<column_index_t> keys;
+
+    // Index of the level this level is aggregated from. -1 for the finest
+    // level, which aggregates the input.
+    int32_t parent{-1};
+
+    // Indices of the levels aggregated from this level.
+    std::vector<int32_t> children;
+
+    // Indices of the grouping sets with the keys of this level. Empty for the
+    // finest level if it is not a grouping set.
+    std::vector<int64_t> groupIds;
+
+    // The keys followed by the final results of the aggregates.
+    RowTypePtr resultType;
+
+    // The keys followed by the intermediate results of the aggregates.
+    RowTypePtr intermediateType;
+
+    std::unique_ptr<GroupingSet> groupingSet;
+  };
+
+  // Fills 'levels_' from the grouping sets of 'aggregationNode_'.
+  void makeLevels();
+
+  // Creates the GroupingSet of 'levels_[index]'.
+  void createGroupingSet(
+      int32_t index,
+      const std::vector<column_index_t>& keyChannels);
+
+  // Makes an output batch for grouping set 'groupId' from 'result' of
+  // 'level'.
+  RowVectorPtr makeOutput(
+      const Level& level,
+      const RowVectorPtr& result,
+      int64_t groupId);
+
+  std::shared_ptr<const core::AggregationNode> aggregationNode_;
+
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator_;
+
+  // Number of grouping keys. The group id follows the keys in the output.
+  column_index_t numKeys_{0};
+
+  // The finest level over all grouping keys comes first. The other levels
+  // follow in descending number of keys.
+  std::vector<Level> levels_;
+
+  // Index into 'levels_' of the level being produced.
+  int32_t outputLevel_{0};
+
+  RowContainerIterator outputIterator_;
+
+  // Output batches of the level being produced. A level that is more than one
+  // grouping set produces the same groups for each.
+  std::vector<RowVectorPtr> pendingOutput_;
+
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -160,6 +160,19 @@ class MergeExchangeSource : public MergeSource {
         return BlockingReason::kWaitForProducer;
       }
     }
+    if (currentPage_->kind() == SerializedPage::Kind::kVector) {
+      // A page from a producer in the same process. The copy is in the
+      // memory of the consumer, so that the page is released here.
+      data = std::static_pointer_cast<RowVector>(BaseVector::copy(
+          *currentPage_->vector(), mergeExchange_->pool()));
+      auto lockedStats = mergeExchange_->stats().wlock();
+      lockedStats->rawInputBytes += currentPage_->size();
+      lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+      lockedStats->rawInputPositions += data->size();
+      currentPage_ = nullptr;
+      return BlockingReason::kNotBlocked;
+    }
+
     if (inputStream_ == nullptr) {
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_ = currentPage_->prepareStreamForDeserialize();
@@ -483,6 +483,28 @@ void Operator::recordSpillStats() {
                 lockedSpillStats->spillDeserializationTimeNanos),
             RuntimeCounter::Unit::kNanos});
   }
+
+  if (lockedSpillStats->spillReadAheadHits != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadHits,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadHits)});
+  }
+
+  if (lockedSpillStats->spillReadAheadMisses != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadMisses,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadMisses)});
+  }
+
+  if (lockedSpillStats->spillReadAheadWaitNanos != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadWaitNanos),
+            RuntimeCounter::Unit::kNanos});
+  }
   lockedSpillStats->reset();
 }
 
@@ -359,6 +359,11 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillReadTime{"spillReadWallNanos"};
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
+  static inline const std::string kSpillReadAheadHits{"spillReadAheadHits"};
+  static inline const std::string kSpillReadAheadMisses{
+      "spillReadAheadMisses"};
+  static inline const std::string kSpillReadAheadWaitTime{
+      "spillReadAheadWaitWallNanos"};
 
   /// The vector serde kind used by an operator for shuffle. The recorded
   /// runtime stats value is the corresponding enum value.
@@ -59,6 +59,12 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
+  // Sorts in parallel on the driver executor if configured and the task has
+  // one.
+  const auto sortParallelism =
+      driverCtx->queryConfig().orderBySortParallelism();
+  folly::Executor* sortExecutor =
+      sortParallelism > 1 ? operatorCtx_->task()->driverExecutor() : nullptr;
   sortBuffer_ = std::make_unique<SortBuffer>(
       outputType_,
       sortColumnIndices,
@@ -67,7 +73,9 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       driverCtx->prefixSortConfig(),
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      sortExecutor,
+      std::max<uint32_t>(sortParallelism, 1));
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -42,17 +42,90 @@ Destination::Destination(
     VectorSerde::Options* serdeOptions,
     memory::MemoryPool* pool,
     bool eagerFlush,
-    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+    bool vectorPages)
     : taskId_(taskId),
       destination_(destination),
       serde_(serde),
       serdeOptions_(serdeOptions),
       pool_(pool),
       eagerFlush_(eagerFlush),
-      recordEnqueued_(std::move(recordEnqueued)) {
+      recordEnqueued_(std::move(recordEnqueued)),
+      vectorPages_(vectorPages) {
   setTargetSizePct();
 }
 
+folly::Range<const vector_size_t*> Destination::nextRows(
+    uint64_t maxBytes,
+    const std::vector<vector_size_t>& sizes,
+    bool& shouldFlush) {
+  const auto rows = batchRows();
+  const auto firstRow = rowIdx_;
+  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+  if (bytesInCurrent_ >= adjustedMaxBytes) {
+    shouldFlush = true;
+    return {};
+  }
+
+  shouldFlush = false;
+  while (rowIdx_ < rows.size() && !shouldFlush) {
+    bytesInCurrent_ += sizes[rows[rowIdx_]];
+    ++rowIdx_;
+    ++rowsInCurrent_;
+    shouldFlush =
+        bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
+  }
+  return folly::Range(rows.data() + firstRow, rowIdx_ - firstRow);
+}
+
+VectorStreamGroup* Destination::streamGroup(const RowTypePtr& rowType) {
+  if (current_ == nullptr) {
+    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
+  }
+  return current_.get();
+}
+
+void Destination::appendToVector(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows) {
+  // Copies runs of consecutive rows together.
+  copyRanges_.clear();
+  for (vector_size_t i = 0; i < rows.size(); ++i) {
+    if (!copyRanges_.empty() &&
+        copyRanges_.back().sourceIndex + copyRanges_.back().count == rows[i]) {
+      ++copyRanges_.back().count;
+    } else {
+      copyRanges_.push_back({rows[i], i, 1});
+    }
+  }
+
+  if (currentVector_ == nullptr && copyRanges_.size() == 1) {
+    // A single run of rows, e.g. all rows of a broadcast, goes to the consumer
+    // as a slice of 'output' without a copy.
+    currentVector_ = std::static_pointer_cast<RowVector>(
+        output->slice(copyRanges_[0].sourceIndex, rows.size()));
+    currentIsSlice_ = true;
+    return;
+  }
+
+  if (currentVector_ == nullptr) {
+    currentVector_ = BaseVector::create<RowVector>(output->type(), 0, pool_);
+  } else if (currentIsSlice_) {
+    // The slice shares the buffers of an earlier input. Appending to it needs
+    // buffers of its own.
+    currentVector_ = std::static_pointer_cast<RowVector>(
+        BaseVector::copy(*currentVector_, pool_));
+    currentIsSlice_ = false;
+  }
+  const auto offset = currentVector_->size();
+  currentVector_->resize(offset + rows.size());
+  for (auto& range : copyRanges_) {
+    range.targetIndex += offset;
+  }
+  currentVector_->copyRanges(output.get(), copyRanges_);
+}
+
 BlockingReason Destination::advance(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
@@ -65,48 +138,37 @@ BlockingReason Destination::advance(
     ContinueFuture* future,
     Scratch& scratch) {
   VELOX_CHECK_LE(!!outputCompactRow + !!outputUnsafeRow, 1);
-  if (rowIdx_ >= rows_.size()) {
+  if (this->atEnd()) {
     *atEnd = true;
     return BlockingReason::kNotBlocked;
   }
 
-  const auto firstRow = rowIdx_;
-  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
-  if (bytesInCurrent_ >= adjustedMaxBytes) {
-    return flush(bufferManager, bufferReleaseFn, future);
-  }
-
   // Collect rows to serialize.
   bool shouldFlush = false;
-  while (rowIdx_ < rows_.size() && !shouldFlush) {
-    bytesInCurrent_ += sizes[rows_[rowIdx_]];
-    ++rowIdx_;
-    ++rowsInCurrent_;
-    shouldFlush =
-        bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
+  const auto rows = nextRows(maxBytes, sizes, shouldFlush);
+  if (rows.empty()) {
+    return flush(bufferManager, bufferReleaseFn, future);
   }
 
   // Serialize
-  if (current_ == nullptr) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
-    const auto rowType = asRowType(output->type());
-    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
-  }
-
-  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
-  if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
-    VELOX_CHECK_NOT_NULL(outputCompactRow);
-    current_->append(*outputCompactRow, rows, sizes);
-  } else if (serde_->kind() == VectorSerde::Kind::kUnsafeRow) {
-    VELOX_CHECK_NOT_NULL(outputUnsafeRow);
-    current_->append(*outputUnsafeRow, rows, sizes);
+  if (vectorPages_) {
+    appendToVector(output, rows);
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
-    current_->append(output, rows, scratch);
+    auto* current = streamGroup(asRowType(output->type()));
+    if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
+      VELOX_CHECK_NOT_NULL(outputCompactRow);
+      current->append(*outputCompactRow, rows, sizes);
+    } else if (serde_->kind() == VectorSerde::Kind::kUnsafeRow) {
+      VELOX_CHECK_NOT_NULL(outputUnsafeRow);
+      current->append(*outputUnsafeRow, rows, sizes);
+    } else {
+      VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+      current->append(output, rows, scratch);
+    }
   }
 
   // Update output state variable.
-  if (rowIdx_ == rows_.size()) {
+  if (this->atEnd()) {
     *atEnd = true;
   }
   if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
@@ -119,34 +181,45 @@ BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
-  if (!current_ || rowsInCurrent_ == 0) {
+  if ((!current_ && !currentVector_) || rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
 
-  // Upper limit of message size with no columns.
-  constexpr int32_t kMinMessageSize = 128;
-  auto listener = bufferManager.newListener();
-  IOBufOutputStream stream(
-      *current_->pool(),
-      listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
   const int64_t flushedRows = rowsInCurrent_;
-
-  current_->flush(&stream);
-  current_->clear();
-
-  const int64_t flushedBytes = stream.tellp();
+  int64_t flushedBytes;
+  std::unique_ptr<SerializedPage> page;
+  if (vectorPages_) {
+    // The page holds 'bufferReleaseFn' and thus the task, which owns the
+    // memory of the vector, until the consumer drops the page. The size is
+    // that of the rows, since a slice shares the buffers of the input with
+    // the pages of other destinations.
+    page = std::make_unique<SerializedPage>(
+        std::move(currentVector_), bufferReleaseFn, bytesInCurrent_);
+    currentIsSlice_ = false;
+    flushedBytes = page->size();
+  } else {
+    // Upper limit of message size with no columns.
+    constexpr int32_t kMinMessageSize = 128;
+    auto listener = bufferManager.newListener();
+    IOBufOutputStream stream(
+        *current_->pool(),
+        listener.get(),
+        std::max<int64_t>(kMinMessageSize, current_->size()));
+
+    current_->flush(&stream);
+    current_->clear();
+
+    flushedBytes = stream.tellp();
+    page = std::make_unique<SerializedPage>(
+        stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows);
+  }
 
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
   setTargetSizePct();
 
-  bool blocked = bufferManager.enqueue(
-      taskId_,
-      destination_,
-      std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
-      future);
+  bool blocked =
+      bufferManager.enqueue(taskId_, destination_, std::move(page), future);
 
   recordEnqueued_(flushedBytes, flushedRows);
 
@@ -203,7 +276,16 @@ PartitionedOutput::PartitionedOutput(
       serde_(getNamedVectorSerde(planNode->serdeKind())),
       serdeOptions_(getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
-          planNode->serdeKind())) {
+          planNode->serdeKind())),
+      vectorPages_(ctx->queryConfig().inProcessExchangeEnabled()),
+      scatter_([&]() {
+        if (vectorPages_) {
+          return false;
+        }
+        const auto minDestinations =
+            ctx->queryConfig().partitionedOutputScatterMinDestinations();
+        return minDestinations > 0 && numDestinations_ >= minDestinations;
+      }()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -244,6 +326,9 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
     output_->childAt(i)->loadedVector();
   }
 
+  if (vectorPages_) {
+    return;
+  }
   if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     outputCompactRow_ = std::make_unique<row::CompactRow>(output_);
   } else if (serde_->kind() == VectorSerde::Kind::kUnsafeRow) {
@@ -265,7 +350,8 @@ void PartitionedOutput::initializeDestinations() {
           [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          vectorPages_));
     }
   }
 }
@@ -288,7 +374,12 @@ void PartitionedOutput::estimateRowSizes() {
   raw_vector<vector_size_t> storage;
   const auto numbers = iota(numInput, storage);
   const auto rows = folly::Range(numbers, numInput);
-  if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
+  if (vectorPages_) {
+    // Only sizes the pages, so the average flat size is good enough.
+    const auto rowSize = std::max<vector_size_t>(
+        1, output_->estimateFlatSize() / std::max<vector_size_t>(1, numInput));
+    std::fill(rowSize_.begin(), rowSize_.begin() + numInput, rowSize);
+  } else if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
     VELOX_CHECK_NOT_NULL(outputCompactRow_);
     serde_->estimateSerializedSize(
         outputCompactRow_.get(), rows, sizePointers_.data());
@@ -318,7 +409,9 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
     auto singlePartition = partitionFunction_->partition(*input_, partitions_);
-    if (replicateNullsAndAny_) {
+    if (scatter_) {
+      sortRowsByDestination(singlePartition);
+    } else if (replicateNullsAndAny_) {
       collectNullRows();
 
       vector_size_t start = 0;
@@ -356,6 +449,129 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
   }
 }
 
+void PartitionedOutput::sortRowsByDestination(
+    std::optional<uint32_t> singlePartition) {
+  // Marks the rows that go to all destinations.
+  constexpr uint32_t kReplicated = std::numeric_limits<uint32_t>::max();
+  const auto numInput = input_->size();
+  if (singlePartition.has_value()) {
+    partitions_.resize(numInput);
+    std::fill(
+        partitions_.begin(),
+        partitions_.begin() + numInput,
+        singlePartition.value());
+  }
+  if (replicateNullsAndAny_) {
+    collectNullRows();
+    nullRows_.applyToSelected(
+        [&](vector_size_t row) { partitions_[row] = kReplicated; });
+    if (!replicatedAny_) {
+      partitions_[0] = kReplicated;
+      replicatedAny_ = true;
+    }
+  }
+
+  // Counts the rows of each destination, then turns the counts into the start
+  // offsets of the destinations shifted by one.
+  destinationOffsets_.assign(numDestinations_ + 1, 0);
+  vector_size_t numReplicated = 0;
+  for (vector_size_t row = 0; row < numInput; ++row) {
+    if (partitions_[row] == kReplicated) {
+      ++numReplicated;
+    } else {
+      ++destinationOffsets_[partitions_[row] + 1];
+    }
+  }
+  for (auto i = 1; i <= numDestinations_; ++i) {
+    destinationOffsets_[i] += destinationOffsets_[i - 1] + numReplicated;
+  }
+  sortedRows_.resize(destinationOffsets_.back());
+
+  // Places the rows, keeping their order within each destination. This
+  // advances each start offset to the end of its destination. The offsets
+  // are shifted back afterwards.
+  for (vector_size_t row = 0; row < numInput; ++row) {
+    const auto partition = partitions_[row];
+    if (partition == kReplicated) {
+      for (auto i = 0; i < numDestinations_; ++i) {
+        sortedRows_[destinationOffsets_[i]++] = row;
+      }
+    } else {
+      sortedRows_[destinationOffsets_[partition]++] = row;
+    }
+  }
+  for (auto i = numDestinations_; i > 0; --i) {
+    destinationOffsets_[i] = destinationOffsets_[i - 1];
+  }
+  destinationOffsets_[0] = 0;
+
+  for (auto i = 0; i < numDestinations_; ++i) {
+    destinations_[i]->setRows(folly::Range(
+        sortedRows_.data() + destinationOffsets_[i],
+        destinationOffsets_[i + 1] - destinationOffsets_[i]));
+  }
+}
+
+detail::Destination* PartitionedOutput::advanceScattered(
+    OutputBufferManager& bufferManager,
+    uint64_t maxPageSize) {
+  for (;;) {
+    // Flushes the full destinations of the last round. Stops on the first
+    // blocked one, like the non-scatter path. Flushing more could allocate
+    // memory while the outgoing queue is full.
+    while (nextScatterFlush_ < scatterFlushes_.size()) {
+      auto* destination = scatterFlushes_[nextScatterFlush_++];
+      blockingReason_ =
+          destination->flush(bufferManager, bufferReleaseFn_, &future_);
+      if (blockingReason_ != BlockingReason::kNotBlocked) {
+        return destination;
+      }
+    }
+
+    scatterGroups_.clear();
+    scatterRows_.clear();
+    scatterFlushes_.clear();
+    nextScatterFlush_ = 0;
+    for (auto& destination : destinations_) {
+      if (destination->atEnd()) {
+        continue;
+      }
+      bool shouldFlush = false;
+      const auto rows =
+          destination->nextRows(maxPageSize, rowSize_, shouldFlush);
+      if (!rows.empty()) {
+        scatterGroups_.push_back(
+            destination->streamGroup(asRowType(output_->type())));
+        scatterRows_.push_back(rows);
+      }
+      if (shouldFlush || (eagerFlush_ && !rows.empty())) {
+        scatterFlushes_.push_back(destination.get());
+      }
+    }
+    if (scatterGroups_.empty() && scatterFlushes_.empty()) {
+      return nullptr;
+    }
+
+    if (serde_->kind() == VectorSerde::Kind::kPresto) {
+      VectorStreamGroup::appendScattered(
+          output_, scatterGroups_, scatterRows_, scratch_);
+    } else {
+      // Row formats serialize each row once anyway. The rows of all
+      // destinations are consecutive in 'sortedRows_'.
+      for (auto i = 0; i < scatterGroups_.size(); ++i) {
+        if (serde_->kind() == VectorSerde::Kind::kCompactRow) {
+          scatterGroups_[i]->append(
+              *outputCompactRow_, scatterRows_[i], rowSize_);
+        } else {
+          VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kUnsafeRow);
+          scatterGroups_[i]->append(
+              *outputUnsafeRow_, scatterRows_[i], rowSize_);
+        }
+      }
+    }
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -403,35 +619,39 @@ RowVectorPtr PartitionedOutput::getOutput() {
       kMinDestinationSize,
       std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
 
-  bool workLeft;
-  do {
-    workLeft = false;
-    for (auto& destination : destinations_) {
-      bool atEnd = false;
-      blockingReason_ = destination->advance(
-          maxPageSize,
-          rowSize_,
-          output_,
-          outputCompactRow_.get(),
-          outputUnsafeRow_.get(),
-          *bufferManager,
-          bufferReleaseFn_,
-          &atEnd,
-          &future_,
-          scratch_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        blockedDestination = destination.get();
-        workLeft = false;
-        // We stop on first blocked. Adding data to unflushed targets
-        // would be possible but could allocate memory. We wait for
-        // free space in the outgoing queue.
-        break;
-      }
-      if (!atEnd) {
-        workLeft = true;
+  if (scatter_) {
+    blockedDestination = advanceScattered(*bufferManager, maxPageSize);
+  } else {
+    bool workLeft;
+    do {
+      workLeft = false;
+      for (auto& destination : destinations_) {
+        bool atEnd = false;
+        blockingReason_ = destination->advance(
+            maxPageSize,
+            rowSize_,
+            output_,
+            outputCompactRow_.get(),
+            outputUnsafeRow_.get(),
+            *bufferManager,
+            bufferReleaseFn_,
+            &atEnd,
+            &future_,
+            scratch_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          blockedDestination = destination.get();
+          workLeft = false;
+          // We stop on first blocked. Adding data to unflushed targets
+          // would be possible but could allocate memory. We wait for
+          // free space in the outgoing queue.
+          break;
+        }
+        if (!atEnd) {
+          workLeft = true;
+        }
       }
-    }
-  } while (workLeft);
+    } while (workLeft);
+  }
 
   if (blockedDestination) {
     // If we are going off-thread, we may as well make the output in
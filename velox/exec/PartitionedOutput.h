@@ -29,6 +29,9 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param vectorPages If true, the rows are copied into vectors that are
+  /// enqueued as is instead of being serialized. See
+  /// QueryConfig::kInProcessExchangeEnabled.
   Destination(
       const std::string& taskId,
       int destination,
@@ -36,11 +39,13 @@ class Destination {
       VectorSerde::Options* options,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued);
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool vectorPages = false);
 
   /// Resets the destination before starting a new batch.
   void beginBatch() {
     rows_.clear();
+    sortedRows_ = {};
     rowIdx_ = 0;
   }
 
@@ -54,6 +59,32 @@ class Destination {
     }
   }
 
+  /// Sets the rows of the batch to a slice of the rows of all destinations
+  /// sorted by destination. 'rows' must stay valid until the next
+  /// beginBatch().
+  void setRows(folly::Range<const vector_size_t*> rows) {
+    VELOX_CHECK(rows_.empty());
+    sortedRows_ = rows;
+  }
+
+  /// Returns true if all rows of the batch have been serialized.
+  bool atEnd() const {
+    return rowIdx_ >= batchRows().size();
+  }
+
+  /// Takes the next rows of the batch to serialize, up to the byte or row
+  /// count at which 'this' should be flushed. Sets 'shouldFlush' if this count
+  /// is reached. Returns no rows if 'this' should be flushed before taking
+  /// more. The caller serializes the rows into streamGroup().
+  folly::Range<const vector_size_t*> nextRows(
+      uint64_t maxBytes,
+      const std::vector<vector_size_t>& sizes,
+      bool& shouldFlush);
+
+  /// Returns the stream group to serialize the rows of 'this' into. Creates
+  /// it for 'rowType' if needed.
+  VectorStreamGroup* streamGroup(const RowTypePtr& rowType);
+
   /// Serializes row from 'output' till either 'maxBytes' have been serialized
   /// or
   BlockingReason advance(
@@ -102,6 +133,19 @@ class Destination {
     targetNumRows_ = (10'000 * targetSizePct_) / 100;
   }
 
+  folly::Range<const vector_size_t*> batchRows() const {
+    return rows_.empty() ? sortedRows_
+                         : folly::Range<const vector_size_t*>(
+                               rows_.data(), rows_.size());
+  }
+
+  // Adds 'rows' of 'output' to the end of 'currentVector_'. Takes a slice of
+  // 'output' instead of a copy if 'rows' are consecutive and 'currentVector_'
+  // is empty.
+  void appendToVector(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows);
+
   const std::string taskId_;
   const int destination_;
   VectorSerde* const serde_;
@@ -109,6 +153,7 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const bool vectorPages_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -116,12 +161,24 @@ class Destination {
   vector_size_t rowsInCurrent_{0};
   raw_vector<vector_size_t> rows_;
 
-  // First index of 'rows_' that is not appended to 'current_'.
+  // The rows of the batch if set with setRows(). Points into the rows of all
+  // destinations sorted by destination.
+  folly::Range<const vector_size_t*> sortedRows_;
+
+  // First index of batchRows() that is not appended to 'current_'.
   vector_size_t rowIdx_{0};
 
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+
+  // The rows to flush if 'vectorPages_' is true. A new vector is made after
+  // each flush, since the consumer takes the flushed one.
+  RowVectorPtr currentVector_;
+  // True if 'currentVector_' is a slice of an input vector.
+  bool currentIsSlice_{false};
+  std::vector<BaseVector::CopyRange> copyRanges_;
+
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -205,6 +262,21 @@ class PartitionedOutput : public Operator {
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Counting sorts the rows of 'input_' by destination into 'sortedRows_' and
+  // sets the rows of each destination to its slice. Replicated rows go to all
+  // destinations.
+  void sortRowsByDestination(std::optional<uint32_t> singlePartition);
+
+  // Serializes the rows of all destinations in rounds. Each round takes the
+  // next rows of each destination up to its flush size, serializes these in
+  // one pass over the columns and flushes the full destinations. Stops at the
+  // first destination that blocks on flush and returns it. The next call
+  // first does the remaining flushes of the round. Returns nullptr if all
+  // rows were serialized and flushed.
+  detail::Destination* advanceScattered(
+      OutputBufferManager& bufferManager,
+      uint64_t maxPageSize);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -221,6 +293,12 @@ class PartitionedOutput : public Operator {
   const bool eagerFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+  // True if the destinations enqueue vectors instead of serialized data. See
+  // QueryConfig::kInProcessExchangeEnabled.
+  const bool vectorPages_;
+  // True if serializing in scatter mode. See
+  // QueryConfig::kPartitionedOutputScatterMinDestinations.
+  const bool scatter_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -250,6 +328,19 @@ class PartitionedOutput : public Operator {
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
+
+  // Scatter mode state. The rows of 'input_' sorted by destination and the
+  // start of the rows of each destination followed by the end.
+  raw_vector<vector_size_t> sortedRows_;
+  std::vector<vector_size_t> destinationOffsets_;
+  // The stream groups, rows and destinations to flush of a round of
+  // advanceScattered().
+  std::vector<VectorStreamGroup*> scatterGroups_;
+  std::vector<folly::Range<const vector_size_t*>> scatterRows_;
+  std::vector<detail::Destination*> scatterFlushes_;
+  // Index of the next destination in 'scatterFlushes_' to flush. Less than
+  // its size if the round stopped at a blocked destination.
+  size_t nextScatterFlush_{0};
 };
 
 } // namespace facebook::velox::exec
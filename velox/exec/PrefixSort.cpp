@@ -330,7 +330,7 @@ uint32_t PrefixSort::maxRequiredBytes(
 
 // static
 void PrefixSort::stdSort(
-    std::vector<char*, memory::StlAllocator<char*>>& rows,
+    folly::Range<char**> rows,
     const RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
   std::sort(
@@ -356,8 +356,7 @@ uint32_t PrefixSort::maxRequiredBytes() const {
       2 * pool_->alignment();
 }
 
-void PrefixSort::sortInternal(
-    std::vector<char*, memory::StlAllocator<char*>>& rows) {
+void PrefixSort::sortInternal(folly::Range<char**> rows, bool radixSort) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixBufferAlloc;
@@ -387,17 +386,26 @@ void PrefixSort::sortInternal(
           RuntimeCounter(
               sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
     }
+    const auto sort = [&](auto compare) {
+      if (radixSort) {
+        sortRunner.radixSort(
+            prefixBufferStart,
+            prefixBufferEnd,
+            sortLayout_.normalizedBufferSize,
+            compare);
+      } else {
+        sortRunner.quickSort(prefixBufferStart, prefixBufferEnd, compare);
+      }
+    };
     if (sortLayout_.hasNonNormalizedKey ||
         sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
-            return comparePartNormalizedKeys(lhs, rhs);
-          });
+      sort([&](char* lhs, char* rhs) {
+        return comparePartNormalizedKeys(lhs, rhs);
+      });
     } else {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
-            return compareAllNormalizedKeys(lhs, rhs);
-          });
+      sort([&](char* lhs, char* rhs) {
+        return compareAllNormalizedKeys(lhs, rhs);
+      });
     }
   }
 
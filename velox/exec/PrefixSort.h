@@ -133,21 +133,29 @@ class PrefixSort {
       const velox::common::PrefixSortConfig& config,
       memory::MemoryPool* pool,
       std::vector<char*, memory::StlAllocator<char*>>& rows) {
+    const folly::Range<char**> range(rows.data(), rows.size());
     if (rowContainer->numRows() < config.minNumRows) {
-      stdSort(rows, rowContainer, compareFlags);
+      stdSort(range, rowContainer, compareFlags);
       return;
     }
-    const auto sortLayout =
-        generateSortLayout(rowContainer, compareFlags, config);
-    // All keys can not normalize, skip the binary string compare opt.
-    // Putting this outside sort-internal helps with stdSort.
-    if (!sortLayout.hasNormalizedKeys) {
+    sortRows(rowContainer, compareFlags, config, pool, range);
+  }
+
+  /// Same as above but sorts a subset of the rows of 'rowContainer' in place,
+  /// e.g. one of several disjoint ranges of the listed rows that are sorted
+  /// concurrently. Uses prefix sort if 'rows' has at least
+  /// 'config.minNumRows' rows.
+  FOLLY_ALWAYS_INLINE static void sort(
+      const RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const velox::common::PrefixSortConfig& config,
+      memory::MemoryPool* pool,
+      folly::Range<char**> rows) {
+    if (rows.size() < config.minNumRows) {
       stdSort(rows, rowContainer, compareFlags);
       return;
     }
-
-    PrefixSort prefixSort(rowContainer, sortLayout, pool);
-    prefixSort.sortInternal(rows);
+    sortRows(rowContainer, compareFlags, config, pool, rows);
   }
 
   /// The std::sort won't require bytes while prefix sort may require buffers
@@ -164,11 +172,32 @@ class PrefixSort {
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
 
  private:
+  // Sorts 'rows' with prefix sort if any of the sort keys can be normalized,
+  // otherwise with stdSort.
+  FOLLY_ALWAYS_INLINE static void sortRows(
+      const RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const velox::common::PrefixSortConfig& config,
+      memory::MemoryPool* pool,
+      folly::Range<char**> rows) {
+    const auto sortLayout =
+        generateSortLayout(rowContainer, compareFlags, config);
+    // All keys can not normalize, skip the binary string compare opt.
+    // Putting this outside sort-internal helps with stdSort.
+    if (!sortLayout.hasNormalizedKeys) {
+      stdSort(rows, rowContainer, compareFlags);
+      return;
+    }
+
+    PrefixSort prefixSort(rowContainer, sortLayout, pool);
+    prefixSort.sortInternal(rows, config.radixSortEnabled);
+  }
+
   /// Fallback to stdSort when prefix sort conditions such as config and memory
   /// are not satisfied. stdSort provides >2X performance win than std::sort for
   /// user experienced data.
   static void stdSort(
-      std::vector<char*, memory::StlAllocator<char*>>& rows,
+      folly::Range<char**> rows,
       const RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags);
 
@@ -207,7 +236,9 @@ class PrefixSort {
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
-  void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
+  // Sorts 'rows' with radix sort if 'radixSort' is true, otherwise with
+  // quick-sort.
+  void sortInternal(folly::Range<char**> rows, bool radixSort);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -119,13 +119,21 @@ void RowNumber::restoreNextSpillPartition() {
 
   auto it = spillInputPartitionSet_.begin();
   spillInputReader_ = it->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->executor,
+      spillConfig_->numReadAheadBuffers);
 
   // Find matching partition for the hash table.
   auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
   if (hashTableIt != spillHashTablePartitionSet_.end()) {
     spillHashTableReader_ = hashTableIt->second->createUnorderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor,
+        spillConfig_->numReadAheadBuffers);
 
     setSpillPartitionBits(&(it->first));
 
@@ -15,10 +15,126 @@
  */
 
 #include "SortBuffer.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Collects the runtime stats of a task on an executor thread, which has no
+// runtime stat writer, so that they can be added to the operator's stats on
+// the driver thread.
+class RuntimeStatCollector : public BaseRuntimeStatWriter {
+ public:
+  void addRuntimeStat(const std::string& name, const RuntimeCounter& value)
+      override {
+    stats_.emplace_back(name, value);
+  }
+
+  // Adds the collected stats to the runtime stat writer of the calling
+  // thread.
+  void flush() {
+    for (const auto& [name, value] : stats_) {
+      addThreadLocalRuntimeStat(name, value);
+    }
+    stats_.clear();
+  }
+
+ private:
+  std::vector<std::pair<std::string, RuntimeCounter>> stats_;
+};
+
+// Runs 'tasks' on 'executor' and waits for all of them to finish. Tasks that
+// have not started by the time they are waited for run on the calling thread.
+// Rethrows the last error, if any.
+void runInParallel(
+    folly::Executor* executor,
+    std::vector<std::function<void()>> tasks) {
+  // Passing driver context directly to avoid cross thread access to thread
+  // local driver thread context.
+  const DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  steps.reserve(tasks.size());
+  std::exception_ptr error;
+  {
+    // All the steps must be waited for also in case of error because they
+    // reference the state of the caller.
+    auto sync = folly::makeGuard([&]() {
+      for (auto& step : steps) {
+        try {
+          step->move();
+        } catch (const std::exception&) {
+          error = std::current_exception();
+        }
+      }
+    });
+    for (auto& task : tasks) {
+      steps.push_back(
+          std::make_shared<AsyncSource<bool>>([task = std::move(task)]() {
+            task();
+            return std::make_unique<bool>(true);
+          }));
+      executor->add([driverCtx, step = steps.back()]() {
+        ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+        step->prepare();
+      });
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Returns the number of rows of 'left' in the first 'diagonal' rows of the
+// merge of 'left' and 'right', i.e. where the merge path crosses 'diagonal'.
+// Rows of 'left' go first on ties, like in std::merge.
+template <typename Less>
+uint64_t mergePathSplit(
+    folly::Range<char**> left,
+    folly::Range<char**> right,
+    uint64_t diagonal,
+    const Less& less) {
+  uint64_t low = diagonal > right.size() ? diagonal - right.size() : 0;
+  uint64_t high = std::min<uint64_t>(diagonal, left.size());
+  while (low < high) {
+    const auto mid = low + (high - low) / 2;
+    if (less(right[diagonal - mid - 1], left[mid])) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+// Writes the rows in [begin, end) of the merge of 'left' and 'right' to the
+// same positions of 'output'.
+template <typename Less>
+void mergePart(
+    folly::Range<char**> left,
+    folly::Range<char**> right,
+    uint64_t begin,
+    uint64_t end,
+    char** output,
+    const Less& less) {
+  const auto leftBegin = mergePathSplit(left, right, begin, less);
+  const auto leftEnd = mergePathSplit(left, right, end, less);
+  std::merge(
+      left.begin() + leftBegin,
+      left.begin() + leftEnd,
+      right.begin() + (begin - leftBegin),
+      right.begin() + (end - leftEnd),
+      output + begin,
+      less);
+}
+} // namespace
 
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
@@ -28,7 +144,9 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     common::PrefixSortConfig prefixSortConfig,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    folly::Executor* sortExecutor,
+    uint32_t sortParallelism)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
@@ -36,11 +154,14 @@ SortBuffer::SortBuffer(
       prefixSortConfig_(prefixSortConfig),
       spillConfig_(spillConfig),
       spillStats_(spillStats),
+      sortExecutor_(sortExecutor),
+      sortParallelism_(sortParallelism),
       sortedRows_(0, memory::StlAllocator<char*>(*pool)) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
+  VELOX_CHECK_GT(sortParallelism_, 0);
 
   std::vector<TypePtr> sortedColumnTypes;
   std::vector<TypePtr> nonSortedColumnTypes;
@@ -131,8 +252,7 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    PrefixSort::sort(
-        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    sortRows();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -310,8 +430,11 @@ void SortBuffer::ensureSortFits() {
   }
 
   // The memory for std::vector sorted rows and prefix sort required buffer.
+  // A parallel sort needs a second vector of rows to merge the sorted ranges
+  // into.
+  const auto numRowVectors = numSortRanges() > 1 ? 2 : 1;
   uint64_t sortBufferToReserve =
-      numInputRows_ * sizeof(char*) +
+      numRowVectors * numInputRows_ * sizeof(char*) +
       PrefixSort::maxRequiredBytes(
           data_.get(), sortCompareFlags_, prefixSortConfig_, pool_);
   {
@@ -329,6 +452,105 @@ void SortBuffer::ensureSortFits() {
       succinctBytes(pool_->reservedBytes()));
 }
 
+uint32_t SortBuffer::numSortRanges() const {
+  if (sortExecutor_ == nullptr) {
+    return 1;
+  }
+  return std::max<uint64_t>(
+      1,
+      std::min<uint64_t>(
+          sortParallelism_, numInputRows_ / kMinParallelSortRangeRows));
+}
+
+void SortBuffer::sortRows() {
+  const auto numRanges = numSortRanges();
+  if (numRanges == 1) {
+    PrefixSort::sort(
+        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    return;
+  }
+
+  std::vector<uint64_t> bounds(numRanges + 1);
+  for (auto i = 0; i <= numRanges; ++i) {
+    bounds[i] = sortedRows_.size() * i / numRanges;
+  }
+  // PrefixSort adds runtime stats. Each range collects its own, since the
+  // ranges are sorted on executor threads.
+  std::vector<RuntimeStatCollector> rangeStats(numRanges);
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(numRanges);
+  for (auto i = 0; i < numRanges; ++i) {
+    tasks.push_back([this,
+                     begin = bounds[i],
+                     end = bounds[i + 1],
+                     stats = &rangeStats[i]]() {
+      RuntimeStatWriterScopeGuard statWriterGuard(stats);
+      PrefixSort::sort(
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_,
+          pool_,
+          folly::Range<char**>(
+              sortedRows_.data() + begin, sortedRows_.data() + end));
+    });
+  }
+  runInParallel(sortExecutor_, std::move(tasks));
+  for (auto& stats : rangeStats) {
+    stats.flush();
+  }
+  mergeSortedRanges(std::move(bounds));
+}
+
+void SortBuffer::mergeSortedRanges(std::vector<uint64_t> bounds) {
+  const auto less = [this](const char* left, const char* right) {
+    return data_->compareRows(left, right, sortCompareFlags_) < 0;
+  };
+  std::vector<char*, memory::StlAllocator<char*>> mergedRows(
+      sortedRows_.size(), memory::StlAllocator<char*>(*pool_));
+  while (bounds.size() > 2) {
+    const auto numRanges = bounds.size() - 1;
+    // Each merge of a pair of ranges is split by merge path into parts of
+    // about equal size, so that every round keeps 'sortParallelism_' threads
+    // busy, also the last one that merges just two ranges.
+    const auto numParts =
+        std::max<uint64_t>(1, sortParallelism_ / (numRanges / 2));
+    std::vector<uint64_t> mergedBounds;
+    std::vector<std::function<void()>> tasks;
+    for (auto i = 0; i + 1 < numRanges; i += 2) {
+      mergedBounds.push_back(bounds[i]);
+      const folly::Range<char**> left(
+          sortedRows_.data() + bounds[i], sortedRows_.data() + bounds[i + 1]);
+      const folly::Range<char**> right(
+          sortedRows_.data() + bounds[i + 1],
+          sortedRows_.data() + bounds[i + 2]);
+      char** output = mergedRows.data() + bounds[i];
+      const auto numRows = bounds[i + 2] - bounds[i];
+      for (auto part = 0; part < numParts; ++part) {
+        tasks.push_back([left,
+                         right,
+                         output,
+                         begin = numRows * part / numParts,
+                         end = numRows * (part + 1) / numParts,
+                         &less]() {
+          mergePart(left, right, begin, end, output, less);
+        });
+      }
+    }
+    // An odd range out is merged in the next round.
+    if (numRanges % 2 == 1) {
+      mergedBounds.push_back(bounds[numRanges - 1]);
+      std::copy(
+          sortedRows_.begin() + bounds[numRanges - 1],
+          sortedRows_.end(),
+          mergedRows.begin() + bounds[numRanges - 1]);
+    }
+    mergedBounds.push_back(sortedRows_.size());
+    runInParallel(sortExecutor_, std::move(tasks));
+    sortedRows_.swap(mergedRows);
+    bounds = std::move(mergedBounds);
+  }
+}
+
 void SortBuffer::updateEstimatedOutputRowSize() {
   const auto optionalRowSize = data_->estimateRowSize();
   if (!optionalRowSize.has_value() || optionalRowSize.value() == 0) {
@@ -492,7 +714,11 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->executor,
+      spillConfig_->numReadAheadBuffers);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
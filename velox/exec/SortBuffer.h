@@ -30,6 +30,10 @@ class SortOutputSpiller;
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
 /// limit.
+///
+/// If 'sortExecutor' is set, the in-memory rows are split into up to
+/// 'sortParallelism' ranges that are sorted in parallel on 'sortExecutor' and
+/// then merged in parallel.
 class SortBuffer {
  public:
   SortBuffer(
@@ -40,7 +44,9 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       common::PrefixSortConfig prefixSortConfig,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      folly::Executor* sortExecutor = nullptr,
+      uint32_t sortParallelism = 1);
 
   ~SortBuffer();
 
@@ -69,6 +75,10 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// The minimum number of rows in each of the ranges that are sorted in
+  /// parallel.
+  static constexpr uint64_t kMinParallelSortRangeRows{10'000};
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -83,6 +93,17 @@ class SortBuffer {
 
   void updateEstimatedOutputRowSize();
 
+  // Returns the number of ranges the in-memory rows are split into to sort
+  // in parallel. Returns 1 if the rows are sorted on the calling thread.
+  uint32_t numSortRanges() const;
+
+  // Sorts 'sortedRows_', in parallel if numSortRanges() is more than 1.
+  void sortRows();
+
+  // Merges the sorted ranges of 'sortedRows_' delimited by 'bounds' into
+  // one, merging adjacent pairs of ranges in parallel until one is left.
+  void mergeSortedRanges(std::vector<uint64_t> bounds);
+
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(vector_size_t outputBatchSize);
 
@@ -127,6 +148,13 @@ class SortBuffer {
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  // The executor to sort and merge ranges of the in-memory rows on in
+  // parallel. The rows are sorted on the calling thread if null.
+  folly::Executor* const sortExecutor_;
+
+  // The maximum number of ranges of the in-memory rows to sort in parallel.
+  const uint32_t sortParallelism_;
+
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
   std::vector<IdentityProjection> columnMap_;
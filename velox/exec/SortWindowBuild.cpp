@@ -285,7 +285,11 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool_, spillStats_);
+        spillConfig_->readBufferSize,
+        pool_,
+        spillStats_,
+        spillConfig_->executor,
+        spillConfig_->numReadAheadBuffers);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -32,24 +32,26 @@ static const bool kDefaultUseLosslessTimestamp = true;
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig) {
+    const std::string& fileCreateConfig,
+    bool ioUringEnabled) {
   return std::unique_ptr<SpillWriteFile>(
-      new SpillWriteFile(id, pathPrefix, fileCreateConfig));
+      new SpillWriteFile(id, pathPrefix, fileCreateConfig, ioUringEnabled));
 }
 
 SpillWriteFile::SpillWriteFile(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool ioUringEnabled)
     : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  file_ = fs->openFileForWrite(
-      path_,
-      filesystems::FileOptions{
-          {{filesystems::FileOptions::kFileCreateConfig.toString(),
-            fileCreateConfig}},
-          nullptr,
-          std::nullopt});
+  filesystems::FileOptions options{
+      {{filesystems::FileOptions::kFileCreateConfig.toString(),
+        fileCreateConfig}},
+      nullptr,
+      std::nullopt};
+  options.useIoUring = ioUringEnabled;
+  file_ = fs->openFileForWrite(path_, options);
 }
 
 void SpillWriteFile::finish() {
@@ -83,7 +85,8 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    bool ioUringEnabled)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -92,6 +95,7 @@ SpillWriter::SpillWriter(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
+      ioUringEnabled_(ioUringEnabled),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
@@ -110,7 +114,8 @@ SpillWriteFile* SpillWriter::ensureFile() {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
         fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_);
+        fileCreateConfig_,
+        ioUringEnabled_);
   }
   return currentFile_.get();
 }
@@ -268,7 +273,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -279,7 +286,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortFlags,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadExecutor,
+      numReadAheadBuffers));
 }
 
 SpillReadFile::SpillReadFile(
@@ -292,7 +301,9 @@ SpillReadFile::SpillReadFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    uint32_t numReadAheadBuffers)
     : id_(id),
       path_(path),
       size_(size),
@@ -310,8 +321,16 @@ SpillReadFile::SpillReadFile(
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
+  // Without read-ahead buffers, the stream still reads one buffer ahead if the
+  // file supports async read.
+  const bool readAheadOnExecutor =
+      readAheadExecutor != nullptr && numReadAheadBuffers > 0;
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file),
+      bufferSize,
+      pool_,
+      readAheadOnExecutor ? readAheadExecutor : nullptr,
+      readAheadOnExecutor ? numReadAheadBuffers : 1);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -336,9 +355,16 @@ void SpillReadFile::recordSpillStats() {
   const auto readStats = input_->stats();
   common::updateGlobalSpillReadStats(
       readStats.numReads, readStats.readBytes, readStats.readTimeNs);
+  common::updateGlobalSpillReadAheadStats(
+      readStats.numReadAheadHits,
+      readStats.numReadAheadMisses,
+      readStats.readAheadWaitNs);
   auto lockedSpillStats = stats_->wlock();
   lockedSpillStats->spillReads += readStats.numReads;
   lockedSpillStats->spillReadTimeNanos += readStats.readTimeNs;
   lockedSpillStats->spillReadBytes += readStats.readBytes;
+  lockedSpillStats->spillReadAheadHits += readStats.numReadAheadHits;
+  lockedSpillStats->spillReadAheadMisses += readStats.numReadAheadMisses;
+  lockedSpillStats->spillReadAheadWaitNanos += readStats.readAheadWaitNs;
 }
 } // namespace facebook::velox::exec
@@ -37,10 +37,13 @@ namespace facebook::velox::exec {
 /// file.
 class SpillWriteFile {
  public:
+  /// If 'ioUringEnabled' is true, the file is written through io_uring if the
+  /// file system supports it.
   static std::unique_ptr<SpillWriteFile> create(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      bool ioUringEnabled = false);
 
   uint32_t id() const {
     return id_;
@@ -68,7 +71,8 @@ class SpillWriteFile {
   SpillWriteFile(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      bool ioUringEnabled);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -121,7 +125,8 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      bool ioUringEnabled = false);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -186,6 +191,7 @@ class SpillWriter {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
+  const bool ioUringEnabled_;
 
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
@@ -210,11 +216,18 @@ class SpillWriter {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// Creates a reader of the spill file described by 'fileInfo' which reads
+  /// 'bufferSize' bytes at a time. If 'readAheadExecutor' is set and
+  /// 'numReadAheadBuffers' is not zero, up to 'numReadAheadBuffers' buffers
+  /// are kept read ahead on 'readAheadExecutor'. All the buffers are allocated
+  /// from 'pool'.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint32_t numReadAheadBuffers = 0);
 
   uint32_t id() const {
     return id_;
@@ -250,7 +263,9 @@ class SpillReadFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor,
+      uint32_t numReadAheadBuffers);
 
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
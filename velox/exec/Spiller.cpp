@@ -57,7 +57,8 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->ioUringEnabled) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 
   spillRuns_.reserve(state_.maxPartitions());
@@ -426,7 +426,11 @@ void TableScan::addDynamicFilter(
   }
   auto& currentFilter = dynamicFilters_[outputChannel];
   if (currentFilter) {
-    currentFilter = currentFilter->mergeWith(filter.get());
+    // Other filters do not merge with a bloom filter, the bloom filter merges
+    // with any filter.
+    currentFilter = filter->kind() == common::FilterKind::kBloomFilter
+        ? filter->mergeWith(currentFilter.get())
+        : currentFilter->mergeWith(filter.get());
   } else {
     currentFilter = filter;
   }
@@ -297,6 +297,7 @@ Task::Task(
       mode_(mode),
       memoryArbitrationPriority_(memoryArbitrationPriority),
       queryCtx_(std::move(queryCtx)),
+      numaNode_(queryCtx_->nextNumaNode()),
       planFragment_(std::move(planFragment)),
       traceConfig_(maybeMakeTraceConfig()),
       consumerSupplier_(std::move(consumerSupplier)),
@@ -3003,7 +3004,8 @@ void Task::createExchangeClientLocked(
       numberOfConsumers,
       queryCtx()->queryConfig().minExchangeOutputBatchBytes(),
       addExchangeClientPool(planNodeId, pipelineId),
-      queryCtx()->executor());
+      queryCtx()->executor(),
+      queryCtx()->queryConfig().exchangeAdaptiveFlowControl());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
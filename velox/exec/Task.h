@@ -145,6 +145,18 @@ class Task : public std::enable_shared_from_this<Task> {
     return queryCtx_;
   }
 
+  /// Returns the NUMA node the drivers of this task prefer for running and
+  /// allocating memory. -1 if the query does not place drivers by NUMA node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
+  /// Returns the executor that runs the drivers of this task.
+  folly::Executor* driverExecutor() const {
+    return numaNode_ < 0 ? queryCtx_->executor()
+                         : queryCtx_->numaExecutor(numaNode_);
+  }
+
   /// Returns MemoryPool used to allocate memory during execution. This instance
   /// is a child of the MemoryPool passed in the constructor.
   memory::MemoryPool* pool() const {
@@ -1053,6 +1065,9 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::shared_ptr<core::QueryCtx> queryCtx_;
 
+  // NUMA node of the drivers, -1 if none. See numaNode().
+  const int32_t numaNode_;
+
   core::PlanFragment planFragment_;
 
   const std::optional<trace::TraceConfig> traceConfig_;
@@ -55,6 +55,16 @@ TopN::TopN(
       }
     }
   }
+
+  const auto& leadingKeyType = outputType_->childAt(sortingKeyColumns_[0]);
+  if (driverCtx->queryConfig().topNDynamicFilterEnabled() &&
+      TopNThreshold::supportsType(leadingKeyType)) {
+    threshold_ = std::make_unique<TopNThreshold>(
+        leadingKeyType,
+        topNNode->sortingOrders()[0],
+        sortingKeyColumns_[0],
+        pool());
+  }
 }
 
 void TopN::addInput(RowVectorPtr input) {
@@ -104,6 +114,27 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  updateDynamicFilter();
+}
+
+void TopN::updateDynamicFilter() {
+  if (threshold_ == nullptr || topRows_.size() < count_) {
+    return;
+  }
+  const auto channel = sortingKeyColumns_[0];
+  if (!thresholdPushdownChecked_) {
+    thresholdPushdownChecked_ = true;
+    if (operatorCtx_->driverCtx()
+            ->driver->canPushdownFilters(this, {channel})
+            .empty()) {
+      threshold_.reset();
+      return;
+    }
+  }
+  if (auto filter = threshold_->update(*data_, topRows_.top())) {
+    dynamicFilters_[channel] = std::move(filter);
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
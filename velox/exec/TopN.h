@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/TopNThreshold.h"
 
 namespace facebook::velox::exec {
 
@@ -44,6 +45,10 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Adds the cutoff of the full 'topRows_' to 'dynamicFilters_' if it changed
+  // and an upstream table scan accepts filters on the leading sorting key.
+  void updateDynamicFilter();
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -68,5 +73,14 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Makes dynamic filters from the cutoff on the leading sorting key. Not set
+  // if the pushdown is disabled, the key type is not supported or no upstream
+  // operator accepts the filters.
+  std::unique_ptr<TopNThreshold> threshold_;
+
+  // True once the upstream operators were checked for accepting a filter on
+  // the leading sorting key.
+  bool thresholdPushdownChecked_{false};
 };
 } // namespace facebook::velox::exec
@@ -168,6 +168,11 @@ TopNRowNumber::TopNRowNumber(
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
     singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    if (driverCtx->queryConfig().topNDynamicFilterEnabled() &&
+        TopNThreshold::supportsType(inputType_->childAt(0))) {
+      threshold_ = std::make_unique<TopNThreshold>(
+          inputType_->childAt(0), node->sortingOrders()[0], 0, pool());
+    }
   }
 
   if (generateRowNumber_) {
@@ -226,6 +231,26 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
     for (auto i = 0; i < numInput; ++i) {
       processInputRow(i, *singlePartition_);
     }
+    updateDynamicFilter();
+  }
+}
+
+void TopNRowNumber::updateDynamicFilter() {
+  if (threshold_ == nullptr || singlePartition_->rows.size() < limit_) {
+    return;
+  }
+  const auto channel = inputChannels_[0];
+  if (!thresholdPushdownChecked_) {
+    thresholdPushdownChecked_ = true;
+    if (operatorCtx_->driverCtx()
+            ->driver->canPushdownFilters(this, {channel})
+            .empty()) {
+      threshold_.reset();
+      return;
+    }
+  }
+  if (auto filter = threshold_->update(*data_, singlePartition_->rows.top())) {
+    dynamicFilters_[channel] = std::move(filter);
   }
 }
 
@@ -294,7 +319,11 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor,
+        spillConfig_->numReadAheadBuffers);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -630,6 +659,7 @@ void TopNRowNumber::close() {
   SCOPE_EXIT {
     table_.reset();
     singlePartition_.reset();
+    threshold_.reset();
     data_.reset();
     allocator_.reset();
   };
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/TopNThreshold.h"
 
 namespace facebook::velox::exec {
 class TopNRowNumberSpiller;
@@ -99,6 +100,11 @@ class TopNRowNumber : public Operator {
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // Adds the cutoff of the full 'singlePartition_' to 'dynamicFilters_' if it
+  // changed and an upstream table scan accepts filters on the leading sorting
+  // key.
+  void updateDynamicFilter();
+
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
   TopRows* nextPartition();
@@ -196,6 +202,16 @@ class TopNRowNumber : public Operator {
 
   std::unique_ptr<TopRows> singlePartition_;
 
+  // Makes dynamic filters from the cutoff on the leading sorting key of
+  // 'singlePartition_'. Not set if there are partitioning keys, the pushdown
+  // is disabled, the key type is not supported or no upstream operator
+  // accepts the filters.
+  std::unique_ptr<TopNThreshold> threshold_;
+
+  // True once the upstream operators were checked for accepting a filter on
+  // the leading sorting key.
+  bool thresholdPushdownChecked_{false};
+
   // Stores input data. For each partition, only up to 'limit_' rows are stored.
   // Order of columns matches 'inputChannels_': partition keys, sorting keys,
   // the rest.
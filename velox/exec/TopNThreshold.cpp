@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/TopNThreshold.h"
+
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+int64_t integerValueAt(const BaseVector& vector, vector_size_t index) {
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      return vector.asUnchecked<SimpleVector<int8_t>>()->valueAt(index);
+    case TypeKind::SMALLINT:
+      return vector.asUnchecked<SimpleVector<int16_t>>()->valueAt(index);
+    case TypeKind::INTEGER:
+      return vector.asUnchecked<SimpleVector<int32_t>>()->valueAt(index);
+    case TypeKind::BIGINT:
+      return vector.asUnchecked<SimpleVector<int64_t>>()->valueAt(index);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+std::unique_ptr<common::Filter> makeFloatingPointFilter(
+    T value,
+    bool ascending,
+    bool nullAllowed) {
+  if (std::isnan(value)) {
+    // NaN sorts after all other values.
+    return nullptr;
+  }
+  // NaN passes a range without upper bound, as it should for DESC order.
+  return std::make_unique<common::FloatingPointRange<T>>(
+      value,
+      ascending,
+      false,
+      value,
+      !ascending,
+      false,
+      nullAllowed);
+}
+
+} // namespace
+
+TopNThreshold::TopNThreshold(
+    const TypePtr& type,
+    const core::SortOrder& sortOrder,
+    column_index_t column,
+    memory::MemoryPool* pool)
+    : sortOrder_(sortOrder),
+      column_(column),
+      threshold_(BaseVector::create(type, 1, pool)),
+      candidate_(BaseVector::create(type, 1, pool)) {
+  VELOX_CHECK(supportsType(type), "Unsupported TopN cutoff type: {}", type);
+}
+
+// static
+bool TopNThreshold::supportsType(const TypePtr& type) {
+  if (type->isDecimal()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<common::Filter> TopNThreshold::update(
+    const RowContainer& data,
+    const char* row) {
+  data.extractColumn(&row, 1, column_, candidate_);
+  if (candidate_->isNullAt(0)) {
+    // With nulls first the cutoff only admits nulls, with nulls last it admits
+    // everything. Neither is worth a filter.
+    return nullptr;
+  }
+  if (hasThreshold_ && candidate_->equalValueAt(threshold_.get(), 0, 0)) {
+    return nullptr;
+  }
+  auto filter = makeFilter();
+  if (filter != nullptr) {
+    std::swap(threshold_, candidate_);
+    hasThreshold_ = true;
+  }
+  return filter;
+}
+
+std::unique_ptr<common::Filter> TopNThreshold::makeFilter() const {
+  // Rows equal to the cutoff pass since later sorting keys may still place
+  // them in the top rows. Nulls pass if they sort first.
+  const bool ascending = sortOrder_.isAscending();
+  const bool nullAllowed = sortOrder_.isNullsFirst();
+  switch (candidate_->typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      const auto value = integerValueAt(*candidate_, 0);
+      return std::make_unique<common::BigintRange>(
+          ascending ? std::numeric_limits<int64_t>::min() : value,
+          ascending ? value : std::numeric_limits<int64_t>::max(),
+          nullAllowed);
+    }
+    case TypeKind::REAL:
+      return makeFloatingPointFilter<float>(
+          candidate_->asUnchecked<SimpleVector<float>>()->valueAt(0),
+          ascending,
+          nullAllowed);
+    case TypeKind::DOUBLE:
+      return makeFloatingPointFilter<double>(
+          candidate_->asUnchecked<SimpleVector<double>>()->valueAt(0),
+          ascending,
+          nullAllowed);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto value = std::string(
+          candidate_->asUnchecked<SimpleVector<StringView>>()->valueAt(0));
+      return std::make_unique<common::BytesRange>(
+          value,
+          ascending,
+          false,
+          value,
+          !ascending,
+          false,
+          nullAllowed);
+    }
+    case TypeKind::TIMESTAMP: {
+      const auto value =
+          candidate_->asUnchecked<SimpleVector<Timestamp>>()->valueAt(0);
+      return std::make_unique<common::TimestampRange>(
+          ascending ? Timestamp::min() : value,
+          ascending ? value : Timestamp::max(),
+          nullAllowed);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::exec
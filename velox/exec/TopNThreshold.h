@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::exec {
+
+/// Tracks the cutoff of a TopN, i.e. the value of the leading sorting key of
+/// the last of the top rows, and makes dynamic filters from it. A row whose
+/// leading key sorts after the cutoff can not enter the top rows, so a table
+/// scan that feeds the TopN may drop it. The cutoff only improves as rows are
+/// added, so each new filter is tighter than the previous ones.
+///
+/// Used by TopN and by TopNRowNumber without partitioning keys.
+class TopNThreshold {
+ public:
+  /// @param column Index of the leading sorting key in the RowContainer.
+  TopNThreshold(
+      const TypePtr& type,
+      const core::SortOrder& sortOrder,
+      column_index_t column,
+      memory::MemoryPool* pool);
+
+  /// Returns true if a filter on a column of 'type' can express the cutoff.
+  static bool supportsType(const TypePtr& type);
+
+  /// Returns a filter that passes the values of the leading sorting key that
+  /// may still enter the top rows, given that 'row' of 'data' is the last of
+  /// these. Returns nullptr if the cutoff did not change since the last call,
+  /// or if the cutoff can not be expressed as a filter, e.g. it is null or NaN.
+  std::unique_ptr<common::Filter> update(
+      const RowContainer& data,
+      const char* row);
+
+ private:
+  std::unique_ptr<common::Filter> makeFilter() const;
+
+  const core::SortOrder sortOrder_;
+  const column_index_t column_;
+
+  // Single row vector with the cutoff of the last filter.
+  VectorPtr threshold_;
+
+  // Single row vector for the cutoff being considered.
+  VectorPtr candidate_;
+
+  bool hasThreshold_{false};
+};
+
+} // namespace facebook::velox::exec
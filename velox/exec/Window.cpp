@@ -61,7 +61,8 @@ Window::Window(
         common::PrefixSortConfig{
             driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
             driverCtx->queryConfig().prefixSortMinRows(),
-            driverCtx->queryConfig().prefixSortMaxStringPrefixLength()},
+            driverCtx->queryConfig().prefixSortMaxStringPrefixLength(),
+            driverCtx->queryConfig().prefixSortRadixSortEnabled()},
         spillConfig,
         &nonReclaimableSection_,
         &spillStats_);
@@ -14,15 +14,18 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
@@ -41,6 +44,11 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_string(
+    many_destinations,
+    "256,1024",
+    "Comma separated numbers of destinations for the PartitionedOutput "
+    "benchmarks with and without scatter mode");
 // Add the following definitions to allow Clion runs
 DEFINE_bool(gtest_color, false, "");
 DEFINE_string(gtest_filter, "*", "");
@@ -52,6 +60,10 @@ DEFINE_string(gtest_filter, "*", "");
 /// count the rows and send the count to a final single task stage
 /// that returns the sum of the counts. The sum is expected to be n *
 /// number of rows in constant input.
+///
+/// The many destinations benchmarks run a single task that partitions its
+/// input to hundreds of destinations and drain the output buffers directly,
+/// with and without the scatter mode of PartitionedOutput.
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -325,9 +337,83 @@ class ExchangeBenchmark : public VectorTestBase {
     };
   }
 
+  void runManyDestinations(
+      std::vector<RowVectorPtr>& vectors,
+      int32_t numDestinations,
+      bool scatter,
+      int32_t taskWidth,
+      PlanNodeStats& partitionedOutputStats) {
+    std::shared_ptr<Task> task;
+    core::PlanNodeId partitionedOutputId;
+    BENCHMARK_SUSPEND {
+      auto configCopy = configSettings_;
+      // The output is drained one destination at a time after the producers
+      // are done, so it must all fit in the buffer.
+      configSettings_[core::QueryConfig::kMaxOutputBufferSize] =
+          fmt::format("{}", 4UL << 30);
+      configSettings_
+          [core::QueryConfig::kPartitionedOutputScatterMinDestinations] =
+              scatter ? "1" : "0";
+      auto plan = exec::test::PlanBuilder()
+                      .values(vectors, true)
+                      .partitionedOutput({"c0"}, numDestinations)
+                      .capturePlanNodeId(partitionedOutputId)
+                      .planNode();
+      task = makeTask(makeTaskId(++iteration_, "many", 0), plan, 0);
+      configSettings_ = std::move(configCopy);
+    };
+
+    task->start(taskWidth);
+    auto bufferManager = OutputBufferManager::getInstance().lock();
+    for (auto destination = 0; destination < numDestinations; ++destination) {
+      drain(*bufferManager, task->taskId(), destination);
+    }
+    VELOX_CHECK(exec::test::waitForTaskCompletion(task.get(), 60'000'000));
+
+    BENCHMARK_SUSPEND {
+      partitionedOutputStats +=
+          toPlanStats(task->taskStats()).at(partitionedOutputId);
+    };
+  }
+
  private:
   static constexpr int64_t kMaxMemory = 6UL << 30; // 6GB
 
+  // Fetches and drops all pages of 'destination' of 'taskId'.
+  static void drain(
+      OutputBufferManager& bufferManager,
+      const std::string& taskId,
+      int destination) {
+    int64_t sequence = 0;
+    for (;;) {
+      auto [promise, future] = folly::makePromiseContract<bool>();
+      VELOX_CHECK(bufferManager.getData(
+          taskId,
+          destination,
+          1 << 20,
+          sequence,
+          [&sequence,
+           promise = std::make_shared<folly::Promise<bool>>(
+               std::move(promise))](
+              std::vector<std::unique_ptr<folly::IOBuf>> pages,
+              int64_t /*inSequence*/,
+              std::vector<int64_t> /*remainingBytes*/) {
+            for (const auto& page : pages) {
+              if (page == nullptr) {
+                promise->setValue(true);
+                return;
+              }
+              ++sequence;
+            }
+            promise->setValue(false);
+          }));
+      if (std::move(future).get()) {
+        bufferManager.deleteResults(taskId, destination);
+        return;
+      }
+    }
+  }
+
   static std::string
   makeTaskId(int32_t iteration, const std::string& prefix, int num) {
     return fmt::format("local://{}-{}-{}", iteration, prefix, num);
@@ -523,6 +609,27 @@ void runBenchmarks() {
     return 1;
   });
 
+  std::vector<int32_t> manyDestinations;
+  folly::splitTo<int32_t>(
+      ',', FLAGS_many_destinations, std::back_inserter(manyDestinations));
+  std::map<std::string, PlanNodeStats> manyDestinationsStats;
+  for (const auto numDestinations : manyDestinations) {
+    for (const bool scatter : {false, true}) {
+      const auto name = fmt::format(
+          "partitionFlat10k{}{}", numDestinations, scatter ? "Scatter" : "");
+      folly::addBenchmark(
+          __FILE__, name, [&, name, numDestinations, scatter]() {
+            bm->runManyDestinations(
+                flat10k,
+                numDestinations,
+                scatter,
+                FLAGS_task_width,
+                manyDestinationsStats[name]);
+            return 1;
+          });
+    }
+  }
+
   folly::runBenchmarks();
 
   std::cout
@@ -590,6 +697,12 @@ void runBenchmarks() {
       localPartitionWaitStats.wallMs.begin(),
       localPartitionWaitStats.wallMs.end());
   assert(!localPartitionWaitStats.wallMs.empty());
+
+  for (const auto& [name, stats] : manyDestinationsStats) {
+    std::cout << "-------------------------------" << name
+              << "-------------------------------" << std::endl;
+    std::cout << "PartitionOutput: " << stats.toString() << std::endl;
+  }
 }
 
 } // namespace
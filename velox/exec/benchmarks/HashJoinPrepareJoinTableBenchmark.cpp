@@ -23,6 +23,16 @@
 #include <folly/init/Init.h>
 #include <iostream>
 
+DEFINE_bool(
+    radix_partitioned_build,
+    false,
+    "Add builds of 128M rows with and without radix partitioning");
+
+DEFINE_int64(
+    allocator_capacity_gb,
+    10,
+    "Allocator capacity in GB. Increase for the radix partitioned cases");
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
@@ -36,18 +46,21 @@ struct HashTableBenchmarkParams {
   //  -the build row schema,
   //  -the expected hash table size,
   //  -number of building rows,
-  //  -number of build RowContainers.
+  //  -number of build RowContainers,
+  //  -whether the parallel build is radix partitioned.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
       int64_t hashTableSize,
       int64_t buildSize,
-      int32_t numWays)
+      int32_t numWays,
+      bool radixPartitioned = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         buildSize{buildSize},
-        numWays{numWays} {
+        numWays{numWays},
+        radixPartitioned{radixPartitioned} {
     VELOX_CHECK_LE(hashTableSize, buildSize);
     VELOX_CHECK_GE(numWays, 1);
 
@@ -66,11 +79,12 @@ struct HashTableBenchmarkParams {
     }
 
     title = fmt::format(
-        "Size:{},parallel:{},withDup:{},{}",
+        "Size:{},parallel:{},withDup:{},{}{}",
         buildSize,
         numWays > 1,
         buildSize > hashTableSize,
-        BaseHashTable::modeString(mode));
+        BaseHashTable::modeString(mode),
+        radixPartitioned ? ",radix" : "");
   }
 
   // Expected mode.
@@ -88,6 +102,10 @@ struct HashTableBenchmarkParams {
   // Number of build RowContainers.
   int32_t numWays;
 
+  // True if the parallel build scatters the rows into cache sized partitions
+  // first.
+  bool radixPartitioned{false};
+
   // Title for reporting
   std::string title;
 
@@ -126,6 +144,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
 
   // Run 'prepareJoinTable'.
   void run() {
+    topTable_->setRadixPartitionedJoinBuild(params_.radixPartitioned);
     topTable_->prepareJoinTable(
         std::move(otherTables_),
         BaseHashTable::kNoSpillInputStartPartitionBit,
@@ -133,6 +152,38 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     VELOX_CHECK_EQ(topTable_->hashMode(), params_.mode);
   }
 
+  // Probes the table made by run() with the build keys. Returns the number of
+  // hits.
+  int64_t probe() {
+    auto& hashers = topTable_->hashers();
+    HashLookup lookup(hashers);
+    VectorHasher::ScratchMemory scratchMemory;
+    int64_t numHits = 0;
+    for (const auto& batch : batches_) {
+      SelectivityVector rows(batch->size());
+      lookup.reset(batch->size());
+      for (auto i = 0; i < hashers.size(); ++i) {
+        auto key = batch->childAt(i);
+        if (topTable_->hashMode() != BaseHashTable::HashMode::kHash) {
+          hashers[i]->lookupValueIds(*key, rows, scratchMemory, lookup.hashes);
+        } else {
+          hashers[i]->decode(*key, rows);
+          hashers[i]->hash(rows, i > 0, lookup.hashes);
+        }
+      }
+      lookup.rows.clear();
+      rows.applyToSelected([&](auto row) { lookup.rows.push_back(row); });
+      if (lookup.rows.empty()) {
+        continue;
+      }
+      topTable_->joinProbe(lookup);
+      for (auto row : lookup.rows) {
+        numHits += lookup.hits[row] != nullptr;
+      }
+    }
+    return numHits;
+  }
+
  private:
   // Create the row vector for the build side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
@@ -206,7 +257,8 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
   // Create join table.
   void createTable() {
     std::vector<TypePtr> dependentTypes;
-    std::vector<RowVectorPtr> batches;
+    auto& batches = batches_;
+    batches.clear();
     makeBuildBatches(batches);
     for (auto i = 0; i < params_.numWays; ++i) {
       std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -232,6 +284,8 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
   }
 
   std::default_random_engine randomEngine_;
+  // The build side rows. Also used as probe input.
+  std::vector<RowVectorPtr> batches_;
   std::unique_ptr<HashTable<true>> topTable_;
   std::vector<std::unique_ptr<BaseHashTable>> otherTables_;
   HashTableBenchmarkParams params_;
@@ -277,6 +331,31 @@ void initNormalizedKeyModeBenchmarkParams(
   }
 }
 
+// Builds of 128M rows with one partition per build thread and with cache sized
+// radix partitions.
+void initRadixPartitionedBenchmarkParams(
+    std::vector<HashTableBenchmarkParams>& params) {
+  TypePtr twoKeyType{ROW({"k1", "k2"}, {BIGINT(), BIGINT()})};
+  TypePtr threeKeyType{ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()})};
+  constexpr int64_t kBuildSize = 128L << 20;
+  for (auto radixPartitioned : {false, true}) {
+    params.push_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kNormalizedKey,
+        twoKeyType,
+        kBuildSize,
+        kBuildSize,
+        16,
+        radixPartitioned));
+    params.push_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash,
+        threeKeyType,
+        kBuildSize / 4,
+        kBuildSize,
+        16,
+        radixPartitioned));
+  }
+}
+
 void initHashModeBenchmarkParams(
     std::vector<HashTableBenchmarkParams>& params) {
   TypePtr threeKeyType{ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()})};
@@ -302,7 +381,7 @@ int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManagerOptions options;
   options.useMmapAllocator = true;
-  options.allocatorCapacity = 10UL << 30;
+  options.allocatorCapacity = FLAGS_allocator_capacity_gb << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
   memory::MemoryManager::initialize(options);
@@ -312,6 +391,9 @@ int main(int argc, char** argv) {
   // initArrayModeBenchmarkParams(params);
   initNormalizedKeyModeBenchmarkParams(params);
   initHashModeBenchmarkParams(params);
+  if (FLAGS_radix_partitioned_build) {
+    initRadixPartitionedBenchmarkParams(params);
+  }
 
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm]() {
@@ -321,6 +403,14 @@ int main(int argc, char** argv) {
       bm->run();
       return 1;
     });
+    folly::addBenchmark(__FILE__, param.title + ",probe", [param, &bm]() {
+      folly::BenchmarkSuspender suspender;
+      bm->prepare(param);
+      bm->run();
+      suspender.dismiss();
+      folly::doNotOptimizeAway(bm->probe());
+      return 1;
+    });
   }
   folly::runBenchmarks();
   return 0;
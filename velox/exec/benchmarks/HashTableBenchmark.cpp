@@ -36,6 +36,17 @@ DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
+DEFINE_int32(
+    custom_probe_group_size,
+    0,
+    "Rows probed together in custom test. 0 for adaptive");
+
+DEFINE_int64(
+    allocator_capacity_gb,
+    10,
+    "Allocator capacity in GB. Increase for tables over 128M entries. The 1B "
+    "entry cases run if this is at least 64");
+
 DEFINE_bool(profile, false, "Generate perf profiles and memory stats");
 
 DECLARE_bool(velox_time_allocations);
@@ -45,6 +56,9 @@ using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
 namespace {
+// Allocator capacity for the rows and buckets of a table of 1B entries.
+constexpr int64_t k1BTableCapacityGb = 64;
+
 struct HashTableBenchmarkParams {
   HashTableBenchmarkParams() = default;
 
@@ -53,13 +67,15 @@ struct HashTableBenchmarkParams {
       int64_t size,
       int32_t hitrate,
       int32_t keySpacing = 1,
-      int32_t _numWays = 10)
+      int32_t _numWays = 10,
+      int32_t _probeGroupSize = 0)
       : title(std::move(title)),
         buildSize(size),
         size(100 * (size / _numWays) / hitrate),
         numWays(_numWays),
         insertPct(hitrate),
-        keySpacing(keySpacing) {}
+        keySpacing(keySpacing),
+        probeGroupSize(_probeGroupSize) {}
 
   // Title for reporting
   std::string title;
@@ -89,13 +105,18 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Number of rows the table probes together. 0 means the table picks the
+  // size from its size relative to the CPU caches.
+  int32_t probeGroupSize{0};
+
   std::string toString() const {
     return fmt::format(
-        "{}: Rows={} Hit%={} NumProbes={}",
+        "{}: Rows={} Hit%={} NumProbes={} ProbeGroup={}",
         title,
         buildSize,
         insertPct,
-        size * numWays);
+        size * numWays,
+        probeGroupSize == 0 ? "adaptive" : std::to_string(probeGroupSize));
   }
 };
 
@@ -114,6 +135,9 @@ struct HashTableBenchmarkRun {
   // The mode of the table.
   BaseHashTable::HashMode hashMode;
 
+  // Number of rows probed together.
+  int32_t probeGroupSize;
+
   // Clocks for same operation with F14FastSet if applicable.
   float f14ProbeClocks{-1};
 
@@ -130,7 +154,8 @@ struct HashTableBenchmarkRun {
         : hashMode == BaseHashTable::HashMode::kHash ? "hash"
                                                      : "normalized key";
     out << std::endl
-        << " numDistinct=" << numDistinct << " mode=" << modeString;
+        << " numDistinct=" << numDistinct << " mode=" << modeString
+        << " probeGroupSize=" << probeGroupSize;
     return out.str();
   }
 };
@@ -226,11 +251,13 @@ class HashTableBenchmark : public VectorTestBase {
   HashTableBenchmarkRun run() {
     HashTableBenchmarkRun result;
     result.params = params_;
+    topTable_->setProbeGroupSize(params_.probeGroupSize);
     testProbe();
     result.hashClocks = hashClocksPerRow_;
     result.probeClocks = clocksPerRow_;
     result.hashMode = topTable_->hashMode();
     result.numDistinct = topTable_->numDistinct();
+    result.probeGroupSize = topTable_->probeGroupSize();
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
       testF14Probe();
       result.f14ProbeClocks = clocksPerRow_;
@@ -623,7 +650,7 @@ int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManagerOptions options;
   options.useMmapAllocator = true;
-  options.allocatorCapacity = 10UL << 30;
+  options.allocatorCapacity = FLAGS_allocator_capacity_gb << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
   memory::MemoryManager::initialize(options);
@@ -655,14 +682,31 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Hit32M", 32000000, 100),
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
-      HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+      HashTableBenchmarkParams("Hit128M", 128000000, 100),
+
+      // The same probes with the 4 row groups used before the probe group
+      // size adapted to the table size. Tables that fit in cache should not
+      // differ. Tables in memory should gain from more misses in flight.
+      HashTableBenchmarkParams("Hit1M", 1000000, 100),
+      HashTableBenchmarkParams("Hit1MGroup4", 1000000, 100, 1, 10, 4),
+      HashTableBenchmarkParams("Hit32MGroup4", 32000000, 100, 1, 10, 4),
+      HashTableBenchmarkParams("Miss32MGroup4", 32000000, 5, 1, 10, 4),
+      HashTableBenchmarkParams("Hit128MGroup4", 128000000, 100, 1, 10, 4)};
+  if (FLAGS_allocator_capacity_gb >= k1BTableCapacityGb) {
+    // Only hits, since the probe side of a miss case at this size would not
+    // fit the int32_t row counts.
+    params.push_back(HashTableBenchmarkParams("Hit1B", 1000000000, 100));
+    params.push_back(
+        HashTableBenchmarkParams("Hit1BGroup4", 1000000000, 100, 1, 10, 4));
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
         FLAGS_custom_size,
         FLAGS_custom_hit_rate,
         FLAGS_custom_key_spacing,
-        FLAGS_custom_num_ways));
+        FLAGS_custom_num_ways,
+        FLAGS_custom_probe_group_size));
   }
 
   for (auto& param : params) {
@@ -43,11 +43,24 @@ class OrderByBenchmark {
       int32_t iterations,
       int numKeys) {
     TestCase testCase = {numRows, rowType, numKeys};
-    {
+    // Compares quick-sort and radix sort of the prefix-sort normalized keys,
+    // and quick-sort of ranges of the rows on 8 threads.
+    struct SortVariant {
+      std::string prefix;
+      bool radixSort;
+      uint32_t sortParallelism;
+    };
+    for (const auto& variant :
+         {SortVariant{"OrderBy_", false, 1},
+          SortVariant{"OrderByRadixSort_", true, 1},
+          SortVariant{"OrderByParallelSort_", false, 8}}) {
       folly::addBenchmark(
           __FILE__,
-          "OrderBy_" + benchmarkName,
-          [test = testCase, iterations = std::max(1, iterations / 10), this]() {
+          variant.prefix + benchmarkName,
+          [test = testCase,
+           iterations = std::max(1, iterations / 10),
+           variant,
+           this]() {
             core::PlanNodeId orderByNodeId;
             const auto plan = makeOrderByPlan(test, orderByNodeId);
             uint64_t inputNs = 0;
@@ -56,7 +69,14 @@ class OrderByBenchmark {
             const auto start = getCurrentTimeMicro();
             for (auto i = 0; i < iterations; ++i) {
               std::shared_ptr<Task> task;
-              test::AssertQueryBuilder(plan).runWithoutResults(task);
+              test::AssertQueryBuilder(plan)
+                  .config(
+                      core::QueryConfig::kPrefixSortRadixSortEnabled,
+                      variant.radixSort ? "true" : "false")
+                  .config(
+                      core::QueryConfig::kOrderBySortParallelism,
+                      std::to_string(variant.sortParallelism))
+                  .runWithoutResults(task);
               auto taskStats = exec::toPlanStats(task->taskStats());
               auto& stats = taskStats.at(orderByNodeId);
               inputNs += stats.addInputTiming.wallNanos;
@@ -17,6 +17,7 @@
 #include <folly/init/Init.h>
 
 #include "velox/common/memory/Memory.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -40,6 +41,65 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
     for (auto i = 0; i < 10; ++i) {
       rowVectors_.emplace_back(fuzzer.fuzzInputRow(rowType));
     }
+
+    groupIds_ = makeFlatVector<int64_t>(
+        opts.vectorSize, [](auto row) { return row % kNumGroups; });
+  }
+
+  // Adds the values of column 'a' to 100K groups of 100 rows each using a
+  // SetAccumulator per group, as DistinctAggregations does by default.
+  void runManyGroupsPerGroupSets() {
+    using AccumulatorType = aggregate::prestosql::SetAccumulator<int64_t>;
+
+    // Like group rows, holds the accumulators in raw memory since free()
+    // destroys them.
+    struct alignas(AccumulatorType) Storage {
+      char data[sizeof(AccumulatorType)];
+    };
+
+    HashStringAllocator allocator(pool());
+    const auto& type = rowVectors_[0]->childAt("a")->type();
+    std::vector<Storage> storage(kNumGroups);
+    auto* accumulators = reinterpret_cast<AccumulatorType*>(storage.data());
+    for (auto i = 0; i < kNumGroups; ++i) {
+      new (accumulators + i) AccumulatorType(type, &allocator);
+    }
+
+    const auto* rawGroupIds = groupIds_->rawValues();
+    for (const auto& rowVector : rowVectors_) {
+      DecodedVector decoded(*rowVector->childAt("a"));
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        accumulators[rawGroupIds[i]].addValue(decoded, i, &allocator);
+      }
+    }
+
+    size_t numDistinct = 0;
+    for (auto i = 0; i < kNumGroups; ++i) {
+      numDistinct += accumulators[i].size();
+      accumulators[i].free(allocator);
+    }
+    folly::doNotOptimizeAway(numDistinct);
+  }
+
+  // Same as runManyGroupsPerGroupSets() but de-duplicates (group, value) pairs
+  // of all groups in one HashTable, as DistinctAggregations does with a shared
+  // table.
+  void runManyGroupsSharedTable() {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(VectorHasher::create(BIGINT(), 0));
+    hashers.push_back(VectorHasher::create(BIGINT(), 1));
+    auto table = HashTable<false>::createForAggregation(
+        std::move(hashers), std::vector<Accumulator>{}, pool());
+    HashLookup lookup(table->hashers());
+
+    for (const auto& rowVector : rowVectors_) {
+      auto input = makeRowVector({groupIds_, rowVector->childAt("a")});
+      SelectivityVector rows(input->size());
+      table->prepareForGroupProbe(
+          lookup, input, rows, BaseHashTable::kNoSpillInputStartPartitionBit);
+      table->groupProbe(lookup, BaseHashTable::kNoSpillInputStartPartitionBit);
+    }
+    folly::doNotOptimizeAway(table->numDistinct());
   }
 
   void runBigint() {
@@ -91,7 +151,10 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
     folly::doNotOptimizeAway(result);
   }
 
+  static constexpr int32_t kNumGroups = 100'000;
+
   std::vector<RowVectorPtr> rowVectors_;
+  FlatVectorPtr<int64_t> groupIds_;
 };
 
 std::unique_ptr<SetAccumulatorBenchmark> bm;
@@ -108,6 +171,14 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(manyGroupsPerGroupSets) {
+  bm->runManyGroupsPerGroupSets();
+}
+
+BENCHMARK_RELATIVE(manyGroupsSharedTable) {
+  bm->runManyGroupsSharedTable();
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
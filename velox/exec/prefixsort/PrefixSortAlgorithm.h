@@ -15,10 +15,13 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
 
+#include <folly/Portability.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 
@@ -151,6 +154,16 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Within radixSort, partitions with fewer entries than kSmallRadixSort are
+  // sorted with quick-sort. Distributing a small partition costs more than
+  // comparing its entries.
+  static const int kSmallRadixSort = 64;
+
+  // Within radixSort, partitions that would be distributed more than
+  // kMaxRadixSortDepth times are sorted with quick-sort. This bounds the stack
+  // used by the histograms of the nested distributions.
+  static const int kMaxRadixSortDepth = 32;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +172,26 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) with a most significant byte first
+  /// radix sort on the first 'keyBytes' bytes of the entries. The key bytes
+  /// are compared as a sequence of native-endian uint64_t words, like the
+  /// normalized keys of PrefixSort, so 'keyBytes' must be a multiple of 8.
+  /// Partitions with fewer than kSmallRadixSort entries and entries whose key
+  /// bytes are all equal are sorted with quick-sort using 'compare', which
+  /// must order the entries by their key bytes first.
+  template <typename TCompare>
+  void radixSort(char* start, char* end, uint32_t keyBytes, TCompare compare)
+      const {
+    VELOX_CHECK_EQ(keyBytes % sizeof(uint64_t), 0);
+    radixSort(
+        detail::PrefixSortIterator(start, entrySize_),
+        detail::PrefixSortIterator(end, entrySize_),
+        0,
+        keyBytes,
+        0,
+        compare);
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -347,6 +380,92 @@ class PrefixSortRunner {
     }
   }
 
+  // Returns the radix of the entry at 'entry' for the 'byte'-th most
+  // significant byte of its key. The key is a sequence of uint64_t words, so
+  // the most significant byte of a word is the last one on little-endian.
+  FOLLY_ALWAYS_INLINE static uint8_t radixAt(const char* entry, uint32_t byte) {
+    static_assert(folly::kIsLittleEndian);
+    return entry[(byte & ~7) + 7 - (byte & 7)];
+  }
+
+  // Sorts the entries in [start, end) on the key bytes from 'byte' on.
+  // 'depth' is the number of distributions the entries went through. The
+  // entries are distributed in place to the partitions of their radix, with
+  // the permutation cycles of American flag sort, and each partition is
+  // sorted on the next byte.
+  template <typename TCompare>
+  void radixSort(
+      const detail::PrefixSortIterator& start,
+      const detail::PrefixSortIterator& end,
+      uint32_t byte,
+      uint32_t keyBytes,
+      int32_t depth,
+      TCompare compare) const {
+    const uint64_t len = end - start;
+    // Start of the partition of each radix, followed by the end of the last.
+    std::array<uint64_t, 257> offsets;
+    for (;; ++byte) {
+      if (len < kSmallRadixSort || byte == keyBytes ||
+          depth == kMaxRadixSortDepth) {
+        if (len > 1) {
+          quickSort(start, end, compare);
+        }
+        return;
+      }
+      std::array<uint64_t, 256> counts{};
+      for (auto it = start; it < end; ++it) {
+        ++counts[radixAt(*it, byte)];
+      }
+      // All the entries have the same radix: go to the next byte.
+      if (counts[radixAt(*start, byte)] == len) {
+        continue;
+      }
+      offsets[0] = 0;
+      for (auto radix = 0; radix < 256; ++radix) {
+        offsets[radix + 1] = offsets[radix] + counts[radix];
+      }
+      distribute(start, byte, offsets);
+      break;
+    }
+
+    for (auto radix = 0; radix < 256; ++radix) {
+      const auto size = offsets[radix + 1] - offsets[radix];
+      if (size > 1) {
+        radixSort(
+            start + offsets[radix],
+            start + offsets[radix + 1],
+            byte + 1,
+            keyBytes,
+            depth + 1,
+            compare);
+      }
+    }
+  }
+
+  // Moves each entry from 'start' on to the partition of its radix for
+  // 'byte'. 'offsets' has the start of each partition relative to 'start'.
+  void distribute(
+      const detail::PrefixSortIterator& start,
+      uint32_t byte,
+      const std::array<uint64_t, 257>& offsets) const {
+    // The next position to fill in each partition.
+    std::array<uint64_t, 256> heads;
+    std::copy(offsets.begin(), offsets.end() - 1, heads.begin());
+    for (auto radix = 0; radix < 256; ++radix) {
+      while (heads[radix] < offsets[radix + 1]) {
+        const auto entry = start + heads[radix];
+        const auto target = radixAt(*entry, byte);
+        if (target != radix) {
+          // Swap the entry into its partition and look at the entry swapped
+          // out of there next.
+          swap(entry, start + heads[target]++);
+        } else {
+          ++heads[radix];
+        }
+      }
+    }
+  }
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
@@ -44,6 +44,53 @@ class PrefixSortAlgorithmBenchmark {
         });
   }
 
+  // Sorts entries of 'numKeys' words compared as native uint64_t words, the
+  // layout of the PrefixSort normalized keys, with quick-sort or radix sort.
+  void runWordSort(std::vector<uint64_t> vec, int32_t numKeys, bool radix) {
+    char* start = (char*)vec.data();
+    const uint32_t entrySize = numKeys * sizeof(uint64_t);
+    char* end = start + sizeof(uint64_t) * vec.size();
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    const auto compare = [&](char* a, char* b) {
+      auto* left = reinterpret_cast<uint64_t*>(a);
+      auto* right = reinterpret_cast<uint64_t*>(b);
+      for (auto i = 0; i < numKeys; ++i) {
+        if (left[i] != right[i]) {
+          return left[i] < right[i] ? -1 : 1;
+        }
+      }
+      return 0;
+    };
+    if (radix) {
+      sortRunner.radixSort(start, end, entrySize, compare);
+    } else {
+      sortRunner.quickSort(start, end, compare);
+    }
+  }
+
+  // Returns 'size' entries of 'numKeys' random words. If 'stringPrefix' is
+  // true, the words are like the normalized prefixes of short strings from a
+  // small alphabet, with a common first byte and zero padding.
+  std::vector<uint64_t>
+  generateWordVector(int32_t size, int32_t numKeys, bool stringPrefix) {
+    std::vector<uint64_t> words(size * numKeys);
+    for (auto& word : words) {
+      if (stringPrefix) {
+        word = 1ULL << 56;
+        const auto length = folly::Random::rand32(1, 8, rng_);
+        for (uint32_t i = 1; i < length; ++i) {
+          word |= uint64_t('a' + folly::Random::rand32(26, rng_))
+              << (56 - 8 * i);
+        }
+      } else {
+        word = folly::Random::rand64(rng_);
+      }
+    }
+    return words;
+  }
+
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
@@ -66,6 +113,10 @@ std::vector<int64_t> data100k;
 std::vector<int64_t> data1000k;
 std::vector<int64_t> data10000k;
 
+std::vector<uint64_t> bigint1000k;
+std::vector<uint64_t> multiKey1000k;
+std::vector<uint64_t> stringPrefix1000k;
+
 BENCHMARK(PrefixSort_algorithm_10k) {
   bm->runQuickSort(data10k);
 }
@@ -82,6 +133,30 @@ BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK(PrefixSort_bigint_quickSort_1000k) {
+  bm->runWordSort(bigint1000k, 1, false);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_bigint_radixSort_1000k) {
+  bm->runWordSort(bigint1000k, 1, true);
+}
+
+BENCHMARK(PrefixSort_multiKey_quickSort_1000k) {
+  bm->runWordSort(multiKey1000k, 3, false);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_multiKey_radixSort_1000k) {
+  bm->runWordSort(multiKey1000k, 3, true);
+}
+
+BENCHMARK(PrefixSort_stringPrefix_quickSort_1000k) {
+  bm->runWordSort(stringPrefix1000k, 2, false);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_stringPrefix_radixSort_1000k) {
+  bm->runWordSort(stringPrefix1000k, 2, true);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -93,6 +168,9 @@ int main(int argc, char** argv) {
   data100k = bm->generateTestVector(100'000);
   data1000k = bm->generateTestVector(1'000'000);
   data10000k = bm->generateTestVector(10'000'000);
+  bigint1000k = bm->generateWordVector(1'000'000, 1, false);
+  multiKey1000k = bm->generateWordVector(1'000'000, 3, false);
+  stringPrefix1000k = bm->generateWordVector(1'000'000, 2, true);
   folly::runBenchmarks();
   return 0;
 }
@@ -55,6 +55,65 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  // Sorts entries of 'numWords' uint64_t words, of which the first
+  // 'numKeyWords' are the key, with radix sort and checks the keys against
+  // std::sort. 'mask' is applied to the random key words to make duplicates
+  // and common prefixes.
+  void testRadixSort(
+      size_t size,
+      int32_t numKeyWords,
+      int32_t numWords,
+      uint64_t mask) {
+    std::vector<uint64_t> data(size * numWords);
+    for (auto i = 0; i < data.size(); ++i) {
+      data[i] = i % numWords < numKeyWords ? folly::Random::rand64() & mask
+                                           : i / numWords;
+    }
+    const auto compareKeys = [&](const uint64_t* a, const uint64_t* b) {
+      for (auto i = 0; i < numKeyWords; ++i) {
+        if (a[i] != b[i]) {
+          return a[i] < b[i] ? -1 : 1;
+        }
+      }
+      return 0;
+    };
+
+    std::vector<const uint64_t*> expected(size);
+    for (auto i = 0; i < size; ++i) {
+      expected[i] = data.data() + i * numWords;
+    }
+    std::sort(expected.begin(), expected.end(), [&](auto a, auto b) {
+      return compareKeys(a, b) < 0;
+    });
+    std::vector<uint64_t> expectedKeys;
+    for (auto* entry : expected) {
+      expectedKeys.insert(expectedKeys.end(), entry, entry + numKeyWords);
+    }
+
+    const uint32_t entrySize = numWords * sizeof(uint64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+    PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+    char* start = reinterpret_cast<char*>(data.data());
+    sortRunner.radixSort(
+        start,
+        start + entrySize * size,
+        numKeyWords * sizeof(uint64_t),
+        [&](char* a, char* b) {
+          return compareKeys(
+              reinterpret_cast<const uint64_t*>(a),
+              reinterpret_cast<const uint64_t*>(b));
+        });
+
+    std::vector<uint64_t> actualKeys;
+    for (auto i = 0; i < size; ++i) {
+      actualKeys.insert(
+          actualKeys.end(),
+          data.begin() + i * numWords,
+          data.begin() + i * numWords + numKeyWords);
+    }
+    ASSERT_EQ(actualKeys, expectedKeys);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +129,24 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  for (auto size :
+       {0,
+        1,
+        PrefixSortRunner::kSmallRadixSort - 1,
+        PrefixSortRunner::kSmallRadixSort,
+        10'000}) {
+    SCOPED_TRACE(fmt::format("size {}", size));
+    testRadixSort(size, 1, 1, ~0ULL);
+    // Few distinct keys.
+    testRadixSort(size, 1, 2, 0xF000'0000'0000'000FULL);
+    // Keys that differ only in low bytes.
+    testRadixSort(size, 1, 2, 0xFFFFULL);
+    // Keys of two words and a payload word.
+    testRadixSort(size, 2, 3, 0xFF00'0000'0000'00FFULL);
+  }
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -1580,6 +1580,117 @@ TEST_F(AggregationTest, groupingSetsEmptyInput) {
       }));
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 3; ++i) {
+    data.push_back(makeRowVector(
+        {"k1", "k2", "k3", "a", "b"},
+        {
+            makeFlatVector<int64_t>(1'000, [](auto row) { return row % 11; }),
+            makeFlatVector<int64_t>(
+                1'000,
+                [](auto row) { return row % 17; },
+                [](auto row) { return row % 13 == 0; }),
+            makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 5; }),
+            makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+            makeFlatVector<std::string>(
+                1'000, [](auto row) { return std::string(row % 12, 'x'); }),
+        }));
+  }
+  createDuckDbTable(data);
+
+  const std::vector<std::string> aggregates{
+      "count(1) as count_1",
+      "sum(a) as sum_a",
+      "max(b) as max_b",
+      "avg(a) as avg_a"};
+
+  // Compares with the same grouping sets computed by a GroupId node followed
+  // by an aggregation, and with DuckDB.
+  auto testGroupingSets =
+      [&](const std::vector<std::string>& groupingKeys,
+          const std::vector<std::vector<std::string>>& groupingSets,
+          const std::string& groupBy,
+          const std::string& filter = "true") {
+        SCOPED_TRACE(groupBy);
+        auto groupIdKeys = groupingKeys;
+        groupIdKeys.push_back("group_id");
+        auto expected = AssertQueryBuilder(
+                            PlanBuilder()
+                                .values(data)
+                                .filter(filter)
+                                .groupId(groupingKeys, groupingSets, {"a", "b"})
+                                .singleAggregation(groupIdKeys, aggregates)
+                                .planNode())
+                            .copyResults(pool());
+
+        auto projections = groupingKeys;
+        projections.insert(
+            projections.end(), {"count_1", "sum_a", "max_b", "avg_a"});
+        core::PlanNodePtr aggregation;
+        auto plan = PlanBuilder()
+                        .values(data)
+                        .filter(filter)
+                        .groupingSetsAggregation(
+                            groupingKeys, groupingSets, aggregates)
+                        .capturePlanNode(aggregation)
+                        .project(projections)
+                        .planNode();
+        AssertQueryBuilder(aggregation).assertResults(expected);
+
+        assertQuery(
+            plan,
+            fmt::format(
+                "SELECT {}, count(1), sum(a), max(b), avg(a) FROM tmp "
+                "WHERE {} GROUP BY {}",
+                folly::join(", ", groupingKeys),
+                filter,
+                groupBy));
+      };
+
+  testGroupingSets(
+      {"k1", "k2", "k3"},
+      {{"k1", "k2", "k3"}, {"k1", "k2"}, {"k1"}, {}},
+      "ROLLUP (k1, k2, k3)");
+  testGroupingSets(
+      {"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, "CUBE (k1, k2)");
+  // The finest level is not one of the grouping sets.
+  testGroupingSets(
+      {"k1", "k2", "k3"},
+      {{"k3", "k1"}, {"k2", "k3"}, {"k3"}},
+      "GROUPING SETS ((k1, k3), (k2, k3), (k3))");
+  testGroupingSets(
+      {"k1", "k2"},
+      {{"k1", "k2"}, {}},
+      "GROUPING SETS ((k1, k2), ())",
+      "k1 < 0");
+
+  // Repeated grouping sets.
+  auto expected =
+      AssertQueryBuilder(
+          PlanBuilder()
+              .values(data)
+              .groupId({"k1", "k2"}, {{"k1"}, {}, {"k1"}}, {"a", "b"})
+              .singleAggregation({"k1", "k2", "group_id"}, aggregates)
+              .planNode())
+          .copyResults(pool());
+  AssertQueryBuilder(
+      PlanBuilder()
+          .values(data)
+          .groupingSetsAggregation(
+              {"k1", "k2"}, {{"k1"}, {}, {"k1"}}, aggregates)
+          .planNode())
+      .assertResults(expected);
+
+  VELOX_ASSERT_THROW(
+      PlanBuilder()
+          .values(data)
+          .groupingSetsAggregation(
+              {"k1", "k2"}, {{"k1"}, {}}, {"count(distinct a)"})
+          .planNode(),
+      "Grouping sets do not support distinct or sorted aggregates");
+}
+
 TEST_F(AggregationTest, disableNonBooleanMasks) {
   auto data = makeRowVector(
       {"c0", "c1"},
@@ -1993,6 +2104,212 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
       plan, "SELECT c0 % 7, array_agg(c1 ORDER BY c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(AggregationTest, sortFallback) {
+  // 90% of the keys are distinct, so most groups have one row and the rest
+  // have two, spread over different batches.
+  constexpr int32_t kNumBatches = 20;
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [&](auto row) { return (i * kBatchSize + row) % 18'000; },
+            [](auto row) { return row == 7; }),
+        makeFlatVector<int32_t>(kBatchSize, [&](auto row) { return i + row; }),
+        makeFlatVector<std::string>(
+            kBatchSize,
+            [&](auto row) { return fmt::format("s{}", (i * 31 + row) % 97); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"}, {"sum(c1)", "count(1)", "max(c2)", "min(c1)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  const std::string sql =
+      "SELECT c0, sum(c1), count(1), max(c2), min(c1) FROM tmp GROUP BY 1";
+
+  for (const auto maxSpillRunRows : {0, 2'000}) {
+    SCOPED_TRACE(fmt::format("maxSpillRunRows: {}", maxSpillRunRows));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationSortFallbackMinPct, 80)
+            .config(QueryConfig::kAggregationSortFallbackMinRows, 3'000)
+            .config(QueryConfig::kMaxSpillRunRows, maxSpillRunRows)
+            .assertResults(sql);
+    auto stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    ASSERT_EQ(stats.customStats.at(HashAggregation::kSortFallback).sum, 1);
+    ASSERT_GT(stats.spilledRows, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+
+  // Keys that repeat stay in the hash table.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(QueryConfig::kSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kAggregationSortFallbackMinPct, 80)
+          .config(QueryConfig::kAggregationSortFallbackMinRows, 3'000)
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation({"c2"}, {"sum(c1)"})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults("SELECT c2, sum(c1) FROM tmp GROUP BY 1");
+  auto stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(stats.customStats.count(HashAggregation::kSortFallback), 0);
+  ASSERT_EQ(stats.spilledRows, 0);
+}
+
+TEST_F(AggregationTest, sharedDistinctTable) {
+  // 2'000 groups of 5 rows each, spread over different batches. Each batch
+  // has distinct keys. The values repeat within and across groups.
+  constexpr int32_t kNumBatches = 10;
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return (i * 7 + row) % 2'000; }),
+        makeFlatVector<int32_t>(
+            kBatchSize,
+            [&](auto row) { return row % 3; },
+            [](auto row) { return row % 11 == 0; }),
+        makeFlatVector<std::string>(
+            kBatchSize, [&](auto row) { return fmt::format("s{}", row % 5); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates{
+      "count(distinct c1)", "sum(distinct c1)", "count(distinct c2)"};
+  const std::string sql =
+      "SELECT c0, count(distinct c1), sum(distinct c1), count(distinct c2) "
+      "FROM tmp GROUP BY 1";
+
+  core::PlanNodeId aggrNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kDistinctAggregationSharedTableMinPct, 50)
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation({"c0"}, aggregates)
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(sql);
+  auto stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(stats.customStats.at(HashAggregation::kSharedDistinctTable).sum, 1);
+
+  // Global aggregation keeps a set per group.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .config(QueryConfig::kDistinctAggregationSharedTableMinPct, 50)
+             .plan(PlanBuilder()
+                       .values(vectors)
+                       .singleAggregation({}, aggregates)
+                       .capturePlanNodeId(aggrNodeId)
+                       .planNode())
+             .assertResults(
+                 "SELECT count(distinct c1), sum(distinct c1), "
+                 "count(distinct c2) FROM tmp");
+  stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(stats.customStats.count(HashAggregation::kSharedDistinctTable), 0);
+
+  // Few groups with many rows keep a set per group.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .config(QueryConfig::kDistinctAggregationSharedTableMinPct, 50)
+             .plan(PlanBuilder()
+                       .values(vectors)
+                       .singleAggregation({"c2"}, {"count(distinct c0)"})
+                       .capturePlanNodeId(aggrNodeId)
+                       .planNode())
+             .assertResults(
+                 "SELECT c2, count(distinct c0) FROM tmp GROUP BY 1");
+  stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(stats.customStats.count(HashAggregation::kSharedDistinctTable), 0);
+}
+
+TEST_F(AggregationTest, clusteredInput) {
+  // Groups of 150 consecutive rows in batches of 100 rows. Each group spans
+  // at most 2 batches.
+  constexpr int32_t kNumBatches = 20;
+  constexpr int32_t kBatchSize = 100;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return (i * kBatchSize + row) / 150; }),
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [](auto row) { return row % 7; },
+            [](auto row) { return row % 13 == 0; }),
+        makeFlatVector<std::string>(
+            kBatchSize,
+            [&](auto row) {
+              return fmt::format("a long string value {}", i * row);
+            }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates{"sum(c1)", "count(1)", "max(c2)"};
+  const std::string sql =
+      "SELECT c0, sum(c1), count(1), max(c2) FROM tmp GROUP BY 1";
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .clusteredAggregation({"c0"}, aggregates)
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  ASSERT_NE(plan->toString(true, false).find("CLUSTERED"), std::string::npos);
+
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kAggregationClusteredInputEvictionBatches, 2)
+          .plan(plan)
+          .assertResults(sql);
+  auto stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_GT(stats.customStats.at(HashAggregation::kNumEvictedGroups).sum, 0);
+
+  // 0 keeps all groups until the end of input.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .config(QueryConfig::kAggregationClusteredInputEvictionBatches, 0)
+             .plan(plan)
+             .assertResults(sql);
+  stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_EQ(stats.customStats.count(HashAggregation::kNumEvictedGroups), 0);
+
+  // A distinct aggregation frees the groups it has produced.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .config(QueryConfig::kAggregationClusteredInputEvictionBatches, 2)
+             .plan(PlanBuilder()
+                       .values(vectors)
+                       .clusteredAggregation({"c0"}, {})
+                       .capturePlanNodeId(aggrNodeId)
+                       .planNode())
+             .assertResults("SELECT DISTINCT c0 FROM tmp");
+  stats = toPlanStats(task->taskStats()).at(aggrNodeId);
+  ASSERT_GT(stats.customStats.at(HashAggregation::kNumEvictedGroups).sum, 0);
+
+  VELOX_ASSERT_THROW(
+      PlanBuilder()
+          .values(vectors)
+          .clusteredAggregation({"c0"}, {"count(distinct c1)"})
+          .planNode(),
+      "Clustered input does not support distinct or sorted aggregates");
+}
+
 TEST_F(AggregationTest, spillPrefixSortOptimization) {
   const RowTypePtr rowType{
       ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8"},
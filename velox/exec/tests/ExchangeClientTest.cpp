@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/ScopeGuard.h>
+#include <folly/executors/ManualExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <thread>
@@ -287,6 +288,191 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, adaptiveFlowControl) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+  const int64_t maxQueuedBytes =
+      std::max<int64_t>(page->size() * 40, 8 * (1 << 20));
+
+  auto client = std::make_shared<ExchangeClient>(
+      "adaptive.flow.control",
+      17,
+      maxQueuedBytes,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor(),
+      /*adaptiveFlowControl=*/true);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 20; ++i) {
+    auto taskId = fmt::format("local://adaptive{}", i);
+    auto task = makeTask(taskId);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    for (auto j = 0; j < 5; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  const auto pages = fetchPages(1, *client, 5 * tasks.size());
+  for (const auto& fetched : pages) {
+    EXPECT_EQ(page->size(), fetched->size());
+  }
+
+  const auto stats = client->stats();
+  EXPECT_EQ(100, stats.at("numReceivedPages").sum);
+  // The queue starts at a quarter of the maximum and stays within bounds.
+  EXPECT_LE(stats.at("peakBytes").sum, maxQueuedBytes + page->size());
+  const auto targetBytes = stats.at("targetQueuedBytes").sum;
+  EXPECT_GE(targetBytes, ExchangeClient::kMinAdaptiveQueuedBytes);
+  EXPECT_LE(targetBytes, maxQueuedBytes);
+  // Sampled at least once per page.
+  EXPECT_GE(stats.at("queuedBytes").count, 100);
+  EXPECT_LE(stats.at("queuedBytes").max, maxQueuedBytes + page->size());
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+
+  // Runs the response callbacks on this thread, so that the queue fills and
+  // drains in a known order. The sources deliver data inline with a request.
+  folly::ManualExecutor manualExecutor;
+  auto directionClient = std::make_shared<ExchangeClient>(
+      "adaptive.flow.control.direction",
+      17,
+      maxQueuedBytes,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      &manualExecutor,
+      /*adaptiveFlowControl=*/true);
+  const auto targetQueuedBytes = [&]() {
+    return directionClient->stats().at("targetQueuedBytes").sum;
+  };
+  const auto initialTargetBytes = targetQueuedBytes();
+
+  tasks.clear();
+  for (auto i = 0; i < 20; ++i) {
+    auto taskId = fmt::format("local://adaptive.direction{}", i);
+    auto task = makeTask(taskId);
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+    for (auto j = 0; j < 10; ++j) {
+      enqueue(taskId, 17, data);
+    }
+    tasks.push_back(task);
+    directionClient->addRemoteTaskId(taskId);
+  }
+  // The sources fill the queue up to the target.
+  manualExecutor.drain();
+
+  // A slow consumer takes one page at a time while most of the data waits in
+  // the queue. The target shrinks.
+  bool atEnd{false};
+  ContinueFuture future;
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(1, directionClient->next(1, 1, &atEnd, &future).size());
+  }
+  const auto slowTargetBytes = targetQueuedBytes();
+  EXPECT_LT(slowTargetBytes, initialTargetBytes);
+  EXPECT_GE(slowTargetBytes, ExchangeClient::kMinAdaptiveQueuedBytes);
+
+  // A fast consumer takes all queued data until it finds the queue empty
+  // while sources have data that was not requested. The target grows.
+  std::vector<std::unique_ptr<SerializedPage>> fastPages;
+  do {
+    fastPages = directionClient->next(
+        1, std::numeric_limits<uint32_t>::max(), &atEnd, &future);
+  } while (!fastPages.empty());
+  ASSERT_FALSE(atEnd);
+  EXPECT_GT(targetQueuedBytes(), slowTargetBytes);
+  EXPECT_LE(targetQueuedBytes(), maxQueuedBytes);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  directionClient->close();
+  manualExecutor.drain();
+}
+
+TEST_P(ExchangeClientTest, vectorPages) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return std::string(row % 30, 'x'); }),
+  });
+
+  auto serialized =
+      test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+  EXPECT_EQ(serialized->kind(), SerializedPage::Kind::kSerialized);
+  EXPECT_EQ(serialized->vector(), nullptr);
+  EXPECT_EQ(SerializedPage::vectorOf(*serialized->getIOBuf()), nullptr);
+
+  bool released = false;
+  auto page =
+      std::make_unique<SerializedPage>(data, [&]() { released = true; });
+  EXPECT_EQ(page->kind(), SerializedPage::Kind::kVector);
+  EXPECT_EQ(page->vector(), data);
+  EXPECT_EQ(page->size(), data->retainedSize());
+  EXPECT_EQ(page->numRows(), data->size());
+  EXPECT_EQ(SerializedPage::vectorOf(*page->getIOBuf()), data);
+  VELOX_ASSERT_THROW(
+      page->prepareStreamForDeserialize(),
+      "A page of a vector has no serialized data");
+
+  // A slice shares the buffers of 'data'. Its page has the given size.
+  auto slice = std::static_pointer_cast<RowVector>(data->slice(0, 100));
+  SerializedPage slicePage(slice, nullptr, 1'234);
+  EXPECT_EQ(slicePage.size(), 1'234);
+  int64_t sliceBytes = 0;
+  EXPECT_EQ(
+      SerializedPage::vectorOf(*slicePage.getIOBuf(), &sliceBytes), slice);
+  EXPECT_EQ(sliceBytes, 1'234);
+
+  const std::string taskId = "local://vector.pages";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+  ContinueFuture unused;
+  EXPECT_FALSE(bufferManager_->enqueue(taskId, 17, std::move(page), &unused));
+
+  auto client = std::make_shared<ExchangeClient>(
+      "vector.pages",
+      17,
+      1 << 20,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor());
+  client->addRemoteTaskId(taskId);
+  auto pages = fetchPages(1, *client, 1);
+
+  // The queued page holds the producer's vector and has the size of the
+  // producer's page. The producer's release callback runs only after the
+  // consumer drops the page.
+  ASSERT_EQ(pages[0]->kind(), SerializedPage::Kind::kVector);
+  EXPECT_EQ(pages[0]->vector(), data);
+  EXPECT_EQ(pages[0]->size(), data->retainedSize());
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+  EXPECT_FALSE(released);
+  pages.clear();
+  EXPECT_TRUE(released);
+}
+
 TEST_P(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
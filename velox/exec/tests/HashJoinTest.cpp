@@ -5008,6 +5008,115 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterPushdown) {
+  const int32_t numSplits = 3;
+  const int32_t numProbeRows = 10'000;
+  const int32_t numBuildRows = 10'000;
+  // Long distinct string keys exceed the distinct value tracking of the
+  // VectorHasher, so the hash table uses kHash mode and the keys are pushed
+  // down as a bloom filter.
+  auto makeKeys = [&](int32_t size, std::function<int32_t(int32_t)> keyAt) {
+    std::vector<std::string> keys;
+    keys.reserve(size);
+    for (auto i = 0; i < size; ++i) {
+      keys.push_back(fmt::format("{:0>200}", keyAt(i)));
+    }
+    return makeFlatVector<std::string>(keys);
+  };
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeKeys(
+            numProbeRows, [&](auto row) { return row + i * numProbeRows; }),
+        makeFlatVector<int64_t>(numProbeRows, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // Every third probe key has a match.
+  std::vector<RowVectorPtr> buildVectors{makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeKeys(numBuildRows, [](auto row) { return row * 3; }),
+       makeFlatVector<int64_t>(numBuildRows, [](auto row) { return row; })})};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .tableScan(asRowType(probeVectors[0]->type()))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"c0", "c1", "u_c1"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+
+  for (const auto maxSize : {0, 1 << 10, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxSize: {}", maxSize));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            std::to_string(maxSize))
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          auto planStats = toPlanStats(task->taskStats());
+          // The bloom filter for 10K keys does not fit in 1KB.
+          if (hasSpill || maxSize < (1 << 20)) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numProbeRows * numSplits);
+            ASSERT_EQ(
+                planStats.at(joinId).customStats.count(
+                    HashBuild::kKeyBloomFilterSize),
+                0);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // The join is not replaced by a bloom filter which has false
+            // positives.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(getInputPositions(task, 1), numProbeRows * numSplits);
+            ASSERT_GE(
+                getInputPositions(task, 1), numProbeRows * numSplits / 3);
+            ASSERT_GT(
+                planStats.at(joinId)
+                    .customStats.at(HashBuild::kKeyBloomFilterSize)
+                    .sum,
+                0);
+          }
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -72,6 +72,51 @@ class HashTableTestHelper {
         mode, numNew, BaseHashTable::kNoSpillInputStartPartitionBit);
   }
 
+  // Returns the number of rows that are not in the partition of the table
+  // that their hash selects in the last radix partitioned join build. Expects
+  // distinct keys, i.e. a row of each key in the table.
+  int64_t numRowsOutsideRadixJoinBuildPartition() {
+    const auto numPartitions = table_->numRadixJoinBuildPartitions_;
+    VELOX_CHECK_GT(numPartitions, 0);
+    const int64_t partitionBytes = (table_->sizeMask_ + 1) / numPartitions;
+    folly::F14FastMap<char*, int64_t> rowOffsets;
+    for (int64_t offset = 0; offset < table_->sizeMask_;
+         offset += bucketSize()) {
+      for (auto slot = 0;
+           slot < sizeof(typename HashTable<ignoreNullKeys>::TagVector);
+           ++slot) {
+        if (auto* row = table_->row(offset, slot)) {
+          rowOffsets.emplace(row, offset);
+        }
+      }
+    }
+
+    int64_t numOutside = 0;
+    raw_vector<char*> rows(1'024);
+    raw_vector<uint64_t> hashes(1'024);
+    for (auto* rowContainer : table_->allRows()) {
+      RowContainerIterator iter;
+      while (const auto numRows = rowContainer->listRows(
+                 &iter, rows.size(), RowContainer::kUnlimited, rows.data())) {
+        VELOX_CHECK(table_->hashRows(
+            folly::Range<char**>(rows.data(), numRows), false, hashes));
+        for (auto i = 0; i < numRows; ++i) {
+          const auto it = rowOffsets.find(rows[i]);
+          VELOX_CHECK(it != rowOffsets.end());
+          if (it->second / partitionBytes !=
+              table_->bucketOffset(hashes[i]) / partitionBytes) {
+            ++numOutside;
+          }
+        }
+      }
+    }
+    return numOutside;
+  }
+
+  int64_t numRadixJoinBuildOverflowRows() const {
+    return table_->numRadixJoinBuildOverflowRows_;
+  }
+
  private:
   explicit HashTableTestHelper(HashTable<ignoreNullKeys>* table)
       : table_(table) {
@@ -156,10 +201,23 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
+    topTable_->setRadixPartitionedJoinBuild(radixPartitionedJoinBuild_);
     topTable_->prepareJoinTable(
         std::move(otherTables),
         BaseHashTable::kNoSpillInputStartPartitionBit,
         executor_.get());
+    if (radixPartitionedJoinBuild_ && executor_ != nullptr) {
+      ASSERT_GE(topTable_->numRadixJoinBuildPartitions(), numWays);
+      // The rows are in the partition their hash bits select, except for the
+      // ones that overflowed their partition.
+      auto helper = HashTableTestHelper<true>::create(topTable_.get());
+      ASSERT_EQ(
+          helper.numRowsOutsideRadixJoinBuildPartition(),
+          helper.numRadixJoinBuildOverflowRows());
+      checkSameAsNonPartitionedBuild(size, numWays, buildType, numKeys);
+    } else {
+      ASSERT_EQ(topTable_->numRadixJoinBuildPartitions(), 0);
+    }
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
@@ -512,6 +570,97 @@ class HashTableTest : public testing::TestWithParam<bool>,
     }
   }
 
+  // Probes 'table' with the keys of 'batch'. Returns the hit of each row of
+  // 'batch', nullptr if none.
+  std::vector<char*> probeHits(HashTable<true>& table, const RowVector& batch) {
+    HashLookup lookup(table.hashers());
+    lookup.reset(batch.size());
+    SelectivityVector rows(batch.size());
+    auto& hashers = table.hashers();
+    VectorHasher::ScratchMemory scratchMemory;
+    for (auto i = 0; i < hashers.size(); ++i) {
+      const auto& key = batch.childAt(i);
+      if (table.hashMode() != BaseHashTable::HashMode::kHash) {
+        hashers[i]->lookupValueIds(*key, rows, scratchMemory, lookup.hashes);
+      } else {
+        hashers[i]->decode(*key, rows);
+        hashers[i]->hash(rows, i > 0, lookup.hashes);
+      }
+    }
+
+    std::vector<char*> hits(batch.size(), nullptr);
+    constexpr int32_t kPadding = simd::kPadding / sizeof(int32_t);
+    lookup.rows.resize(bits::roundUp(batch.size() + kPadding, kPadding));
+    lookup.rows.resize(simd::indicesOfSetBits(
+        rows.asRange().bits(), 0, batch.size(), lookup.rows.data()));
+    if (lookup.rows.empty()) {
+      return hits;
+    }
+    table.joinProbe(lookup);
+    for (const auto row : lookup.rows) {
+      hits[row] = lookup.hits[row];
+    }
+    return hits;
+  }
+
+  // Builds the join table of testCycle() again without radix partitioning
+  // and checks that each key of 'batches_' hits the row of the same key in
+  // it and in 'topTable_'. Must be called before any erase from 'topTable_'.
+  void checkSameAsNonPartitionedBuild(
+      int32_t size,
+      int32_t numWays,
+      const TypePtr& buildType,
+      int32_t numKeys) {
+    VELOX_CHECK_EQ(batches_.size(), numWays);
+    // copyVectorsToTable() overwrites 'rowOfKey_' with the rows of the new
+    // tables.
+    const auto rowOfKey = rowOfKey_;
+    std::unique_ptr<HashTable<true>> table;
+    std::vector<std::unique_ptr<BaseHashTable>> otherTables;
+    for (auto way = 0; way < numWays; ++way) {
+      std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+      for (auto channel = 0; channel < numKeys; ++channel) {
+        keyHashers.emplace_back(std::make_unique<VectorHasher>(
+            buildType->childAt(channel), channel));
+      }
+      auto wayTable = HashTable<true>::createForJoin(
+          std::move(keyHashers), {}, true, false, 1'000, pool());
+      copyVectorsToTable({batches_[way]}, way * size, wayTable.get());
+      if (table == nullptr) {
+        table = std::move(wayTable);
+      } else {
+        otherTables.push_back(std::move(wayTable));
+      }
+    }
+    table->prepareJoinTable(
+        std::move(otherTables),
+        BaseHashTable::kNoSpillInputStartPartitionBit,
+        executor_.get());
+    ASSERT_EQ(table->numRadixJoinBuildPartitions(), 0);
+
+    // Maps the rows of both tables to the position of their key.
+    folly::F14FastMap<const char*, int64_t> positions;
+    for (auto i = 0; i < rowOfKey.size(); ++i) {
+      if (rowOfKey[i] != nullptr) {
+        positions[rowOfKey[i]] = i;
+        positions[rowOfKey_[i]] = i;
+      }
+    }
+    for (const auto& batch : batches_) {
+      const auto expected = probeHits(*table, *batch);
+      const auto actual = probeHits(*topTable_, *batch);
+      for (auto row = 0; row < batch->size(); ++row) {
+        if (expected[row] == nullptr) {
+          ASSERT_EQ(actual[row], nullptr);
+        } else {
+          ASSERT_NE(actual[row], nullptr);
+          ASSERT_EQ(positions.at(expected[row]), positions.at(actual[row]));
+        }
+      }
+    }
+    rowOfKey_ = rowOfKey;
+  }
+
   // Erases every strideth non-erased item in the hash table.
   void testEraseEveryN(int32_t stride) {
     std::vector<char*> toErase;
@@ -579,6 +728,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
   int64_t keySpacing_ = 1;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
+  // If true, a parallel join build in testCycle() is radix partitioned.
+  bool radixPartitionedJoinBuild_{false};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -631,6 +782,21 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, radixPartitionedJoinBuildNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  radixPartitionedJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 50000, 5, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedJoinBuildHash) {
+  auto type = ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), VARCHAR()})});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  radixPartitionedJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 50000, 5, type, 1);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clearBeforeInsert) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -846,6 +1012,75 @@ TEST_P(HashTableTest, regularHashingTableSize) {
   }
 }
 
+TEST_P(HashTableTest, probeGroupSize) {
+  keySpacing_ = 1000;
+  const std::vector<std::pair<BaseHashTable::HashMode, RowTypePtr>> cases = {
+      {BaseHashTable::HashMode::kNormalizedKey,
+       ROW({"k1", "k2"}, {BIGINT(), BIGINT()})},
+      {BaseHashTable::HashMode::kHash,
+       ROW({"key"}, {ROW({"k1"}, {BIGINT()})})}};
+  for (const auto& [mode, type] : cases) {
+    SCOPED_TRACE(BaseHashTable::modeString(mode));
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    for (auto channel = 0; channel < type->size(); ++channel) {
+      keyHashers.emplace_back(
+          std::make_unique<VectorHasher>(type->childAt(channel), channel));
+    }
+    topTable_ = HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool());
+    batches_.clear();
+    makeRows(1'000, 10, 0, type, batches_);
+    copyVectorsToTable(batches_, 0, topTable_.get());
+    topTable_->prepareJoinTable(
+        {}, BaseHashTable::kNoSpillInputStartPartitionBit, executor_.get());
+    ASSERT_EQ(topTable_->hashMode(), mode);
+    ASSERT_GE(
+        topTable_->probeGroupSize(), HashTable<true>::kMinProbeGroupSize);
+    ASSERT_LE(
+        topTable_->probeGroupSize(), HashTable<true>::kMaxProbeGroupSize);
+
+    // Group sizes that do and do not divide the batch size all give the same
+    // hits.
+    for (const auto groupSize : {1, 3, 4, 16, 64}) {
+      SCOPED_TRACE(fmt::format("groupSize {}", groupSize));
+      topTable_->setProbeGroupSize(groupSize);
+      ASSERT_EQ(topTable_->probeGroupSize(), groupSize);
+      testProbe();
+    }
+    VELOX_ASSERT_THROW(
+        topTable_->setProbeGroupSize(HashTable<true>::kMaxProbeGroupSize + 1),
+        "Probe group size must be 0 or between 1 and 64");
+    topTable_->setProbeGroupSize(0);
+    ASSERT_LE(
+        topTable_->probeGroupSize(), HashTable<true>::kMaxProbeGroupSize);
+
+    // Group by inserts new keys within a group, some of which collide in a
+    // bucket with later keys of the same group.
+    for (const auto groupSize : {1, 3, 64}) {
+      SCOPED_TRACE(fmt::format("groupSize {}", groupSize));
+      auto table = createHashTableForAggregation(type, type->size());
+      table->setProbeGroupSize(groupSize);
+      auto lookup = std::make_unique<HashLookup>(table->hashers());
+      std::vector<char*> inserted;
+      for (const auto& batch : batches_) {
+        insertGroups(*batch, *lookup, *table);
+        ASSERT_EQ(lookup->newGroups.size(), batch->size());
+        inserted.insert(
+            inserted.end(), lookup->hits.begin(), lookup->hits.end());
+      }
+      ASSERT_EQ(table->numDistinct(), 10'000);
+      for (auto i = 0; i < batches_.size(); ++i) {
+        insertGroups(*batches_[i], *lookup, *table);
+        ASSERT_TRUE(lookup->newGroups.empty());
+        for (auto row = 0; row < batches_[i]->size(); ++row) {
+          ASSERT_EQ(lookup->hits[row], inserted[i * 1'000 + row]);
+        }
+      }
+      table->checkConsistency();
+    }
+  }
+}
+
 TEST_P(HashTableTest, listJoinResultsSize) {
   baseString_ =
       "If you count carefully, you will notice there are exactly 105 characters"
@@ -1294,7 +1529,7 @@ TEST(HashTableTest, tableInsertPartitionInfo) {
 
   const std::vector<uint64_t> insertBuffers{100, 200, 300, 500};
   for (const auto insertBuffer : insertBuffers) {
-    info.addOverflow(reinterpret_cast<char*>(insertBuffer));
+    info.addOverflow(reinterpret_cast<char*>(insertBuffer), insertBuffer);
   }
   ASSERT_EQ(overflows.size(), insertBuffers.size());
   for (int i = 0; i < insertBuffers.size(); ++i) {
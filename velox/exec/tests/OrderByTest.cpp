@@ -365,6 +365,38 @@ TEST_F(OrderByTest, multiBatchResult) {
   testSingleKey(vectors, "c0");
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  vector_size_t batchSize = 5000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (batchSize * i + row) * 7919 % 1000; },
+        nullEvery(5));
+    auto c1 = makeFlatVector<double>(
+        batchSize, [](vector_size_t row) { return row * 0.1; }, nullEvery(11));
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  const auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .orderBy({"c0 DESC NULLS FIRST", "c1 NULLS LAST"}, false)
+          .planNode();
+  auto queryCtx = core::QueryCtx::create(executor_.get());
+  queryCtx->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kOrderBySortParallelism, "4"},
+  });
+  CursorParameters params;
+  params.planNode = plan;
+  params.queryCtx = queryCtx;
+  assertQueryOrdered(
+      params,
+      "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1 NULLS LAST",
+      {0, 1});
+}
+
 TEST_F(OrderByTest, varfields) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
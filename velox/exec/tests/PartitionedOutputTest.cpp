@@ -15,7 +15,9 @@
  */
 #include "velox/exec/PartitionedOutput.h"
 #include <gtest/gtest.h>
+#include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -89,6 +91,22 @@ class PartitionedOutputTest
     return result;
   }
 
+  // Deserializes and concatenates the pages of one destination.
+  RowVectorPtr deserialize(
+      const std::vector<std::unique_ptr<folly::IOBuf>>& pages,
+      const RowTypePtr& rowType) {
+    auto* serde = getNamedVectorSerde(GetParam());
+    auto result = BaseVector::create<RowVector>(rowType, 0, pool());
+    for (const auto& page : pages) {
+      SerializedPage serializedPage(page->clone());
+      auto input = serializedPage.prepareStreamForDeserialize();
+      RowVectorPtr vector;
+      serde->deserialize(input.get(), pool(), rowType, &vector, nullptr);
+      result->append(vector.get());
+    }
+    return result;
+  }
+
  private:
   const std::shared_ptr<OutputBufferManager> bufferManager_{
       OutputBufferManager::getInstance().lock()};
@@ -206,6 +224,138 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, scatter) {
+  // Scatter mode must send the same rows in the same order to each
+  // destination. Null keys are replicated to all destinations.
+  constexpr int32_t kNumDestinations = 100;
+  constexpr vector_size_t kSize = 1'000;
+  auto input = makeRowVector(
+      {"p1", "v1", "v2"},
+      {makeFlatVector<int64_t>(
+           kSize, [](auto row) { return row * 7; }, nullEvery(97)),
+       makeFlatVector<std::string>(
+           kSize,
+           [](auto row) { return std::string(row % 20, 'a' + row % 26); }),
+       makeArrayVector<int32_t>(
+           kSize,
+           [](auto row) { return row % 5; },
+           [](auto row, auto index) { return row + index; })});
+  const auto rowType = asRowType(input->type());
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 3)
+                  .partitionedOutput(
+                      {"p1"},
+                      kNumDestinations,
+                      true,
+                      std::vector<std::string>{"p1", "v1", "v2"},
+                      GetParam())
+                  .planNode();
+
+  auto runTask = [&](const std::string& taskId, int32_t minDestinations) {
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kPartitionedOutputScatterMinDestinations,
+              std::to_string(minDestinations)}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    std::vector<RowVectorPtr> destinations;
+    for (auto i = 0; i < kNumDestinations; ++i) {
+      destinations.push_back(deserialize(getAllData(taskId, i), rowType));
+    }
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return destinations;
+  };
+
+  const auto expected =
+      runTask("local://test-partitioned-output-no-scatter-0", 0);
+  const auto actual = runTask("local://test-partitioned-output-scatter-0", 1);
+  int64_t numRows = 0;
+  for (auto i = 0; i < kNumDestinations; ++i) {
+    assertEqualVectors(expected[i], actual[i]);
+    numRows += actual[i]->size();
+  }
+  // Each of the 3 batches has 11 rows with null keys, which go to all
+  // destinations. The 'any' row is the first of these.
+  ASSERT_EQ(numRows, 3 * (kSize - 11) + 3 * 11 * kNumDestinations);
+}
+
+TEST_P(PartitionedOutputTest, scatterBlocked) {
+  // A small output buffer blocks scatter mode on the first flush of a round in
+  // which many destinations are full. The remaining flushes of the round are
+  // done when the task continues, so no rows are lost or reordered.
+  constexpr int32_t kNumDestinations = 10;
+  constexpr vector_size_t kSize = 1'000;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeFlatVector<std::string>(kSize, [](auto row) {
+         return std::string(1'000 + row % 20, 'a' + row % 26);
+       })});
+  const auto rowType = asRowType(input->type());
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 5)
+                  .partitionedOutput(
+                      {"p1"},
+                      kNumDestinations,
+                      std::vector<std::string>{"p1", "v1"},
+                      GetParam())
+                  .planNode();
+
+  auto runTask = [&](const std::string& taskId, int32_t minDestinations) {
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kPartitionedOutputScatterMinDestinations,
+              std::to_string(minDestinations)},
+             {core::QueryConfig::kMaxPartitionedOutputBufferSize,
+              std::to_string(PartitionedOutput::kMinDestinationSize * 2)}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+
+    // The destinations are read in parallel, since the task blocks until the
+    // buffered data of all destinations is consumed.
+    std::vector<RowVectorPtr> destinations(kNumDestinations);
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < kNumDestinations; ++i) {
+      readers.emplace_back([&, i]() {
+        destinations[i] = deserialize(getAllData(taskId, i), rowType);
+      });
+    }
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return destinations;
+  };
+
+  const auto expected =
+      runTask("local://test-partitioned-output-no-scatter-blocked-0", 0);
+  const auto actual =
+      runTask("local://test-partitioned-output-scatter-blocked-0", 1);
+  int64_t numRows = 0;
+  for (auto i = 0; i < kNumDestinations; ++i) {
+    assertEqualVectors(expected[i], actual[i]);
+    numRows += actual[i]->size();
+  }
+  ASSERT_EQ(numRows, 5 * kSize);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
@@ -112,6 +112,23 @@ TEST_F(PlanNodeSerdeTest, aggregation) {
              .planNode();
 
   testSerde(plan);
+
+  // Aggregation with grouping sets.
+  plan = PlanBuilder()
+             .values({data_})
+             .groupingSetsAggregation(
+                 {"c0", "c2"}, {{"c0", "c2"}, {"c0"}, {}}, {"sum(c1)"})
+             .planNode();
+
+  testSerde(plan);
+
+  // Aggregation over input clustered on the grouping keys.
+  plan = PlanBuilder()
+             .values({data_})
+             .clusteredAggregation({"c0"}, {"count(1)", "sum(c1)"})
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, assignUniqueId) {
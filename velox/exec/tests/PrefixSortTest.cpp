@@ -57,42 +57,37 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         rowType->children().end()};
 
     RowContainer rowContainer(keyTypes, payloadTypes, pool_.get());
-    auto rows = storeRows(numRows, data, &rowContainer);
-    const std::shared_ptr<memory::MemoryPool> sortPool =
-        rootPool_->addLeafChild("prefixsort");
-    const auto maxBytes = PrefixSort::maxRequiredBytes(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get());
-    const auto beforeBytes = sortPool->peakBytes();
-    ASSERT_EQ(sortPool->peakBytes(), 0);
-    // Use PrefixSort to sort rows.
-    PrefixSort::sort(
-        &rowContainer,
-        compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
-        sortPool.get(),
-        rows);
-    ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
-
-    // Extract data from the RowContainer in order.
-    const RowVectorPtr actual =
-        BaseVector::create<RowVector>(rowType, numRows, pool_.get());
-    for (int column = 0; column < compareFlags.size(); ++column) {
-      rowContainer.extractColumn(
-          rows.data(), numRows, column, actual->childAt(column));
+    const auto rows = storeRows(numRows, data, &rowContainer);
+    for (const bool radixSortEnabled : {false, true}) {
+      SCOPED_TRACE(fmt::format("radixSortEnabled {}", radixSortEnabled));
+      const common::PrefixSortConfig config{
+          1024,
+          // Set threshold to 0 to enable prefix-sort in small dataset.
+          0,
+          12,
+          radixSortEnabled};
+      auto sortedRows = rows;
+      const std::shared_ptr<memory::MemoryPool> sortPool =
+          rootPool_->addLeafChild("prefixsort");
+      const auto maxBytes = PrefixSort::maxRequiredBytes(
+          &rowContainer, compareFlags, config, sortPool.get());
+      const auto beforeBytes = sortPool->peakBytes();
+      ASSERT_EQ(sortPool->peakBytes(), 0);
+      // Use PrefixSort to sort rows.
+      PrefixSort::sort(
+          &rowContainer, compareFlags, config, sortPool.get(), sortedRows);
+      ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
+
+      // Extract data from the RowContainer in order.
+      const RowVectorPtr actual =
+          BaseVector::create<RowVector>(rowType, numRows, pool_.get());
+      for (int column = 0; column < compareFlags.size(); ++column) {
+        rowContainer.extractColumn(
+            sortedRows.data(), numRows, column, actual->childAt(column));
+      }
+
+      velox::test::assertEqualVectors(actual, expectedResult);
     }
-
-    velox::test::assertEqualVectors(actual, expectedResult);
   }
 
  private:
@@ -567,6 +567,70 @@ TEST_P(SortBufferTest, spill) {
   }
 }
 
+TEST_P(SortBufferTest, parallelSort) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("VectorFuzzer");
+  VectorFuzzer fuzzer(
+      {.vectorSize = 10'000, .nullRatio = 0.1}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (auto i = 0; i < 6; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  const auto sort = [&](folly::Executor* executor, uint32_t parallelism) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        prefixSortConfig_,
+        nullptr,
+        nullptr,
+        executor,
+        parallelism);
+    for (const auto& input : inputVectors) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    std::vector<RowVectorPtr> output;
+    while (auto result = sortBuffer->getOutput(1'000)) {
+      // The output vector is reused across getOutput() calls.
+      output.push_back(std::static_pointer_cast<RowVector>(
+          BaseVector::copy(*result, pool_.get())));
+    }
+    return output;
+  };
+
+  const auto expected = sort(nullptr, 1);
+  // 60'000 rows are sorted in 2, 3, 4 and 6 ranges. An odd number of ranges
+  // leaves one out of a merge round.
+  for (uint32_t parallelism : {2, 3, 4, 8}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    stats_.clear();
+    const auto actual = sort(executor_.get(), parallelism);
+    // The stats of the ranges sorted on the executor reach the caller's stats.
+    if (GetParam()) {
+      ASSERT_EQ(
+          stats_.at(PrefixSort::kNumPrefixSortKeys).count,
+          std::min<int64_t>(parallelism, 6));
+      ASSERT_EQ(
+          stats_.at(PrefixSort::kNumPrefixSortKeys).max,
+          sortColumnIndices_.size());
+    } else {
+      ASSERT_EQ(stats_.count(PrefixSort::kNumPrefixSortKeys), 0);
+    }
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      // Rows with equal keys may come in a different order.
+      for (auto channel : sortColumnIndices_) {
+        velox::test::assertEqualVectors(
+            expected[i]->childAt(channel), actual[i]->childAt(channel));
+      }
+    }
+  }
+}
+
 DEBUG_ONLY_TEST_P(SortBufferTest, spillDuringInput) {
   auto spillDirectory = exec::test::TempDirectoryPath::create();
   const auto spillConfig = getSpillConfig(spillDirectory->getPath());
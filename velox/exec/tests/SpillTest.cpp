@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -472,7 +473,8 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
             "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[0] "
             "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
-            "spillReadDeserializationTimeNanos[{}]",
+            "spillReadDeserializationTimeNanos[{}] spillReadAheadHits[{}] "
+            "spillReadAheadMisses[{}] spillReadAheadWaitNanos[{}]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -489,7 +491,10 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctNanos(finalStats.spillReadTimeNanos),
-            succinctNanos(finalStats.spillDeserializationTimeNanos)));
+            succinctNanos(finalStats.spillDeserializationTimeNanos),
+            finalStats.spillReadAheadHits,
+            finalStats.spillReadAheadMisses,
+            succinctNanos(finalStats.spillReadAheadWaitNanos)));
     // Verify the spilled files are still there after spill state destruction.
     for (const auto& spilledFile : spilledFileSet) {
       ASSERT_TRUE(fs->exists(spilledFile));
@@ -592,6 +597,69 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, readAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const int32_t numBatches = 10;
+  const int32_t numRowsPerBatch = 1'000;
+  for (const auto numReadAheadBuffers : {0, 1, 4}) {
+    SCOPED_TRACE(fmt::format("numReadAheadBuffers: {}", numReadAheadBuffers));
+    spillStats_.wlock()->reset();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        fmt::format("test{}", numReadAheadBuffers),
+        1,
+        1,
+        {},
+        kGB,
+        0,
+        compressionKind_,
+        prefixSortConfig,
+        pool(),
+        &spillStats_);
+    state.setPartitionSpilled(0);
+    for (auto i = 0; i < numBatches; ++i) {
+      state.appendToPartition(
+          0,
+          makeRowVector({makeFlatVector<int64_t>(
+              numRowsPerBatch,
+              [&](auto row) { return i * numRowsPerBatch + row; })}));
+    }
+    state.finishFile(0);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+    // Read with small buffers to have many reads per spill file.
+    auto merge = spillPartition.createOrderedReader(
+        1 << 10,
+        pool(),
+        &spillStats_,
+        executor.get(),
+        numReadAheadBuffers);
+    for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(nullptr, merge->next());
+
+    const auto stats = spillStats_.copy();
+    ASSERT_GT(stats.spillReads, 1);
+    ASSERT_EQ(stats.spillReadBytes, stats.spilledBytes);
+    if (numReadAheadBuffers > 0) {
+      // All but the first read of the spill file are read ahead.
+      ASSERT_EQ(
+          stats.spillReadAheadHits + stats.spillReadAheadMisses,
+          stats.spillReads - 1);
+    }
+  }
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
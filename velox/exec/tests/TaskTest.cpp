@@ -551,6 +551,66 @@ TEST_F(TaskTest, toJson) {
   ASSERT_NO_THROW(task->toShortJson());
 }
 
+TEST_F(TaskTest, numaExecutors) {
+  // Forwards to the driver executor and counts the added functions.
+  class CountingExecutor : public folly::Executor {
+   public:
+    explicit CountingExecutor(folly::Executor* executor)
+        : executor_(executor) {}
+
+    void add(folly::Func func) override {
+      ++numAdded;
+      executor_->add(std::move(func));
+    }
+
+    std::atomic_int32_t numAdded{0};
+
+   private:
+    folly::Executor* const executor_;
+  };
+
+  CountingExecutor node0(driverExecutor_.get());
+  CountingExecutor node1(driverExecutor_.get());
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig{{}},
+      {},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      "",
+      {&node0, &node1});
+  ASSERT_EQ(queryCtx->numNumaExecutors(), 2);
+  VELOX_ASSERT_THROW(queryCtx->numaExecutor(2), "");
+
+  auto data = makeRowVector({makeFlatVector<int64_t>(100, folly::identity)});
+  const auto plan = PlanBuilder().values({data}).project({"c0"}).planNode();
+  for (auto i = 0; i < 4; ++i) {
+    const auto numAdded0 = node0.numAdded.load();
+    const auto numAdded1 = node1.numAdded.load();
+    auto task =
+        AssertQueryBuilder(plan).queryCtx(queryCtx).assertResults(data);
+    // Tasks are placed round robin and run their drivers on the executor of
+    // their node.
+    ASSERT_EQ(task->numaNode(), i % 2);
+    ASSERT_EQ(task->driverExecutor(), i % 2 == 0 ? &node0 : &node1);
+    if (i % 2 == 0) {
+      ASSERT_GT(node0.numAdded, numAdded0);
+      ASSERT_EQ(node1.numAdded, numAdded1);
+    } else {
+      ASSERT_EQ(node0.numAdded, numAdded0);
+      ASSERT_GT(node1.numAdded, numAdded1);
+    }
+  }
+
+  // Without node executors, drivers run on the query executor.
+  auto task = AssertQueryBuilder(plan)
+                  .queryCtx(core::QueryCtx::create(driverExecutor_.get()))
+                  .assertResults(data);
+  ASSERT_EQ(task->numaNode(), -1);
+  ASSERT_EQ(task->driverExecutor(), driverExecutor_.get());
+}
+
 TEST_F(TaskTest, wrongPlanNodeForSplit) {
   auto connectorSplit = std::make_shared<connector::hive::HiveConnectorSplit>(
       "test",
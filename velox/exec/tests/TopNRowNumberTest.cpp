@@ -17,7 +17,7 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
@@ -27,7 +27,7 @@ namespace facebook::velox::exec {
 
 namespace {
 
-class TopNRowNumberTest : public OperatorTestBase {
+class TopNRowNumberTest : public HiveConnectorTestBase {
  protected:
   TopNRowNumberTest() {
     filesystems::registerLocalFileSystem();
@@ -291,6 +291,69 @@ TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   }
 }
 
+TEST_F(TopNRowNumberTest, dynamicFilter) {
+  const vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> data;
+  const auto files = makeFilePaths(5);
+  for (int32_t i = 0; i < files.size(); ++i) {
+    data.push_back(makeRowVector(
+        {"p", "s"},
+        {
+            makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+            // Unique sorting key, shuffled within each file.
+            makeFlatVector<int64_t>(
+                size, [&](auto row) { return (row * 7'919) % size * 5 + i; }),
+        }));
+    writeToFile(files[i]->getPath(), data.back());
+  }
+  createDuckDbTable(data);
+
+  auto testPlan = [&](const std::vector<std::string>& partitionKeys,
+                      const std::string& sortingKey,
+                      bool expectFilter) {
+    SCOPED_TRACE(fmt::format(
+        "Partition keys: {}, sorting key: {}",
+        folly::join(", ", partitionKeys),
+        sortingKey));
+    core::PlanNodeId scanId;
+    core::PlanNodeId topNRowNumberId;
+    auto plan = PlanBuilder()
+                    .tableScan(asRowType(data[0]->type()))
+                    .capturePlanNodeId(scanId)
+                    .topNRowNumber(partitionKeys, {sortingKey}, 10, true)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kTopNDynamicFilterEnabled, "true")
+            .splits(makeHiveConnectorSplits(files))
+            .assertResults(fmt::format(
+                "SELECT * FROM (SELECT *, row_number() over ({} order by {}) as rn FROM tmp) "
+                " WHERE rn <= 10",
+                partitionKeys.empty()
+                    ? ""
+                    : fmt::format(
+                          "partition by {}", folly::join(", ", partitionKeys)),
+                sortingKey));
+
+    const auto planStats = toPlanStats(task->taskStats());
+    if (expectFilter) {
+      ASSERT_EQ(
+          planStats.at(scanId).dynamicFilterStats.producerNodeIds,
+          std::unordered_set<core::PlanNodeId>({topNRowNumberId}));
+      ASSERT_LT(planStats.at(scanId).outputRows, size * files.size());
+    } else {
+      ASSERT_TRUE(planStats.at(scanId).dynamicFilterStats.empty());
+    }
+  };
+
+  testPlan({}, "s", true);
+  testPlan({}, "s desc", true);
+  // The cutoff of one partition does not apply to the others.
+  testPlan({"p"}, "s", false);
+}
+
 TEST_F(TopNRowNumberTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b", "c", "d", "e"},
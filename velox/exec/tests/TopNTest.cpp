@@ -14,13 +14,15 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
-class TopNTest : public OperatorTestBase {
+class TopNTest : public HiveConnectorTestBase {
  protected:
   static std::vector<std::string> getSortOrderSqls() {
     return {"NULLS LAST", "NULLS FIRST", "DESC NULLS FIRST", "DESC NULLS LAST"};
@@ -284,6 +286,65 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, dynamicFilter) {
+  // Several files, so that the scan reads more splits after the TopN is full.
+  // Keys are unique apart from a few nulls, so the top rows are well defined.
+  const vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  const auto files = makeFilePaths(5);
+  for (int32_t i = 0; i < files.size(); ++i) {
+    auto key = [&](auto row) { return (row * 7'919) % size * 5 + i; };
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(size, key, nullEvery(500)),
+        makeFlatVector<double>(
+            size, [&](auto row) { return key(row) * 0.25; }, nullEvery(499)),
+        makeFlatVector<std::string>(
+            size,
+            [&](auto row) { return fmt::format("{:06}", key(row)); },
+            nullEvery(498)),
+    }));
+    writeToFile(files[i]->getPath(), vectors.back());
+  }
+  createDuckDbTable(vectors);
+  const auto numInputRows = size * files.size();
+
+  for (const auto& key : {"c0", "c1", "c2"}) {
+    for (const auto& sortOrderSql : getSortOrderSqls()) {
+      const auto sql = fmt::format("{} {}", key, sortOrderSql);
+      SCOPED_TRACE(sql);
+      core::PlanNodeId scanId;
+      core::PlanNodeId topNId;
+      const auto plan = PlanBuilder()
+                            .tableScan(asRowType(vectors[0]->type()))
+                            .capturePlanNodeId(scanId)
+                            .topN({sql}, 100, false)
+                            .capturePlanNodeId(topNId)
+                            .planNode();
+      const auto duckDbSql =
+          fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 100", sql);
+
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(core::QueryConfig::kTopNDynamicFilterEnabled, "true")
+              .splits(makeHiveConnectorSplits(files))
+              .assertResults(duckDbSql);
+      auto planStats = exec::toPlanStats(task->taskStats());
+      ASSERT_EQ(
+          planStats.at(scanId).dynamicFilterStats.producerNodeIds,
+          std::unordered_set<core::PlanNodeId>({topNId}));
+      ASSERT_LT(planStats.at(scanId).outputRows, numInputRows);
+
+      // The filter is off by default.
+      task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                 .splits(makeHiveConnectorSplits(files))
+                 .assertResults(duckDbSql);
+      planStats = exec::toPlanStats(task->taskStats());
+      ASSERT_TRUE(planStats.at(scanId).dynamicFilterStats.empty());
+      ASSERT_EQ(planStats.at(scanId).outputRows, numInputRows);
+    }
+  }
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
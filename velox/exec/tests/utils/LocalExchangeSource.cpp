@@ -95,6 +95,18 @@ class LocalExchangeSource : public exec::ExchangeSource {
           // Keep looping, there could be extra end markers.
           continue;
         }
+        int64_t vectorBytes;
+        if (auto vector = SerializedPage::vectorOf(*inputPage, &vectorBytes)) {
+          // A page of a vector is not serialized. The page keeps 'inputPage'
+          // and thus the producer's memory alive while it is queued. The
+          // consumer copies the vector to its own memory.
+          std::shared_ptr<folly::IOBuf> producerPage(std::move(inputPage));
+          pages.push_back(std::make_unique<SerializedPage>(
+              std::move(vector), [producerPage]() {}, vectorBytes));
+          totalBytes += pages.back()->size();
+          inputPage = nullptr;
+          continue;
+        }
         totalBytes += inputPage->length();
         inputPage->unshare();
         pages.push_back(std::make_unique<SerializedPage>(std::move(inputPage)));
@@ -921,6 +921,25 @@ PlanBuilder& PlanBuilder::aggregation(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  auto aggregatesAndNames = createAggregateExpressionsAndNames(
+      aggregates, {}, core::AggregationNode::Step::kSingle);
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kSingle,
+      fields(groupingKeys),
+      groupingSets,
+      groupIdName,
+      aggregatesAndNames.names,
+      aggregatesAndNames.aggregates,
+      planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::streamingAggregation(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::string>& aggregates,
@@ -941,6 +960,27 @@ PlanBuilder& PlanBuilder::streamingAggregation(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::clusteredAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::string>& aggregates,
+    core::AggregationNode::Step step) {
+  auto aggregatesAndNames =
+      createAggregateExpressionsAndNames(aggregates, {}, step);
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      step,
+      fields(groupingKeys),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregatesAndNames.names,
+      aggregatesAndNames.aggregates,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      false,
+      true,
+      planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::groupId(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::vector<std::string>>& groupingSets,
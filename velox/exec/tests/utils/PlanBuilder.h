@@ -826,6 +826,15 @@ class PlanBuilder {
       core::AggregationNode::Step step,
       bool ignoreNullKeys);
 
+  /// Add a final or single AggregationNode over input that is clustered on
+  /// the grouping keys. All rows of a group must arrive within a few
+  /// consecutive batches, otherwise the group is produced more than once. See
+  /// AggregationNode::clusteredInput().
+  PlanBuilder& clusteredAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::string>& aggregates,
+      core::AggregationNode::Step step = core::AggregationNode::Step::kSingle);
+
   /// Add a GroupIdNode using the specified grouping keys, grouping sets,
   /// aggregation inputs and a groupId column name.
   /// The grouping keys can specify aliases if an input column is mapped
@@ -842,6 +851,17 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add a single AggregationNode that computes 'groupingSets' itself instead
+  /// of aggregating the output of a GroupIdNode. The input is aggregated once
+  /// over all 'groupingKeys' and the coarser grouping sets are derived from
+  /// the finer ones. The output has the grouping keys, a BIGINT 'groupIdName'
+  /// column and the aggregates, like an aggregation over a GroupIdNode.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
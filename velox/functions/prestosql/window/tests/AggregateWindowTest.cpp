@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -422,6 +424,80 @@ TEST_F(AggregateWindowTest, zeroRangeFrame) {
   test("range between k following and unbounded following", expected);
 }
 
+// Wide sliding frames are evaluated from a segment tree over the partition.
+// The results must match the evaluation of each frame from its rows.
+TEST_F(AggregateWindowTest, segmentTreeSlidingFrames) {
+  auto assertSameResults = [&](const RowVectorPtr& input,
+                               const std::vector<std::string>& functions,
+                               const std::string& frameClause) {
+    std::vector<std::string> windowExprs;
+    for (const auto& function : functions) {
+      windowExprs.push_back(fmt::format(
+          "{} over (partition by c0 order by c1 {})", function, frameClause));
+    }
+    const auto plan =
+        PlanBuilder().values({input}).window(windowExprs).planNode();
+    const auto expected =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kWindowSegmentTreeEnabled, "false")
+            .copyResults(pool());
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kWindowSegmentTreeEnabled, "true")
+        .assertResults(expected);
+  };
+
+  const vector_size_t size = 5'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return (row * 7'919) % 1'000 - 500; },
+          nullEvery(13)),
+  });
+  for (const auto& frameClause :
+       {"rows between 100 preceding and current row",
+        "rows between 300 preceding and 200 following",
+        "rows between 50 following and 500 following",
+        "rows between 2000 preceding and 1000 preceding",
+        "rows between 1000 preceding and 10 following"}) {
+    assertSameResults(
+        input,
+        {"sum(c2)", "min(c2)", "max(c2)", "count(c2)", "avg(c2)", "sum(1)"},
+        frameClause);
+  }
+
+  // The sum of all rows of the partition overflows bigint but the sum of
+  // every frame fits. The tree has no node as wide as the partition.
+  const vector_size_t overflowSize = 64;
+  const int64_t largeValue = std::numeric_limits<int64_t>::max() / 30;
+  auto overflowInput = makeRowVector({
+      makeFlatVector<int32_t>(overflowSize, [](auto /*row*/) { return 0; }),
+      makeFlatVector<int64_t>(overflowSize, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          overflowSize, [&](auto /*row*/) { return largeValue; }),
+  });
+  assertSameResults(
+      overflowInput,
+      {"sum(c2)", "avg(c2)"},
+      "rows between 10 preceding and 9 following");
+
+  // Floating-point results match up to rounding.
+  auto doubleInput = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<double>(
+          size,
+          [](auto row) { return (row * 7'919) % 1'000 * 0.1 + 1e10 / 3; },
+          nullEvery(11)),
+  });
+  for (const auto& frameClause :
+       {"rows between 100 preceding and current row",
+        "rows between 300 preceding and 200 following"}) {
+    assertSameResults(doubleInput, {"sum(c2)", "avg(c2)"}, frameClause);
+  }
+}
+
 TEST_F(AggregateWindowTest, singlePartitionColumnForPrefixSort) {
   auto size = 100;
   auto input = makeRowVector(
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include "velox/exec/tests/utils/DistributedPlanBuilder.h"
 #include "velox/exec/tests/utils/LocalRunnerTestBase.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
@@ -217,5 +218,32 @@ TEST_F(LocalRunnerTest, broadcast) {
   localRunner->waitForCompletion(kWaitTimeoutUs);
 }
 
+TEST_F(LocalRunnerTest, inProcessExchange) {
+  config_[core::QueryConfig::kInProcessExchangeEnabled] = "true";
+  SCOPE_EXIT {
+    config_.erase(core::QueryConfig::kInProcessExchangeEnabled);
+  };
+
+  for (auto broadcast : {false, true}) {
+    auto plan = makeJoinPlan("c0", broadcast);
+    const std::string id = fmt::format("q{}", broadcast);
+    auto rootPool = makeRootPool(id);
+    auto splitSourceFactory = makeSimpleSplitSourceFactory(plan);
+    auto localRunner = std::make_shared<LocalRunner>(
+        std::move(plan), makeQueryCtx(id, rootPool.get()), splitSourceFactory);
+    auto results = readCursor(localRunner);
+    EXPECT_EQ(1, results.size());
+    EXPECT_EQ(1, results[0]->size());
+    EXPECT_EQ(
+        kNumRows,
+        results[0]->childAt(0)->as<FlatVector<int64_t>>()->valueAt(0));
+    results.clear();
+    EXPECT_EQ(Runner::State::kFinished, localRunner->state());
+    localRunner->waitForCompletion(kWaitTimeoutUs);
+  }
+
+  checkScanCount("s3", 3);
+}
+
 } // namespace
 } // namespace facebook::velox::runner
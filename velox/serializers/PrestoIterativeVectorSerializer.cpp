@@ -63,6 +63,28 @@ void PrestoIterativeVectorSerializer::append(
   }
 }
 
+// static
+void PrestoIterativeVectorSerializer::appendScattered(
+    const RowVectorPtr& vector,
+    const std::vector<PrestoIterativeVectorSerializer*>& serializers,
+    folly::Range<const folly::Range<const vector_size_t*>*> rows,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(serializers.size(), rows.size());
+  for (auto i = 0; i < serializers.size(); ++i) {
+    serializers[i]->numRows_ += rows[i].size();
+  }
+  for (int32_t column = 0; column < vector->childrenSize(); ++column) {
+    const auto& child = vector->childAt(column);
+    for (auto i = 0; i < serializers.size(); ++i) {
+      if (rows[i].empty()) {
+        continue;
+      }
+      serializeColumn(
+          child, rows[i], &serializers[i]->streams_[column], scratch);
+    }
+  }
+}
+
 size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
   size_t dataSize = 4; // streams_.size()
   for (auto& stream : streams_) {
@@ -39,6 +39,14 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const folly::Range<const vector_size_t*>& rows,
       Scratch& scratch) override;
 
+  /// Appends the rows 'rows[i]' of 'vector' to 'serializers[i]' for each i.
+  /// Serializes one column for all serializers at a time.
+  static void appendScattered(
+      const RowVectorPtr& vector,
+      const std::vector<PrestoIterativeVectorSerializer*>& serializers,
+      folly::Range<const folly::Range<const vector_size_t*>*> rows,
+      Scratch& scratch);
+
   size_t maxSerializedSize() const override;
 
   // The SerializedPage layout is:
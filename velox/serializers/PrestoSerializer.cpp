@@ -121,6 +121,23 @@ PrestoVectorSerde::createIterativeSerializer(
       type, numRows, streamArena, prestoOptions);
 }
 
+void PrestoVectorSerde::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<IterativeVectorSerializer* const*> serializers,
+    folly::Range<const folly::Range<const vector_size_t*>*> rows,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(serializers.size(), rows.size());
+  std::vector<detail::PrestoIterativeVectorSerializer*> prestoSerializers;
+  prestoSerializers.reserve(serializers.size());
+  for (auto* serializer : serializers) {
+    // All iterative serializers of this serde are Presto serializers.
+    prestoSerializers.push_back(
+        static_cast<detail::PrestoIterativeVectorSerializer*>(serializer));
+  }
+  detail::PrestoIterativeVectorSerializer::appendScattered(
+      vector, prestoSerializers, rows, scratch);
+}
+
 std::unique_ptr<BatchVectorSerializer> PrestoVectorSerde::createBatchSerializer(
     memory::MemoryPool* pool,
     const Options* options) {
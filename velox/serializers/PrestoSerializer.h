@@ -106,6 +106,14 @@ class PrestoVectorSerde : public VectorSerde {
       StreamArena* streamArena,
       const Options* options) override;
 
+  /// Serializes each column for all 'serializers' before moving on to the
+  /// next column, so that the column is read from memory once.
+  void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<IterativeVectorSerializer* const*> serializers,
+      folly::Range<const folly::Range<const vector_size_t*>*> rows,
+      Scratch& scratch) override;
+
   /// Note that in addition to the differences highlighted in the VectorSerde
   /// interface, BatchVectorSerializer returned by this function can maintain
   /// the encodings of the input vectors recursively.
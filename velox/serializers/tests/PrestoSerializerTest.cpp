@@ -1402,6 +1402,55 @@ TEST_P(PrestoSerializerTest, roundTrip) {
   }
 }
 
+TEST_P(PrestoSerializerTest, appendScattered) {
+  VectorFuzzer::Options opts;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMilliSeconds;
+  opts.nullRatio = 0.1;
+  VectorFuzzer fuzzer(opts, pool_.get());
+  // The last serializer gets no rows.
+  constexpr int32_t kNumSerializers = 5;
+
+  for (auto i = 0; i < 20; ++i) {
+    auto rowType = fuzzer.randRowType();
+    auto input = fuzzer.fuzzInputRow(rowType);
+    const auto paramOptions = getParamSerdeOptions(nullptr);
+
+    std::vector<std::vector<vector_size_t>> rows(kNumSerializers);
+    for (vector_size_t row = 0; row < input->size(); ++row) {
+      rows[(row * 7) % (kNumSerializers - 1)].push_back(row);
+    }
+    std::vector<std::unique_ptr<StreamArena>> arenas;
+    std::vector<std::unique_ptr<IterativeVectorSerializer>> serializers;
+    std::vector<IterativeVectorSerializer*> rawSerializers;
+    std::vector<folly::Range<const vector_size_t*>> rowRanges;
+    for (auto j = 0; j < kNumSerializers; ++j) {
+      arenas.push_back(std::make_unique<StreamArena>(pool_.get()));
+      serializers.push_back(serde_->createIterativeSerializer(
+          rowType, rows[j].size(), arenas.back().get(), &paramOptions));
+      rawSerializers.push_back(serializers.back().get());
+      rowRanges.emplace_back(rows[j].data(), rows[j].size());
+    }
+
+    Scratch scratch;
+    serde_->appendScattered(input, rawSerializers, rowRanges, scratch);
+
+    for (auto j = 0; j < kNumSerializers; ++j) {
+      std::ostringstream out;
+      facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+      OStreamOutputStream output(&out, &listener);
+      serializers[j]->flush(&output);
+      auto deserialized = deserialize(rowType, out.str(), nullptr);
+      auto expected = BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(rows[j].size(), [&](auto row) { return rows[j][row]; }),
+          rows[j].size(),
+          input);
+      assertEqualVectors(expected, deserialized);
+    }
+  }
+}
+
 TEST_P(PrestoSerializerTest, encodedRoundtrip) {
   VectorFuzzer::Options opts;
   opts.timestampPrecision =
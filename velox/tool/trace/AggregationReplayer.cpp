@@ -29,6 +29,17 @@ core::PlanNodePtr AggregationReplayer::createPlanNode(
     const core::PlanNodePtr& source) const {
   const auto* aggregationNode =
       dynamic_cast<const core::AggregationNode*>(node);
+  if (!aggregationNode->groupingSets().empty()) {
+    return std::make_shared<core::AggregationNode>(
+        nodeId,
+        aggregationNode->step(),
+        aggregationNode->groupingKeys(),
+        aggregationNode->groupingSets(),
+        aggregationNode->groupId().value()->name(),
+        aggregationNode->aggregateNames(),
+        aggregationNode->aggregates(),
+        source);
+  }
   return std::make_shared<core::AggregationNode>(
       nodeId,
       aggregationNode->step(),
@@ -39,6 +50,7 @@ core::PlanNodePtr AggregationReplayer::createPlanNode(
       aggregationNode->globalGroupingSets(),
       aggregationNode->groupId(),
       aggregationNode->ignoreNullKeys(),
+      aggregationNode->clusteredInput(),
       source);
 }
 } // namespace facebook::velox::tool::trace
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilter:
+      strKind = "BloomFilterValues";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilter, "kBloomFilter"},
   };
 }
 
@@ -199,6 +205,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -734,6 +741,51 @@ FilterPtr MultiRange::create(const folly::dynamic& obj) {
   return std::make_unique<MultiRange>(std::move(filters), nullAllowed);
 }
 
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  std::string serialized(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(serialized.data());
+  obj["bloomFilter"] = folly::hexlify(serialized);
+  if (filter_) {
+    obj["filter"] = filter_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  std::string serialized;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), serialized));
+  auto bloomFilter = std::make_shared<Bits>();
+  bloomFilter->merge(serialized.data());
+  std::shared_ptr<const Filter> filter;
+  if (obj.count("filter")) {
+    filter = ISerializable::deserialize<Filter>(obj["filter"]);
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloomFilter), nullAllowed, std::move(filter));
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      (filter_ == nullptr) != (otherBloomFilter->filter_ == nullptr)) {
+    return false;
+  }
+  if (filter_ && !filter_->testingEquals(*otherBloomFilter->filter_)) {
+    return false;
+  }
+  const auto& otherBits = *otherBloomFilter->bloomFilter_;
+  if (bloomFilter_->serializedSize() != otherBits.serializedSize()) {
+    return false;
+  }
+  std::string serialized(bloomFilter_->serializedSize(), '\0');
+  std::string otherSerialized(otherBits.serializedSize(), '\0');
+  bloomFilter_->serialize(serialized.data());
+  otherBits.serialize(otherSerialized.data());
+  return serialized == otherSerialized;
+}
+
 bool MultiRange::testingEquals(const Filter& other) const {
   auto otherMultiRange = dynamic_cast<const MultiRange*>(&other);
   auto res = otherMultiRange != nullptr && Filter::testingBaseEquals(other) &&
@@ -2630,4 +2682,81 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+std::string BloomFilterValues::toString() const {
+  return fmt::format(
+      "BloomFilterValues: {} bytes{} {}",
+      bloomFilter_->serializedSize(),
+      filter_ ? fmt::format(" AND {}", filter_->toString()) : "",
+      nullAllowed_ ? "with nulls" : "no nulls");
+}
+
+std::unique_ptr<Filter> BloomFilterValues::clone(
+    std::optional<bool> nullAllowed) const {
+  if (!nullAllowed) {
+    return std::make_unique<BloomFilterValues>(
+        bloomFilter_, nullAllowed_, filter_);
+  }
+  return std::make_unique<BloomFilterValues>(
+      bloomFilter_,
+      nullAllowed.value(),
+      filter_ ? std::shared_ptr<const Filter>(filter_->clone(nullAllowed))
+              : nullptr);
+}
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min == max) {
+    return testInt64(min);
+  }
+  return !filter_ || filter_->testInt64Range(min, max, hasNull);
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->size());
+  }
+  return !filter_ || filter_->testBytesRange(min, max, hasNull);
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    default:
+      break;
+  }
+  // The bloom filter is combined with 'other' by attaching 'other' to 'this'.
+  // If 'this' already has a filter, 'other' is merged into it. Other filter
+  // kinds do not know how to merge with a bloom filter, so the bloom filter
+  // side always does the merge.
+  std::unique_ptr<Filter> merged;
+  if (!filter_) {
+    merged = other->clone();
+  } else if (other->kind() == FilterKind::kBloomFilter) {
+    merged = other->mergeWith(filter_.get());
+  } else {
+    merged = filter_->mergeWith(other);
+  }
+  if (merged->kind() == FilterKind::kAlwaysFalse) {
+    return merged;
+  }
+  if (merged->kind() == FilterKind::kIsNull) {
+    return nullOrFalse(nullAllowed_);
+  }
+  return std::make_unique<BloomFilterValues>(
+      bloomFilter_, nullAllowed_ && other->testNull(), std::move(merged));
+}
 } // namespace facebook::velox::common
@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -57,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilter,
 };
 
 class Filter;
@@ -2128,6 +2130,98 @@ class MultiRange final : public Filter {
   const std::vector<std::unique_ptr<Filter>> filters_;
 };
 
+/// Passes integer or string values whose hash is set in a bloom filter. Used
+/// to push down the keys of a hash join build side that has too many distinct
+/// values for an IN-list. Values that are not in the set may pass. Integers
+/// are hashed as 64 bit values, so the same filter applies to integer columns
+/// of any width. A second filter that values must also pass can be attached.
+/// This is how the filter is combined with other filters in mergeWith().
+class BloomFilterValues final : public Filter {
+ public:
+  using Bits = velox::BloomFilter<>;
+
+  /// @param bloomFilter The bloom filter. Shared between copies of the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param filter Optional filter that values must pass in addition to the
+  /// bloom filter.
+  BloomFilterValues(
+      std::shared_ptr<const Bits> bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> filter = nullptr)
+      : Filter(
+            true,
+            nullAllowed && (!filter || filter->testNull()),
+            FilterKind::kBloomFilter),
+        bloomFilter_(std::move(bloomFilter)),
+        filter_(std::move(filter)) {
+    VELOX_CHECK(
+        bloomFilter_ && bloomFilter_->isSet(),
+        "Bloom filter must not be empty");
+  }
+
+  /// Returns the hash to insert into the bloom filter for integer 'value'.
+  static uint64_t hashInt64(int64_t value) {
+    return bits::hashMix(kSeed, value);
+  }
+
+  /// Returns the hash to insert into the bloom filter for string 'value'.
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return bits::hashBytes(kSeed, value, length);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final;
+
+  bool testInt64(int64_t value) const final {
+    return bloomFilter_->mayContain(hashInt64(value)) &&
+        (!filter_ || filter_->testInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (!filter_ || filter_->testBytes(value, length)) &&
+        bloomFilter_->mayContain(hashBytes(value, length));
+  }
+
+  bool hasTestLength() const final {
+    return filter_ && filter_->hasTestLength();
+  }
+
+  bool testLength(int32_t length) const final {
+    return filter_->testLength(length);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const Bits>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  const std::shared_ptr<const Filter>& filter() const {
+    return filter_;
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+  std::string toString() const override;
+
+ private:
+  static constexpr uint64_t kSeed = 0x9e3779b97f4a7c15ULL;
+
+  const std::shared_ptr<const Bits> bloomFilter_;
+  const std::shared_ptr<const Filter> filter_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
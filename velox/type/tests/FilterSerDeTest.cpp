@@ -163,3 +163,15 @@ TEST_F(FilterSerDeTest, timestampFilter) {
   testSerde(TimestampRange(lo, hi, true));
   testSerde(TimestampRange(lo, hi, false));
 }
+
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bits = std::make_shared<BloomFilterValues::Bits>();
+  bits->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bits->insert(BloomFilterValues::hashInt64(i));
+  }
+  testSerde(BloomFilterValues(bits, true));
+  testSerde(BloomFilterValues(bits, false));
+  testSerde(BloomFilterValues(
+      bits, false, std::make_shared<BigintRange>(10, 20, false)));
+}
@@ -1828,6 +1828,70 @@ TEST(FilterTest, hugeIntRange) {
   EXPECT_FALSE(filter->testInt128Range(min, max, false));
 }
 
+TEST(FilterTest, bloomFilter) {
+  auto bits = std::make_shared<BloomFilterValues::Bits>();
+  bits->reset(2'000);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bits->insert(BloomFilterValues::hashInt64(i * 7));
+    auto value = fmt::format("value{}", i);
+    bits->insert(BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+
+  BloomFilterValues filter(bits, false);
+  EXPECT_EQ(filter.kind(), FilterKind::kBloomFilter);
+  EXPECT_FALSE(filter.testNull());
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 7'000; ++i) {
+    if (i % 7 == 0) {
+      EXPECT_TRUE(filter.testInt64(i));
+      EXPECT_TRUE(filter.testInt64Range(i, i, false));
+    } else if (filter.testInt64(i)) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 300);
+  for (auto i = 0; i < 1'000; ++i) {
+    auto value = fmt::format("value{}", i);
+    EXPECT_TRUE(filter.testBytes(value.data(), value.size()));
+  }
+  EXPECT_TRUE(filter.testInt64Range(1, 100, false));
+  EXPECT_TRUE(filter.testBytesRange("a", "b", false));
+
+  // Merge with a range keeps the bloom filter and adds the range.
+  auto range = between(0, 700);
+  auto merged = filter.mergeWith(range.get());
+  EXPECT_EQ(merged->kind(), FilterKind::kBloomFilter);
+  EXPECT_TRUE(merged->testInt64(70));
+  EXPECT_FALSE(merged->testInt64(707));
+  EXPECT_FALSE(merged->testInt64Range(701, 800, false));
+  EXPECT_TRUE(merged->testInt64Range(600, 800, false));
+  EXPECT_FALSE(merged->testNull());
+
+  // Merge with another bloom filter checks both.
+  auto otherBits = std::make_shared<BloomFilterValues::Bits>();
+  otherBits->reset(10);
+  otherBits->insert(BloomFilterValues::hashInt64(14));
+  BloomFilterValues otherFilter(otherBits, false);
+  auto mergedTwice = merged->mergeWith(&otherFilter);
+  EXPECT_EQ(mergedTwice->kind(), FilterKind::kBloomFilter);
+  EXPECT_TRUE(mergedTwice->testInt64(14));
+  EXPECT_FALSE(mergedTwice->testInt64(707));
+
+  // Trivial filters.
+  AlwaysTrue alwaysTrue;
+  EXPECT_EQ(filter.mergeWith(&alwaysTrue)->kind(), FilterKind::kBloomFilter);
+  AlwaysFalse alwaysFalse;
+  EXPECT_EQ(filter.mergeWith(&alwaysFalse)->kind(), FilterKind::kAlwaysFalse);
+  IsNull isNull;
+  EXPECT_EQ(filter.mergeWith(&isNull)->kind(), FilterKind::kAlwaysFalse);
+
+  auto withNulls = filter.clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64Range(1'000'000, 1'000'000, true));
+  EXPECT_EQ(withNulls->mergeWith(&isNull)->kind(), FilterKind::kIsNull);
+  EXPECT_FALSE(withNulls->mergeWith(range.get())->testNull());
+}
+
 TEST(FilterTest, dateRange) {
   auto filter =
       between(DATE()->toDays("1970-01-01"), DATE()->toDays("1980-01-01"));
@@ -88,6 +88,17 @@ void BatchVectorSerializer::serialize(
   serialize(vector, folly::Range(&allRows, 1), stream);
 }
 
+void VectorSerde::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<IterativeVectorSerializer* const*> serializers,
+    folly::Range<const folly::Range<const vector_size_t*>*> rows,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(serializers.size(), rows.size());
+  for (auto i = 0; i < serializers.size(); ++i) {
+    serializers[i]->append(vector, rows[i], scratch);
+  }
+}
+
 std::unique_ptr<BatchVectorSerializer> VectorSerde::createBatchSerializer(
     memory::MemoryPool* pool,
     const Options* options) {
@@ -202,6 +213,26 @@ void VectorStreamGroup::append(const RowVectorPtr& vector) {
   serializer_->append(vector);
 }
 
+// static
+void VectorStreamGroup::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<VectorStreamGroup* const*> groups,
+    folly::Range<const folly::Range<const vector_size_t*>*> rows,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(groups.size(), rows.size());
+  if (groups.empty()) {
+    return;
+  }
+  std::vector<IterativeVectorSerializer*> serializers;
+  serializers.reserve(groups.size());
+  for (auto* group : groups) {
+    VELOX_CHECK_EQ(group->serde_, groups[0]->serde_);
+    VELOX_CHECK_NOT_NULL(group->serializer_);
+    serializers.push_back(group->serializer_.get());
+  }
+  groups[0]->serde_->appendScattered(vector, serializers, rows, scratch);
+}
+
 void VectorStreamGroup::append(
     const row::CompactRow& compactRow,
     const folly::Range<const vector_size_t*>& rows,
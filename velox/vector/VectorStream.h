@@ -258,6 +258,17 @@ class VectorSerde {
       StreamArena* streamArena,
       const Options* options = nullptr) = 0;
 
+  /// Appends the rows 'rows[i]' of 'vector' to 'serializers[i]' for each i.
+  /// The serializers must have been created by this serde. Used to partition
+  /// a vector across many destinations. The default appends to one serializer
+  /// at a time. Columnar formats may instead serialize each column for all
+  /// serializers before moving on to the next column.
+  virtual void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<IterativeVectorSerializer* const*> serializers,
+      folly::Range<const folly::Range<const vector_size_t*>*> rows,
+      Scratch& scratch);
+
   /// Creates a Vector Serializer that writes a subset of rows from a single
   /// RowVector to the OutputStream via a single serialize API.
   ///
@@ -399,6 +410,15 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Appends the rows 'rows[i]' of 'vector' to 'groups[i]' for each i. All
+  /// groups must use the same serde and have their stream trees created. See
+  /// VectorSerde::appendScattered.
+  static void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<VectorStreamGroup* const*> groups,
+      folly::Range<const folly::Range<const vector_size_t*>*> rows,
+      Scratch& scratch);
+
   void append(
       const row::CompactRow& compactRow,
       const folly::Range<const vector_size_t*>& rows,